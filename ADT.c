@@ -19,6 +19,21 @@
 
 #include "Resources.h"
 
+/*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
+/********************************************************************
+*																	*
+*							Globals									*
+*																	*
+********************************************************************/
+/*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
+
+static NodePool G_listPool = { sizeof (ListNode) };
+// Pool shared by lists that draw from a shared pool
+static NodePool G_stackPool = { sizeof (StackNode) };
+// Pool shared by stacks that draw from a shared pool
+static NodePool G_queuePool = { sizeof (QueueNode) };
+// Pool shared by queues that draw from a shared pool
+
 /*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
 /********************************************************************
 *																	*
@@ -120,6 +135,15 @@ int RemoveQueueData (QueueNode * queueNode)
 	return queueNode->remove (queueNode->value);
 }
 
+/********************************************************************
+*	RemoveMessageData - Call function associated with a MessageNode	*
+********************************************************************/
+
+int RemoveMessageData (MessageNode * messageNode)
+{
+	return messageNode->remove (messageNode->value);
+}
+
 /*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
 /********************************************************************
 *																	*
@@ -155,6 +179,316 @@ void SetQueueRemoveMethod (QueueNode * queueNode, int (* remove) (voidStar data)
 	queueNode->remove = remove;
 }
 
+/********************************************************************
+*	SetVectorRemoveMethod - Assign a method to a given Vector		*
+********************************************************************/
+
+void SetVectorRemoveMethod (Vector * vector, int (* remove) (voidStar data))
+{
+	vector->remove = remove;
+}
+
+/********************************************************************
+*	SetMessageRemoveMethod - Assign a method to a given MessageNode	*
+********************************************************************/
+
+void SetMessageRemoveMethod (MessageNode * messageNode, int (* remove) (voidStar data))
+{
+	messageNode->remove = remove;
+}
+
+/*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
+/********************************************************************
+*																	*
+*							Node pools								*
+*																	*
+********************************************************************/
+/*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
+
+/********************************************************************
+*	InitNodePool - Initialize a pool of ADT nodes					*
+*	Input:	Pool to initialize; size of its nodes					*
+*	Output:	Pool is empty and ready to hand out nodes				*
+********************************************************************/
+
+void InitNodePool (NodePool * pool, int nodeSize)
+{
+	assert (pool && nodeSize >= sizeof (voidStar));
+	// Verify that pool points to valid memory and that a released node can hold a link
+
+	ZeroMemory (pool, sizeof (NodePool));
+	// Zero memory out
+
+	pool->nodeSize = nodeSize;	// Assign the size of each node
+}
+
+/********************************************************************
+*	ClearNodePool - Release every slab of a node pool at once		*
+*	Input:	Pool to clear											*
+*	Output:	All of the pool's nodes are freed						*
+********************************************************************/
+
+void ClearNodePool (NodePool * pool)
+{
+	pNodeSlab slab;	// Slab to free
+
+	assert (pool);
+	// Verify that pool points to valid memory
+
+	while (pool->slabs)	// Check that slabs still exist
+	{
+		slab = pool->slabs;
+
+		pool->slabs = slab->next;
+
+		FREE(slab);
+		// Free memory pointed to by slab, and every node carved from it
+	}
+
+	InitNodePool (pool, pool->nodeSize);
+	// Forget the released and unused nodes
+}
+
+/********************************************************************
+*	AttachNodePool - Find or create the pool an ADT draws from		*
+*	Input:	Where nodes come from; shared pool of the ADT's type;	*
+*			size of the ADT's nodes									*
+*	Output:	Pool to draw from, or NULL for heap nodes				*
+********************************************************************/
+
+static NodePool * AttachNodePool (NodeAllocation allocation, NodePool * shared, int nodeSize)
+{
+	pNodePool pool;	// Pool to be created
+
+	switch (allocation)	// Get the node allocation
+	{
+	case kHeapNodes:	// Heap case
+	case kNodeArray:	// Array case
+		return NULL;
+		// Nodes come from the heap, or live in the ADT's own array
+
+	case kSharedPool:	// Shared pool case
+		return shared;
+		// Nodes come from the pool of the ADT's type
+
+	case kPrivatePool:	// Private pool case
+		MALLOC(pool,NodePool);
+		// Assign memory to pool
+
+		if (!pool)
+		{
+			NULL_MESSAGE("AttachNodePool failed","1");
+			// Return null pNodePool
+		}
+		// Verify that pool points to valid memory
+
+		InitNodePool (pool, nodeSize);
+		// Ready the pool
+
+		return pool;
+		// Nodes come from a pool the ADT owns
+
+	default:
+		NULL_MESSAGE("Unsupported node allocation: AttachNodePool failed","2");
+		// Return null pNodePool
+	}
+}
+
+/********************************************************************
+*	AllocateNode - Get a zeroed node from a pool or the heap		*
+*	Input:	Pool to draw from, or NULL; size of the node			*
+*	Output:	Address of the node										*
+********************************************************************/
+
+static voidStar AllocateNode (NodePool * pool, int nodeSize)
+{
+	voidStar node;	// Node to hand out
+
+	if (!pool)	// Check whether nodes come from the heap
+	{
+		CALLOC(node,nodeSize,BYTE);
+		// Assign memory to node
+
+		return node;
+		// Return the node
+	}
+
+	if (pool->freeNodes)	// Check for a released node
+	{
+		node = pool->freeNodes;
+
+		pool->freeNodes = *(voidStar *) node;	// Unlink the node from the released chain
+	}
+
+	else
+	{
+		if (!pool->numUnused && !AddNodeSlab (pool))
+		{
+			NULL_MESSAGE("AllocateNode failed","1");
+			// Return null voidStar
+		}
+		// Verify that the newest slab has an unused node
+
+		node = pool->cursor;
+
+		pool->cursor += pool->nodeSize;	// Carve the node from the slab
+		pool->numUnused--;
+	}
+
+	ZeroMemory (node, nodeSize);
+	// Zero memory out, as MALLOC would
+
+	return node;
+	// Return the node
+}
+
+/********************************************************************
+*	ReleaseNode - Return a node to its pool or the heap				*
+*	Input:	Pool the node came from, or NULL; the node				*
+*	Output:	Node may be reused										*
+********************************************************************/
+
+static void ReleaseNode (NodePool * pool, voidStar node)
+{
+	if (!pool)	// Check whether nodes come from the heap
+	{
+		FREE(node);
+		// Free memory pointed to by node
+
+		return;
+	}
+
+	*(voidStar *) node = pool->freeNodes;	// Link the node into the released chain
+
+	pool->freeNodes = node;
+}
+
+/********************************************************************
+*	AddNodeSlab - Allocate a slab of nodes for a pool				*
+*	Input:	Pool to grow											*
+*	Output:	Success													*
+********************************************************************/
+
+static BOOL AddNodeSlab (NodePool * pool)
+{
+	pNodeSlab slab;	// Slab to be created
+
+	slab = (pNodeSlab) malloc (sizeof (NodeSlab) + NODE_SLAB * pool->nodeSize);
+	// Assign memory to slab; nodes are zeroed as they are handed out
+
+	if (!slab)
+	{
+		ERROR_MESSAGE("AddNodeSlab failed","1");
+		// Return failure
+	}
+	// Verify that slab points to valid memory
+
+	slab->next = pool->slabs;
+
+	pool->slabs = slab;						// Link the slab into the pool
+	pool->cursor = (PBYTE) (slab + 1);		// Nodes follow the slab header
+	pool->numUnused = NODE_SLAB;
+
+	return TRUE;
+	// Return success
+}
+
+/*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
+/********************************************************************
+*																	*
+*							Node arrays								*
+*																	*
+********************************************************************/
+/*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
+
+/********************************************************************
+*	GrowStackArray - Double the node array of a stack				*
+*	Input:	Stack to grow											*
+*	Output:	Success													*
+********************************************************************/
+
+static BOOL GrowStackArray (Stack * stack)
+{
+	pStackNode nodes;	// Array to be created
+	int capacity;		// Count of nodes the array will hold
+
+	capacity = stack->capacity ? stack->capacity * 2 : NODE_ARRAY;
+	// Double the count of nodes, so that pushes are amortized O(1)
+
+	CALLOC(nodes,capacity,StackNode);
+	// Assign memory to nodes
+
+	if (!nodes)
+	{
+		ERROR_MESSAGE("GrowStackArray failed","1");
+		// Return failure
+	}
+	// Verify that nodes points to valid memory
+
+	if (stack->numNodes)
+	{
+		memcpy (nodes, stack->nodes, stack->numNodes * sizeof (StackNode));
+		// Move nodes into the new array
+	}
+
+	FREE(stack->nodes);
+	// Free memory pointed to by stack's nodes field
+
+	stack->nodes = nodes;		// Assign the new array
+	stack->capacity = capacity;
+
+	stack->top = stack->numNodes ? nodes + stack->numNodes - 1 : NULL;	// Point the top into the new array
+
+	return TRUE;
+	// Return success
+}
+
+/********************************************************************
+*	GrowQueueRing - Double the node ring of a queue					*
+*	Input:	Queue to grow											*
+*	Output:	Success; "first-in" node moves to the ring's start		*
+********************************************************************/
+
+static BOOL GrowQueueRing (Queue * queue)
+{
+	pQueueNode ring;	// Ring to be created
+	int capacity, first;// Count of nodes the ring will hold; count of nodes before the wrap
+
+	capacity = queue->capacity ? queue->capacity * 2 : NODE_ARRAY;
+	// Double the count of nodes, so that enqueues are amortized O(1)
+
+	CALLOC(ring,capacity,QueueNode);
+	// Assign memory to ring
+
+	if (!ring)
+	{
+		ERROR_MESSAGE("GrowQueueRing failed","1");
+		// Return failure
+	}
+	// Verify that ring points to valid memory
+
+	if (queue->numNodes)
+	{
+		first = min (queue->numNodes, queue->capacity - queue->head);
+
+		memcpy (ring, queue->ring + queue->head, first * sizeof (QueueNode));
+		memcpy (ring + first, queue->ring, (queue->numNodes - first) * sizeof (QueueNode));
+		// Unwrap nodes into the new ring, "first-in" node first
+	}
+
+	FREE(queue->ring);
+	// Free memory pointed to by queue's ring field
+
+	queue->ring = ring;			// Assign the new ring
+	queue->capacity = capacity;
+	queue->head = 0;
+
+	queue->tail = queue->numNodes ? ring + queue->numNodes - 1 : NULL;	// Point the tail into the new ring
+
+	return TRUE;
+	// Return success
+}
+
 /*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
 /********************************************************************
 *																	*
@@ -191,7 +525,7 @@ BOOL InitHydra (Hydra * hydra, int numHeads, listMode const * modes)
 
 	for (i = 0; i < hydra->numHeads; i++)	// Cycle through the ListHead's
 	{
-		*(hydra->listHeads + i) = CreateList (*(modes + i));
+		*(hydra->listHeads + i) = CreateList (*(modes + i), kHeapNodes);
 		// Create the ListHead
 
 		if (!*(hydra->listHeads + i))
@@ -208,14 +542,18 @@ BOOL InitHydra (Hydra * hydra, int numHeads, listMode const * modes)
 
 /********************************************************************
 *	CreateList - Create a linked list								*
-*	Input:	Style of linked list to create							*
+*	Input:	Style of linked list to create; where its nodes come	*
+*			from													*
 *	Output:	Returns the address of a ListHead structure				*
 ********************************************************************/
 
-ListHead * CreateList (listMode mode)
+ListHead * CreateList (listMode mode, NodeAllocation allocation)
 {
 	pListHead listHead;		// List head to be created
 
+	assert (allocation != kNodeArray);
+	// Verify that the list links its nodes
+
 	MALLOC(listHead,ListHead);
 	// Assign memory to listHead
 
@@ -229,17 +567,33 @@ ListHead * CreateList (listMode mode)
 	listHead->head = NULL;	// Nullify the head itself
 	listHead->mode = mode;	// Set the appropriate mode
 
+	listHead->tail = listHead->cursor = NULL;	// Nullify the tail and cursor
+
+	listHead->allocation = allocation;
+	listHead->pool = AttachNodePool (allocation, &G_listPool, sizeof (ListNode));
+	// Set where listHead's nodes come from
+
+	if ((allocation == kSharedPool || allocation == kPrivatePool) && !listHead->pool)
+	{
+		FREE(listHead);
+		// Free memory pointed to by listHead
+
+		NULL_MESSAGE("CreateList failed","2");
+		// Return null pListHead
+	}
+	// Verify that listHead's pool field points to valid memory
+
 	return listHead;
 	// Return the list head
 }
 
 /********************************************************************
 *	CreateStack - Create a stack									*
-*	Input:	No input												*
+*	Input:	Where the stack's nodes come from						*
 *	Output:	Returns the address of a Stack structure				*
 ********************************************************************/
 
-Stack * CreateStack (void)
+Stack * CreateStack (NodeAllocation allocation)
 {
 	pStack stack;	// Stack to be created
 
@@ -255,17 +609,34 @@ Stack * CreateStack (void)
 
 	stack->top = NULL;	// Nullify the top itself
 
+	stack->nodes = NULL;	// Nullify the array; it is made on the first push
+	stack->capacity = 0;
+
+	stack->allocation = allocation;
+	stack->pool = AttachNodePool (allocation, &G_stackPool, sizeof (StackNode));
+	// Set where stack's nodes come from
+
+	if ((allocation == kSharedPool || allocation == kPrivatePool) && !stack->pool)
+	{
+		FREE(stack);
+		// Free memory pointed to by stack
+
+		NULL_MESSAGE("CreateStack failed","2");
+		// Return null pStack
+	}
+	// Verify that stack's pool field points to valid memory
+
 	return stack;
 	// Return the stack
 }
 
 /********************************************************************
 *	CreateQueue - Create a queue									*
-*	Input:	No input												*
+*	Input:	Where the queue's nodes come from						*
 *	Output:	Returns the address of a Queue structure				*
 ********************************************************************/
 
-Queue * CreateQueue (void)
+Queue * CreateQueue (NodeAllocation allocation)
 {
 	pQueue queue;	// Queue to be created
 
@@ -281,6 +652,23 @@ Queue * CreateQueue (void)
 
 	queue->tail = NULL;	// Nullify the tail itself
 
+	queue->ring = NULL;		// Nullify the ring; it is made on the first enqueue
+	queue->capacity = queue->head = 0;
+
+	queue->allocation = allocation;
+	queue->pool = AttachNodePool (allocation, &G_queuePool, sizeof (QueueNode));
+	// Set where queue's nodes come from
+
+	if ((allocation == kSharedPool || allocation == kPrivatePool) && !queue->pool)
+	{
+		FREE(queue);
+		// Free memory pointed to by queue
+
+		NULL_MESSAGE("CreateQueue failed","2");
+		// Return null pQueue
+	}
+	// Verify that queue's pool field points to valid memory
+
 	return queue;
 	// Return the queue
 }
@@ -303,7 +691,6 @@ Queue * CreateQueue (void)
 BOOL InsertListNode (ListHead * listHead, voidStar data, dataType type, int index)
 {
 	pListNode newNode, walker;	// A new node to insert; a list walker
-	int counter = 0;			// Index pointed at by the walker
 
 	assert (listHead && data);
 	// Verify that listHead and data point to valid memory
@@ -330,7 +717,7 @@ BOOL InsertListNode (ListHead * listHead, voidStar data, dataType type, int inde
 	}
 	// Call AppendListNode to handle this situation
 
-	MALLOC(newNode,ListNode);
+	newNode = AllocateNode (listHead->pool, sizeof (ListNode));
 	// Assign memory to newNode
 
 	if (!newNode)
@@ -343,11 +730,8 @@ BOOL InsertListNode (ListHead * listHead, voidStar data, dataType type, int inde
 	newNode->value = data;	// Assign data to newNode's value field
 	newNode->type = type;	// Assign corresponding type
 
-	for (walker = listHead->head; counter < index; counter++)
-	{
-		WALKAHEAD(walker);
-		// Walk the list to the appropriate index
-	}
+	walker = SeekListNode (listHead, index);
+	// Find the node at the appropriate index
 
 	if (listHead->mode == kRing || index)	// Inserting at given list index
 	{
@@ -370,6 +754,8 @@ BOOL InsertListNode (ListHead * listHead, voidStar data, dataType type, int inde
 	newNode->next = walker;			// newNode points ahead to walker
 	newNode->next->prev = newNode;	// Next node points back to newNode
 
+	listHead->cursor = newNode;	// Walker now sits past the index, so newNode takes the cursor
+
 	IncListNodeCount (listHead);
 	// Increase the node count
 
@@ -386,13 +772,12 @@ BOOL InsertListNode (ListHead * listHead, voidStar data, dataType type, int inde
 
 BOOL AppendListNode (ListHead * listHead, voidStar data, dataType type)
 {
-	pListNode newNode, walker, prev;// A new node to insert; a list walker; a previous node
-	int counter = 0;				// Index pointed at by the walker
+	pListNode newNode;	// A new node to insert
 
 	assert (listHead && data);
 	// Verify that listHead and data point to valid memory
 
-	MALLOC(newNode,ListNode);
+	newNode = AllocateNode (listHead->pool, sizeof (ListNode));
 	// Assign memory to newNode
 
 	if (!newNode)
@@ -417,16 +802,7 @@ BOOL AppendListNode (ListHead * listHead, voidStar data, dataType type)
 
 		else						// Normal case
 		{
-			for (walker = listHead->head; counter < listHead->numNodes; counter++)
-			{
-				prev = walker;
-				// Store current node in prev 
-
-				WALKAHEAD(walker);
-				// Walk to the next node in the list
-			}
-
-			newNode->prev = prev;					// newNode points back to prev
+			newNode->prev = listHead->tail;			// newNode points back to the tail
 			newNode->next = NULL;					// Nullify newNode's next field
 
 			newNode->prev->next = newNode;			// Append the node
@@ -444,16 +820,7 @@ BOOL AppendListNode (ListHead * listHead, voidStar data, dataType type)
 
 		else						// Normal case
 		{
-			for (walker = listHead->head; counter < listHead->numNodes; counter++)
-			{
-				prev = walker;
-				// Store current node in prev
-
-				WALKAHEAD(walker);
-				// Walk to the next node in the list
-			}
-
-			newNode->prev = prev;					// newNode points back to prev
+			newNode->prev = listHead->tail;			// newNode points back to the tail
 			newNode->next = listHead->head;			// newNode points ahead to list head
 
 			newNode->prev->next = newNode;			// Previous node points ahead to newNode
@@ -463,6 +830,8 @@ BOOL AppendListNode (ListHead * listHead, voidStar data, dataType type)
 		break;	// Break out of switch statement
 	}
 
+	listHead->tail = newNode;	// newNode becomes the list tail
+
 	IncListNodeCount (listHead);
 	// Increase the node count
 
@@ -484,21 +853,39 @@ BOOL PushStackNode (Stack * stack, voidStar data, dataType type)
 	assert (stack && data);
 	// Verify that stack and data point to valid memory
 
-	MALLOC(newNode,StackNode);
-	// Assign memory to newNode
+	if (stack->allocation == kNodeArray)	// Check whether stack holds its nodes in an array
+	{
+		if (stack->numNodes == stack->capacity && !GrowStackArray (stack))
+		{
+			ERROR_MESSAGE("PushStackNode failed","1");
+			// Return failure
+		}
+		// Verify that the array has room for another node
 
-	if (!newNode)
+		newNode = stack->nodes + stack->numNodes;
+
+		ZeroMemory (newNode, sizeof (StackNode));
+		// Zero memory out
+	}
+
+	else
 	{
-		ERROR_MESSAGE("PushStackNode failed","1");
-		// Return failure
+		newNode = AllocateNode (stack->pool, sizeof (StackNode));
+		// Assign memory to newNode
+
+		if (!newNode)
+		{
+			ERROR_MESSAGE("PushStackNode failed","2");
+			// Return failure
+		}
+		// Verify that newNode points to valid memory
+
+		newNode->next = stack->top;	// newNode points ahead to stack's top field
 	}
-	// Verify that newNode points to valid memory
 
 	newNode->value = data;	// Assign data to newNode's value field
 	newNode->type = type;	// Assign corresponding type
 
-	newNode->next = stack->top;	// newNode points ahead to stack's top field
-
 	stack->top = newNode;		// Reassign stack's top field to point to newNode
 
 	IncStackNodeCount (stack);
@@ -522,21 +909,39 @@ BOOL EnqueueQueueNode (Queue * queue, voidStar data, dataType type)
 	assert (queue && data);
 	// Verify that queue and data point to valid memory
 
-	MALLOC(newNode,QueueNode);
-	// Assign memory to newNode
+	if (queue->allocation == kNodeArray)	// Check whether queue holds its nodes in a ring
+	{
+		if (queue->numNodes == queue->capacity && !GrowQueueRing (queue))
+		{
+			ERROR_MESSAGE("EnqueueQueueNode failed","1");
+			// Return failure
+		}
+		// Verify that the ring has room for another node
 
-	if (!newNode)
+		newNode = queue->ring + ((queue->head + queue->numNodes) & (queue->capacity - 1));
+
+		ZeroMemory (newNode, sizeof (QueueNode));
+		// Zero memory out
+	}
+
+	else
 	{
-		ERROR_MESSAGE("EnqueueQueueNode failed","1");
-		// Return failure
+		newNode = AllocateNode (queue->pool, sizeof (QueueNode));
+		// Assign memory to newNode
+
+		if (!newNode)
+		{
+			ERROR_MESSAGE("EnqueueQueueNode failed","2");
+			// Return failure
+		}
+		// Verify that newNode points to valid memory
+
+		newNode->next = queue->tail;	// newNode points ahead to queue's tail field
 	}
-	// Verify that newNode points to valid memory
 
 	newNode->value = data;	// Assign data to newNode's value field
 	newNode->type = type;	// Assign corresponding type
 
-	newNode->next = queue->tail;	// newNode points ahead to queue's tail field
-
 	queue->tail = newNode;			// Reassign queue's tail field to point to newNode
 
 	IncQueueNodeCount (queue);
@@ -555,31 +960,70 @@ BOOL EnqueueQueueNode (Queue * queue, voidStar data, dataType type)
 /*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
 
 /********************************************************************
-*	GetListNode - Retrieve a ListNode at a given index from a list	*
-*	Input:	Head of list to retrieve node from; index of node		*
-*	Output:	Node at given index in list								*
+*	SeekListNode - Find a list node from its nearest known node		*
+*	Input:	Head of list to search; index of node					*
+*	Output:	Node at given index in list; list cursor is moved there	*
 ********************************************************************/
 
-ListNode * GetListNode (ListHead * listHead, int index)
+static ListNode * SeekListNode (ListHead * listHead, int index)
 {
 	pListNode walker;	// A list walker
-	int counter = 0;	// Index pointed at by the walker
+	int counter;		// Index pointed at by the walker
 
-	assert (listHead && listHead->numNodes);
-	// Ensure that list is not empty
+	walker = listHead->head;
+	counter = 0;
+	// Start from the head
 
-	for (walker = listHead->head; counter < index; counter++)
+	if (listHead->numNodes - 1 - index < index)
 	{
-		WALKAHEAD(walker);
-		// Walk the list to the appropriate index
+		walker = listHead->tail;
+		counter = listHead->numNodes - 1;
 	}
+	// Start from the tail if it lies closer
 
-	return walker;
-	// Return ListNode pointed at by walker
-}
+	if (listHead->cursor && abs (index - listHead->cursorIndex) < abs (index - counter))
+	{
+		walker = listHead->cursor;
+		counter = listHead->cursorIndex;
+	}
+	// Start from the cursor if it lies closer still
 
-/********************************************************************
-*	StackTop - Get the "last-in" StackNode from the given Stack		*
+	for (; counter < index; counter++)
+	{
+		WALKAHEAD(walker);
+		// Walk ahead to the appropriate index
+	}
+
+	for (; counter > index; counter--)
+	{
+		WALKBACK(walker);
+		// Walk back to the appropriate index
+	}
+
+	listHead->cursor = walker;		// Leave the cursor at the node found
+	listHead->cursorIndex = index;
+
+	return walker;
+	// Return ListNode pointed at by walker
+}
+
+/********************************************************************
+*	GetListNode - Retrieve a ListNode at a given index from a list	*
+*	Input:	Head of list to retrieve node from; index of node		*
+*	Output:	Node at given index in list								*
+********************************************************************/
+
+ListNode * GetListNode (ListHead * listHead, int index)
+{
+	assert (listHead && index >= 0 && index < listHead->numNodes);
+	// Ensure that the index lies within the list
+
+	return SeekListNode (listHead, index);
+	// Return ListNode at the given index
+}
+
+/********************************************************************
+*	StackTop - Get the "last-in" StackNode from the given Stack		*
 *	Input:	Stack to retrieve StackNode from						*
 *	Output:	"Last-in" StackNode										*
 ********************************************************************/
@@ -607,6 +1051,13 @@ QueueNode * QueueHead (Queue * queue)
 	assert (queue && queue->numNodes);
 	// Ensure that queue has a head
 
+	if (queue->allocation == kNodeArray)
+	{
+		return queue->ring + queue->head;
+		// Return QueueNode at the ring's head index
+	}
+	// Check whether queue holds its nodes in a ring
+
 	for (walker = queue->tail; counter < queue->numNodes; counter++)
 	{
 		prev = walker;
@@ -620,6 +1071,61 @@ QueueNode * QueueHead (Queue * queue)
 	// Return QueueNode pointed at by prev
 }
 
+/*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
+/********************************************************************
+*																	*
+*							List iteration							*
+*																	*
+********************************************************************/
+/*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
+
+/********************************************************************
+*	InitListIterator - Start a walk over a linked list				*
+*	Input:	Iterator to start; head of list to walk					*
+*	Output:	Iterator stands before the list head					*
+********************************************************************/
+
+void InitListIterator (ListIterator * iterator, ListHead * listHead)
+{
+	assert (iterator && listHead);
+	// Verify that iterator and listHead point to valid memory
+
+	iterator->listHead = listHead;		// Assign the list to walk
+	iterator->node = listHead->head;	// Begin at the list head
+	iterator->index = 0;
+}
+
+/********************************************************************
+*	NextListNode - Step an iterator to the next list node			*
+*	Input:	Iterator to step										*
+*	Output:	Next node in list, or NULL once every node is visited	*
+********************************************************************/
+
+ListNode * NextListNode (ListIterator * iterator)
+{
+	pListNode node;	// Node to return
+
+	assert (iterator);
+	// Verify that iterator points to valid memory
+
+	if (iterator->index >= iterator->listHead->numNodes)
+	{
+		return NULL;
+		// Return null pListNode
+	}
+	// Stop after one lap, as ringed lists never reach NULL
+
+	node = iterator->node;
+
+	WALKAHEAD(iterator->node);
+	// Walk to the next node in the list
+
+	iterator->index++;
+
+	return node;
+	// Return the node stepped over
+}
+
 /*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
 /********************************************************************
 *																	*
@@ -668,6 +1174,15 @@ static void RemoveNodeValue (voidStar node, ADTStyle ADT)
 
 		break;	// Break out of switch statement
 
+	case kADTMessage:	// Message case
+		data = ((pMessageNode) node)->value;
+		// Retrieve data from message node
+
+		type = ((pMessageNode) node)->type;
+		// Retrieve type from message node
+
+		break;	// Break out of switch statement
+
 	default:
 		NORET_MESSAGE("Unsupported ADT: RemoveNodeValue failed","1");
 		// Return failure
@@ -751,6 +1266,15 @@ static void RemoveNodeValue (voidStar node, ADTStyle ADT)
 
 		break;	// Break out of switch statement
 
+	case kVector:			// Vector
+		EmptyVector ((pVector) data);
+		// Remove each element of the vector
+
+		FREE(((pVector) data)->elements);
+		// Free memory pointed to by the vector's elements field
+
+		break;	// Break out of switch statement
+
 	case kUserDefined:		// User-defined
 		switch (ADT)	// Get the ADT style
 		{
@@ -770,6 +1294,15 @@ static void RemoveNodeValue (voidStar node, ADTStyle ADT)
 			RemoveStackData ((pStackNode) node);
 			// Remove data using stack node's remove method
 
+			break;	// Break out of switch statement
+
+		case kADTMessage:	// Message case
+			if (((pMessageNode) node)->remove)
+			{
+				RemoveMessageData ((pMessageNode) node);
+				// Remove data using message node's remove method
+			}
+
 			break;	// Break out of switch statement
 		}
 		// Free memory formatted in user-defined manner
@@ -791,7 +1324,6 @@ static void RemoveNodeValue (voidStar node, ADTStyle ADT)
 BOOL RemoveListNode (ListHead * listHead, int index)
 {
 	pListNode walker;	// A list walker
-	int counter = 0;	// Index pointed at by the walker
 
 	assert (listHead);
 	// Verify that listHead points to valid memory
@@ -803,11 +1335,8 @@ BOOL RemoveListNode (ListHead * listHead, int index)
 	}
 	// Verify that the index is valid
 
-	for (walker = listHead->head; counter < index; counter++)
-	{
-		WALKAHEAD(walker);
-		// Walk the list to the appropriate index
-	}
+	walker = SeekListNode (listHead, index);
+	// Find the node at the appropriate index
 
 	if (!index)	
 	{
@@ -827,14 +1356,32 @@ BOOL RemoveListNode (ListHead * listHead, int index)
 	}
 	// Verify that next node is non-NULL
 
+	if (walker == listHead->tail)
+	{
+		listHead->tail = listHead->numNodes > 1 ? walker->prev : NULL;	// Reassign list tail
+	}
+	// Determine whether list tail is being removed
+
+	if (index + 1 < listHead->numNodes)
+	{
+		listHead->cursor = walker->next;	// Next node slides into walker's index
+	}
+
+	else
+	{
+		listHead->cursor = index ? walker->prev : NULL;	// Fall back to the previous node
+		listHead->cursorIndex = index - 1;
+	}
+	// Keep the cursor off the node being removed
+
 	RemoveNodeValue (walker, kADTList);
 	// Remove data pointed to by walker's value field
 
 	FREE(walker->value);
 	// Free memory pointed to by walker's value field
 
-	FREE(walker);
-	// Free memory pointed to by walker
+	ReleaseNode (listHead->pool, walker);
+	// Release memory pointed to by walker
 
 	DecListNodeCount (listHead);
 	// Decrease the node count
@@ -858,6 +1405,23 @@ BOOL PopStackNode (Stack * stack)
 
 	node = stack->top;		// node points to stack's top field
 
+	if (stack->allocation == kNodeArray)	// Check whether stack holds its nodes in an array
+	{
+		stack->top = stack->numNodes > 1 ? node - 1 : NULL;	// Reassign stack's top field to the node below
+
+		RemoveNodeValue (node, kADTStack);
+		// Remove value pointed to by node's value field
+
+		FREE(node->value);
+		// Free memory pointed to by node's value field
+
+		DecStackNodeCount (stack);
+		// Decrease the node count
+
+		return TRUE;
+		// Return success
+	}
+
 	stack->top = node->next;// Reassign stack's top field to point to node's next field
 
 	node->next = NULL;		// Nullify node's next field
@@ -868,8 +1432,8 @@ BOOL PopStackNode (Stack * stack)
 	FREE(node->value);
 	// Free memory pointed to by node's value field
 
-	FREE(node);
-	// Free memory pointed to by node
+	ReleaseNode (stack->pool, node);
+	// Release memory pointed to by node
 
 	DecStackNodeCount (stack);
 	// Decrease the node count
@@ -892,6 +1456,31 @@ BOOL DequeueQueueNode (Queue * queue)
 	assert (queue);
 	// Verify that queue points to valid memory
 
+	if (queue->allocation == kNodeArray)	// Check whether queue holds its nodes in a ring
+	{
+		walker = queue->ring + queue->head;
+
+		queue->head = (queue->head + 1) & (queue->capacity - 1);	// Advance the head index around the ring
+
+		if (queue->numNodes == 1)
+		{
+			queue->tail = NULL;	// Nullify the tail itself
+		}
+		// Check whether the last node is being dequeued
+
+		RemoveNodeValue (walker, kADTQueue);
+		// Remove value pointed to by walker's value field
+
+		FREE(walker->value);
+		// Free memory pointed to by walker's value field
+
+		DecQueueNodeCount (queue);
+		// Decrease the node count
+
+		return TRUE;
+		// Return success
+	}
+
 	numNodes = queue->numNodes - 1;
 	// Store the node count less one
 
@@ -904,7 +1493,16 @@ BOOL DequeueQueueNode (Queue * queue)
 		// Walk to the next node in the queue
 	}
 
-	prev->next = NULL;	// Nullify prev's next field
+	if (numNodes)
+	{
+		prev->next = NULL;	// Nullify prev's next field
+	}
+
+	else
+	{
+		queue->tail = NULL;	// Nullify the tail itself
+	}
+	// Check whether the last node is being dequeued
 
 	RemoveNodeValue (walker, kADTQueue);
 	// Remove value pointed to by walker's value field
@@ -912,8 +1510,8 @@ BOOL DequeueQueueNode (Queue * queue)
 	FREE(walker->value);
 	// Free memory pointed to by walker's value field
 
-	FREE(walker);
-	// Free memory pointed to by walker
+	ReleaseNode (queue->pool, walker);
+	// Release memory pointed to by walker
 
 	DecQueueNodeCount (queue);
 	// Decrease the node count
@@ -938,9 +1536,34 @@ BOOL DequeueQueueNode (Queue * queue)
 
 BOOL EmptyList (ListHead * listHead)
 {
+	pListNode walker;	// A list walker
+
 	assert (listHead);
 	// Verify that listHead points to valid memory
 
+	if (listHead->allocation == kPrivatePool)	// Check whether listHead owns its pool
+	{
+		for (walker = listHead->head; listHead->numNodes; DecListNodeCount (listHead))
+		{
+			RemoveNodeValue (walker, kADTList);
+			// Remove data pointed to by walker's value field
+
+			FREE(walker->value);
+			// Free memory pointed to by walker's value field
+
+			WALKAHEAD(walker);
+			// Walk to the next node in the list
+		}
+
+		listHead->head = listHead->tail = listHead->cursor = NULL;	// Nullify the head, tail, and cursor
+
+		ClearNodePool (listHead->pool);
+		// Release every node at once, slab by slab
+
+		return TRUE;
+		// Return success
+	}
+
 	while (listHead->numNodes)	// Check that nodes still exist
 	{
 		if (!RemoveListNode (listHead, 0))
@@ -963,9 +1586,34 @@ BOOL EmptyList (ListHead * listHead)
 
 BOOL EmptyQueue (Queue * queue)
 {
+	pQueueNode walker;	// A queue walker
+
 	assert (queue);
 	// Verify that queue points to valid memory
 
+	if (queue->allocation == kPrivatePool)	// Check whether queue owns its pool
+	{
+		for (walker = queue->tail; queue->numNodes; DecQueueNodeCount (queue))
+		{
+			RemoveNodeValue (walker, kADTQueue);
+			// Remove value pointed to by walker's value field
+
+			FREE(walker->value);
+			// Free memory pointed to by walker's value field
+
+			WALKAHEAD(walker);
+			// Walk to the next node in the queue
+		}
+
+		queue->tail = NULL;	// Nullify the tail itself
+
+		ClearNodePool (queue->pool);
+		// Release every node at once, slab by slab
+
+		return TRUE;
+		// Return success
+	}
+
 	while (queue->numNodes)	// Check that nodes still exist
 	{
 		if (!DequeueQueueNode (queue))
@@ -988,9 +1636,34 @@ BOOL EmptyQueue (Queue * queue)
 
 BOOL EmptyStack (Stack * stack)
 {
+	pStackNode walker;	// A stack walker
+
 	assert (stack);
 	// Verify that stack points to valid memory
 
+	if (stack->allocation == kPrivatePool)	// Check whether stack owns its pool
+	{
+		for (walker = stack->top; stack->numNodes; DecStackNodeCount (stack))
+		{
+			RemoveNodeValue (walker, kADTStack);
+			// Remove value pointed to by walker's value field
+
+			FREE(walker->value);
+			// Free memory pointed to by walker's value field
+
+			WALKAHEAD(walker);
+			// Walk to the next node in the stack
+		}
+
+		stack->top = NULL;	// Nullify the top itself
+
+		ClearNodePool (stack->pool);
+		// Release every node at once, slab by slab
+
+		return TRUE;
+		// Return success
+	}
+
 	while (stack->numNodes)	// Check that nodes still exist
 	{
 		if (!PopStackNode (stack))
@@ -1023,6 +1696,12 @@ BOOL DestroyList (ListHead * listHead)
 	}
 	// Empty the list
 
+	if (listHead->allocation == kPrivatePool)	// Check whether listHead owns its pool
+	{
+		FREE(listHead->pool);
+		// Free memory pointed to by listHead's pool field
+	}
+
 	FREE(listHead);
 	// Free memory pointed to by listHead
 
@@ -1048,6 +1727,15 @@ BOOL DestroyQueue (Queue * queue)
 	}
 	// Empty the queue
 
+	if (queue->allocation == kPrivatePool)	// Check whether queue owns its pool
+	{
+		FREE(queue->pool);
+		// Free memory pointed to by queue's pool field
+	}
+
+	FREE(queue->ring);
+	// Free memory pointed to by queue's ring field
+
 	FREE(queue);
 	// Free memory pointed to by queue
 
@@ -1073,6 +1761,15 @@ BOOL DestroyStack (Stack * stack)
 	}
 	// Empty the stack
 
+	if (stack->allocation == kPrivatePool)	// Check whether stack owns its pool
+	{
+		FREE(stack->pool);
+		// Free memory pointed to by stack's pool field
+	}
+
+	FREE(stack->nodes);
+	// Free memory pointed to by stack's nodes field
+
 	FREE(stack);
 	// Free memory pointed to by stack
 
@@ -1109,3 +1806,709 @@ BOOL DestroyHydra (Hydra * hydra)
 	return TRUE;
 	// Return success
 }
+
+/*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
+/********************************************************************
+*																	*
+*							Vectors									*
+*																	*
+********************************************************************/
+/*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
+
+/********************************************************************
+*	CreateVector - Create a vector									*
+*	Input:	Size of each element; type of data stored				*
+*	Output:	Returns the address of a Vector structure				*
+********************************************************************/
+
+Vector * CreateVector (int elementSize, dataType type)
+{
+	pVector vector;	// Vector to be created
+
+	assert (elementSize > 0);
+	// Verify that elements take up space
+
+	MALLOC(vector,Vector);
+	// Assign memory to vector
+
+	if (!vector)
+	{
+		NULL_MESSAGE("CreateVector failed","1");
+		// Return null pVector
+	}
+	// Verify that vector points to valid memory
+
+	vector->numElements = vector->capacity = 0;	// Initialize the counts
+	vector->elementSize = elementSize;			// Assign the element size
+	vector->type = type;						// Assign corresponding type
+
+	vector->elements = NULL;	// Nullify the storage itself
+
+	return vector;
+	// Return the vector
+}
+
+/********************************************************************
+*	ReserveVector - Make room for a count of elements				*
+*	Input:	Vector to grow; count of elements to hold				*
+*	Output:	Success													*
+********************************************************************/
+
+BOOL ReserveVector (Vector * vector, int capacity)
+{
+	PBYTE elements;	// Storage to be created
+
+	assert (vector);
+	// Verify that vector points to valid memory
+
+	if (capacity <= vector->capacity)
+	{
+		return TRUE;
+		// Return success
+	}
+	// Check whether there is already room
+
+	CALLOC(elements,capacity * vector->elementSize,BYTE);
+	// Assign memory to elements
+
+	if (!elements)
+	{
+		ERROR_MESSAGE("ReserveVector failed","1");
+		// Return failure
+	}
+	// Verify that elements points to valid memory
+
+	if (vector->numElements)
+	{
+		memcpy (elements, vector->elements, vector->numElements * vector->elementSize);
+		// Move elements into the new storage
+	}
+
+	FREE(vector->elements);
+	// Free memory pointed to by vector's elements field
+
+	vector->elements = elements;	// Assign the new storage
+	vector->capacity = capacity;
+
+	return TRUE;
+	// Return success
+}
+
+/********************************************************************
+*	GrowVector - Make room for more elements, doubling capacity		*
+*	Input:	Vector to grow; count of elements to add				*
+*	Output:	Success													*
+********************************************************************/
+
+static BOOL GrowVector (Vector * vector, int numAdded)
+{
+	int capacity = vector->capacity;// Capacity to grow to
+
+	if (vector->numElements + numAdded <= capacity)
+	{
+		return TRUE;
+		// Return success
+	}
+	// Check whether there is already room
+
+	capacity = max (capacity * 2, VECTOR_MINIMUM);
+	capacity = max (capacity, vector->numElements + numAdded);
+	// Double the capacity, so that pushes are amortized O(1)
+
+	return ReserveVector (vector, capacity);
+	// Return result of growing
+}
+
+/********************************************************************
+*	PushVectorElement - Copy an element onto the end of a vector	*
+*	Input:	Vector to push onto; element to copy					*
+*	Output:	Success													*
+********************************************************************/
+
+BOOL PushVectorElement (Vector * vector, voidStar data)
+{
+	assert (vector && data);
+	// Verify that vector and data point to valid memory
+
+	if (!GrowVector (vector, 1))
+	{
+		ERROR_MESSAGE("PushVectorElement failed","1");
+		// Return failure
+	}
+	// Make room for the element
+
+	memcpy (vector->elements + vector->numElements * vector->elementSize, data, vector->elementSize);
+	// Copy the element onto the end
+
+	vector->numElements++;	// Increment element count
+
+	return TRUE;
+	// Return success
+}
+
+/********************************************************************
+*	InsertVectorElements - Copy a run of elements into a vector		*
+*	Input:	Vector to insert into; elements to copy; index to		*
+*			insert at; count of elements							*
+*	Output:	Success													*
+********************************************************************/
+
+BOOL InsertVectorElements (Vector * vector, voidStar data, int index, int count)
+{
+	PBYTE slot;	// Address of the first inserted element
+
+	assert (vector && data && count >= 0);
+	// Verify that vector and data point to valid memory
+
+	if (index < 0 || index > vector->numElements)
+	{
+		ERROR_MESSAGE("InsertVectorElements failed","1");
+		// Return failure
+	}
+	// Verify that the index is valid
+
+	if (!GrowVector (vector, count))
+	{
+		ERROR_MESSAGE("InsertVectorElements failed","2");
+		// Return failure
+	}
+	// Make room for the elements
+
+	slot = vector->elements + index * vector->elementSize;
+
+	memmove (slot + count * vector->elementSize, slot, (vector->numElements - index) * vector->elementSize);
+	// Open a gap for the elements
+
+	memcpy (slot, data, count * vector->elementSize);
+	// Copy the elements into the gap
+
+	vector->numElements += count;	// Increase element count
+
+	return TRUE;
+	// Return success
+}
+
+/********************************************************************
+*	GetVectorElement - Retrieve an element from a vector			*
+*	Input:	Vector to retrieve element from; index of element		*
+*	Output:	Address of element in place								*
+********************************************************************/
+
+voidStar GetVectorElement (Vector * vector, int index)
+{
+	assert (vector && index >= 0 && index < vector->numElements);
+	// Ensure that the index lies within the vector
+
+	return vector->elements + index * vector->elementSize;
+	// Return address of the element
+}
+
+/********************************************************************
+*	RemoveElementValue - Remove data held in a vector element		*
+*	Input:	Vector holding element; element to remove				*
+*	Output:	Data is removed											*
+********************************************************************/
+
+static void RemoveElementValue (Vector * vector, voidStar element)
+{
+	switch (vector->type)	// Get data type
+	{
+	case kChar:				// char 
+	case kShort:			// short
+	case kInt:				// int
+	case kLong:				// long
+	case kFloat:			// float
+	case kDouble:			// double
+	case kLongDouble:		// long double
+
+		break;	// Break out of switch statement
+
+	case kImage:			// Image
+		DeleteImage ((pImage) element);
+		// Free memory formatted as Image aggregate
+
+		break;	// Break out of switch statement
+
+	case kPattern:			// Pattern
+		DeletePattern ((pPattern) element);
+		// Free memory formatted as Pattern aggregate
+
+		break;	// Break out of switch statement
+
+	case kAnimation:		// Animation
+		DeleteAnimation ((pAnimation) element);
+		// Free memory formatted as Animation aggregate
+
+		break;	// Break out of switch statement
+
+	case kMap:				// Map
+		DeleteMap ((pMap) element);
+		// Free memory formatted as Map aggregate
+
+		break;	// Break out of switch statement
+
+	case kMenus:			// Menu
+		DeleteMenus ((pMenu) element);
+		// Free memory formatted as Menu aggregate
+		
+		break;	// Break out of switch statement
+
+	case kWindow:			// Window
+		DeleteWindow ((pWindow) element);
+		// Free memory formatted as Window aggregate
+
+		break;	// Break out of switch statement
+
+	case kParentWindow:		// ParentWindow
+		DeleteParentWindow ((pParentWindow) element);
+		// Free memory formatted as ParentWindow aggregate
+		
+		break;	// Break out of switch statement
+
+	case kList:				// Linked list
+		DestroyList (*(pListHead *) element);
+		// Free memory formatted as linked list ADT; lists are held by handle
+
+		break;	// Break out of switch statement
+
+	case kQueue:			// Queue
+		DestroyQueue (*(pQueue *) element);
+		// Free memory formatted as queue ADT; queues are held by handle
+
+		break;	// Break out of switch statement
+
+	case kStack:			// Stack
+		DestroyStack (*(pStack *) element);
+		// Free memory formatted as stack ADT; stacks are held by handle
+		
+		break;	// Break out of switch statement
+
+	case kHydra:			// Hydra
+		DestroyHydra ((pHydra) element);
+		// Free memory formatted as Hydra aggregate
+
+		break;	// Break out of switch statement
+
+	case kVector:			// Vector
+		EmptyVector ((pVector) element);
+		// Remove each element of the vector
+
+		FREE(((pVector) element)->elements);
+		// Free memory pointed to by the vector's elements field
+
+		break;	// Break out of switch statement
+
+	case kUserDefined:		// User-defined
+		if (vector->remove)
+		{
+			vector->remove (element);
+			// Remove data using vector's remove method
+		}
+
+		break;	// Break out of switch statement
+
+	default:
+		NORET_MESSAGE("Unsupported data type: RemoveElementValue failed","1");
+		// Return failure
+	}	 
+}
+
+/********************************************************************
+*	EraseVectorElements - Remove a run of elements from a vector	*
+*	Input:	Vector to erase from; index of first element; count of	*
+*			elements												*
+*	Output:	Success													*
+********************************************************************/
+
+BOOL EraseVectorElements (Vector * vector, int index, int count)
+{
+	PBYTE slot;	// Address of the first erased element
+	int i;		// Loop variable
+
+	assert (vector && count >= 0);
+	// Verify that vector points to valid memory
+
+	if (index < 0 || index + count > vector->numElements)
+	{
+		ERROR_MESSAGE("EraseVectorElements failed","1");
+		// Return failure
+	}
+	// Verify that the run lies within the vector
+
+	slot = vector->elements + index * vector->elementSize;
+
+	for (i = 0; i < count; i++)
+	{
+		RemoveElementValue (vector, slot + i * vector->elementSize);
+		// Remove data held in the element
+	}
+
+	memmove (slot, slot + count * vector->elementSize, (vector->numElements - index - count) * vector->elementSize);
+	// Close the gap left by the elements
+
+	vector->numElements -= count;	// Decrease element count
+
+	return TRUE;
+	// Return success
+}
+
+/********************************************************************
+*	SortVector - Sort the elements of a vector in place				*
+*	Input:	Vector to sort; comparison function						*
+*	Output:	Elements are sorted										*
+********************************************************************/
+
+void SortVector (Vector * vector, int (* compare) (void const * dataA, void const * dataB))
+{
+	assert (vector && compare);
+	// Verify that vector and compare point to valid memory
+
+	if (vector->numElements > 1)
+	{
+		qsort (vector->elements, vector->numElements, vector->elementSize, compare);
+		// Sort the elements
+	}
+}
+
+/********************************************************************
+*	EmptyVector - Removes all elements from a vector				*
+*	Input:	Vector to empty											*
+*	Output:	Success; capacity is kept for reuse						*
+********************************************************************/
+
+BOOL EmptyVector (Vector * vector)
+{
+	assert (vector);
+	// Verify that vector points to valid memory
+
+	return EraseVectorElements (vector, 0, vector->numElements);
+	// Return result of erasing every element
+}
+
+/********************************************************************
+*	DestroyVector - Destroys a vector								*
+*	Input:	Vector to destroy										*
+*	Output:	Success													*
+********************************************************************/
+
+BOOL DestroyVector (Vector * vector)
+{
+	assert (vector);
+	// Verify that vector points to valid memory
+
+	if (!EmptyVector (vector))
+	{
+		ERROR_MESSAGE("DestroyVector failed","1");
+		// Return failure
+	}
+	// Empty the vector
+
+	FREE(vector->elements);
+	// Free memory pointed to by vector's elements field
+
+	FREE(vector);
+	// Free memory pointed to by vector
+
+	return TRUE;
+	// Return success
+}
+
+/*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
+/********************************************************************
+*																	*
+*							Message queues							*
+*																	*
+********************************************************************/
+/*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
+
+/********************************************************************
+*	InitMessageQueue - Initialize a message queue					*
+*	Input:	Queue to initialize										*
+*	Output:	Queue is empty and ready for posts						*
+********************************************************************/
+
+void InitMessageQueue (MessageQueue * queue)
+{
+	assert (queue);
+	// Verify that queue points to valid memory
+
+	ZeroMemory (queue, sizeof (MessageQueue));
+	// Zero memory out
+
+	queue->tail = queue->head = &queue->stub;	// Both ends rest on the stub
+}
+
+/********************************************************************
+*	LinkMessageNode - Link a node onto the tail of a message queue	*
+*	Input:	Queue to link onto; node to link						*
+*	Output:	Node is visible to the draining thread					*
+********************************************************************/
+
+static void LinkMessageNode (MessageQueue * queue, MessageNode * node)
+{
+	pMessageNode prev;	// Node posted before this one
+
+	node->next = NULL;	// Nullify node's next field
+
+	prev = InterlockedExchangePointer ((voidStar volatile *) &queue->tail, node);
+	// Claim the tail; each poster gets a distinct previous node
+
+	prev->next = node;	// Publish node to the draining thread
+}
+
+/********************************************************************
+*	PostQueueMessage - Post a message from any thread				*
+*	Input:	Queue to post to; node owned by poster until taken;		*
+*			data to post; type of data to post						*
+*	Output:	Message is queued										*
+********************************************************************/
+
+void PostQueueMessage (MessageQueue * queue, MessageNode * node, voidStar data, dataType type)
+{
+	assert (queue && node && data);
+	// Verify that queue, node, and data point to valid memory
+
+	node->value = data;	// Assign data to node's value field
+	node->type = type;	// Assign corresponding type
+
+	LinkMessageNode (queue, node);
+	// Link the node; its remove method must be set beforehand
+}
+
+/********************************************************************
+*	TakeQueueMessage - Take the oldest message from a queue			*
+*	Input:	Queue to take from; called by the draining thread alone	*
+*	Output:	Node taken, which passes back to its owner; NULL if the	*
+*			queue is empty or a post is still being linked			*
+********************************************************************/
+
+MessageNode * TakeQueueMessage (MessageQueue * queue)
+{
+	pMessageNode head, next;// Oldest node; node after it
+
+	assert (queue);
+	// Verify that queue points to valid memory
+
+	head = queue->head;
+	next = head->next;
+
+	if (head == &queue->stub)
+	{
+		if (!next)
+		{
+			return NULL;
+			// Return null pMessageNode
+		}
+		// Check whether anything has been posted
+
+		queue->head = next;	// Step past the stub
+
+		head = next;
+		next = next->next;
+	}
+	// Skip the stub, which carries no message
+
+	if (next)
+	{
+		queue->head = next;	// Reassign queue's head field to the following node
+
+		return head;
+		// Return the oldest node
+	}
+	// Check whether a later node is linked
+
+	if (head != queue->tail)
+	{
+		return NULL;
+		// Return null pMessageNode
+	}
+	// A poster has claimed the tail but not yet linked its node
+
+	LinkMessageNode (queue, &queue->stub);
+	// Requeue the stub behind the last node, so that node can be detached
+
+	next = head->next;
+
+	if (next)
+	{
+		queue->head = next;	// Reassign queue's head field to the following node
+
+		return head;
+		// Return the oldest node
+	}
+	// Check whether the stub, or a racing post, is linked behind head
+
+	return NULL;
+	// Return null pMessageNode
+}
+
+/********************************************************************
+*	ReleaseMessage - Remove the data held by a message				*
+*	Input:	Message whose data is removed							*
+*	Output:	Data is removed; the node itself is left to its owner	*
+********************************************************************/
+
+void ReleaseMessage (MessageNode * node)
+{
+	assert (node);
+	// Verify that node points to valid memory
+
+	RemoveNodeValue (node, kADTMessage);
+	// Remove data pointed to by node's value field
+
+	FREE(node->value);
+	// Free memory pointed to by node's value field
+}
+
+/********************************************************************
+*	InitBoundedMessageQueue - Initialize a bounded message queue	*
+*	Input:	Queue to initialize; fewest messages it must hold		*
+*	Output:	Success													*
+********************************************************************/
+
+BOOL InitBoundedMessageQueue (BoundedMessageQueue * queue, int capacity)
+{
+	LONG i;	// Loop variable
+
+	assert (queue && capacity > 0);
+	// Verify that queue points to valid memory
+
+	ZeroMemory (queue, sizeof (BoundedMessageQueue));
+	// Zero memory out
+
+	for (queue->capacity = 2; queue->capacity < capacity; queue->capacity <<= 1);
+	// Round the capacity up to a power of two; with one slot, a full slot
+	// would read as free to the next post
+
+	CALLOC(queue->slots,queue->capacity,MessageSlot);
+	// Assign memory to queue's slots field
+
+	if (!queue->slots)
+	{
+		ERROR_MESSAGE("InitBoundedMessageQueue failed","1");
+		// Return failure
+	}
+	// Verify that queue's slots field points to valid memory
+
+	for (i = 0; i < queue->capacity; i++)
+	{
+		queue->slots [i].sequence = i;	// Slot i accepts post number i first
+	}
+
+	return TRUE;
+	// Return success
+}
+
+/********************************************************************
+*	PostBoundedMessage - Post a message from any thread				*
+*	Input:	Queue to post to; data to post; type of data to post;	*
+*			method for user-defined data removal, or NULL			*
+*	Output:	Success; FALSE if the queue is full						*
+********************************************************************/
+
+BOOL PostBoundedMessage (BoundedMessageQueue * queue, voidStar data, dataType type, int (* remove) (voidStar data))
+{
+	pMessageSlot slot;	// Slot being claimed
+	LONG pos, lag;		// Post number to claim; how far the slot trails it
+
+	assert (queue && data);
+	// Verify that queue and data point to valid memory
+
+	for (;;)
+	{
+		pos = queue->tail;
+
+		slot = queue->slots + (pos & (queue->capacity - 1));
+
+		lag = (LONG) ((DWORD) slot->sequence - (DWORD) pos);
+		// Compare as counts that may wrap
+
+		if (!lag)
+		{
+			if (InterlockedCompareExchange (&queue->tail, pos + 1, pos) == pos)
+			{
+				break;	// Break out of loop
+			}
+			// Claim the post number, unless another poster got there first
+		}
+
+		else if (lag < 0)
+		{
+			return FALSE;
+			// Return failure if the slot still holds an untaken message
+		}
+	}
+
+	slot->message.next = NULL;			// Fill the claimed slot
+	slot->message.value = data;
+	slot->message.type = type;
+	slot->message.remove = remove;
+
+	InterlockedExchange (&slot->sequence, pos + 1);
+	// Publish the message after it is written
+
+	return TRUE;
+	// Return success
+}
+
+/********************************************************************
+*	TakeBoundedMessage - Take the oldest message from a queue		*
+*	Input:	Queue to take from; called by the draining thread		*
+*			alone; node to copy message into						*
+*	Output:	Indicates that a message was taken						*
+********************************************************************/
+
+BOOL TakeBoundedMessage (BoundedMessageQueue * queue, MessageNode * message)
+{
+	pMessageSlot slot;	// Slot holding the oldest message
+
+	assert (queue && message);
+	// Verify that queue and message point to valid memory
+
+	slot = queue->slots + (queue->head & (queue->capacity - 1));
+
+	if (slot->sequence != queue->head + 1)
+	{
+		return FALSE;
+		// Return failure if the message is missing or still being written
+	}
+
+	*message = slot->message;	// Copy the message out
+
+	InterlockedExchange (&slot->sequence, queue->head + queue->capacity);
+	// Hand the slot to the post one lap ahead
+
+	queue->head++;
+
+	return TRUE;
+	// Return success
+}
+
+/********************************************************************
+*	DeinitBoundedMessageQueue - Release a bounded message queue		*
+*	Input:	Queue to release; no thread may still post to it		*
+*	Output:	Pending messages are released; slots are freed			*
+********************************************************************/
+
+void DeinitBoundedMessageQueue (BoundedMessageQueue * queue)
+{
+	MessageNode message;	// Message taken from queue
+
+	assert (queue);
+	// Verify that queue points to valid memory
+
+	if (!queue->slots)
+	{
+		return;
+	}
+	// Verify that the queue was initialized
+
+	while (TakeBoundedMessage (queue, &message))
+	{
+		ReleaseMessage (&message);
+		// Remove the data of each pending message
+	}
+
+	FREE(queue->slots);
+	// Free memory pointed to by queue's slots field
+}
@@ -30,6 +30,9 @@
 #define WALKBACK(walker)  ((walker) = (walker)->prev)
 // Used to walk to a preceding node
 
+#define ELEMENT(vector,index,type) (((type *) (vector)->elements) [index])
+// Used to access a vector element of a given type in place
+
 /*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
 /********************************************************************
 *																	*
@@ -104,6 +107,12 @@ int RemoveStackData (pStackNode stackNode);
 
 int RemoveQueueData (pQueueNode queueNode);
 
+/********************************************************************
+*	RemoveMessageData - Call function associated with a MessageNode	*
+********************************************************************/
+
+int RemoveMessageData (pMessageNode messageNode);
+
 /*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
 /********************************************************************
 *																	*
@@ -130,6 +139,99 @@ void SetStackRemoveMethod (pStackNode stackNode, int (* remove) (voidStar data))
 
 void SetQueueRemoveMethod (pQueueNode queueNode, int (* remove) (voidStar data));
 
+/********************************************************************
+*	SetVectorRemoveMethod - Assign a method to a given Vector		*
+********************************************************************/
+
+void SetVectorRemoveMethod (pVector vector, int (* remove) (voidStar data));
+
+/********************************************************************
+*	SetMessageRemoveMethod - Assign a method to a given MessageNode	*
+********************************************************************/
+
+void SetMessageRemoveMethod (pMessageNode messageNode, int (* remove) (voidStar data));
+
+/*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
+/********************************************************************
+*																	*
+*							Node pools								*
+*																	*
+********************************************************************/
+/*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
+
+/********************************************************************
+*	InitNodePool - Initialize a pool of ADT nodes					*
+*	Input:	Pool to initialize; size of its nodes					*
+*	Output:	Pool is empty and ready to hand out nodes				*
+********************************************************************/
+
+void InitNodePool (pNodePool pool, int nodeSize);
+
+/********************************************************************
+*	ClearNodePool - Release every slab of a node pool at once		*
+*	Input:	Pool to clear											*
+*	Output:	All of the pool's nodes are freed						*
+********************************************************************/
+
+void ClearNodePool (pNodePool pool);
+
+/********************************************************************
+*	AttachNodePool - Find or create the pool an ADT draws from		*
+*	Input:	Where nodes come from; shared pool of the ADT's type;	*
+*			size of the ADT's nodes									*
+*	Output:	Pool to draw from, or NULL for heap nodes				*
+********************************************************************/
+
+static pNodePool AttachNodePool (NodeAllocation allocation, pNodePool shared, int nodeSize);
+
+/********************************************************************
+*	AllocateNode - Get a zeroed node from a pool or the heap		*
+*	Input:	Pool to draw from, or NULL; size of the node			*
+*	Output:	Address of the node										*
+********************************************************************/
+
+static voidStar AllocateNode (pNodePool pool, int nodeSize);
+
+/********************************************************************
+*	ReleaseNode - Return a node to its pool or the heap				*
+*	Input:	Pool the node came from, or NULL; the node				*
+*	Output:	Node may be reused										*
+********************************************************************/
+
+static void ReleaseNode (pNodePool pool, voidStar node);
+
+/********************************************************************
+*	AddNodeSlab - Allocate a slab of nodes for a pool				*
+*	Input:	Pool to grow											*
+*	Output:	Success													*
+********************************************************************/
+
+static BOOL AddNodeSlab (pNodePool pool);
+
+/*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
+/********************************************************************
+*																	*
+*							Node arrays								*
+*																	*
+********************************************************************/
+/*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
+
+/********************************************************************
+*	GrowStackArray - Double the node array of a stack				*
+*	Input:	Stack to grow											*
+*	Output:	Success													*
+********************************************************************/
+
+static BOOL GrowStackArray (pStack stack);
+
+/********************************************************************
+*	GrowQueueRing - Double the node ring of a queue					*
+*	Input:	Queue to grow											*
+*	Output:	Success; "first-in" node moves to the ring's start		*
+********************************************************************/
+
+static BOOL GrowQueueRing (pQueue queue);
+
 /*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
 /********************************************************************
 *																	*
@@ -149,27 +251,28 @@ BOOL InitHydra (Hydra * hydra, int numHeads, listMode const * modes);
 
 /********************************************************************
 *	CreateList - Create a linked list								*
-*	Input:	Style of linked list to create							*
+*	Input:	Style of linked list to create; where its nodes come	*
+*			from													*
 *	Output:	Returns the address of a ListHead structure				*
 ********************************************************************/
 
-pListHead CreateList (listMode mode);
+pListHead CreateList (listMode mode, NodeAllocation allocation);
 
 /********************************************************************
 *	CreateStack - Create a stack									*
-*	Input:	No input												*
+*	Input:	Where the stack's nodes come from						*
 *	Output:	Returns the address of a Stack structure				*
 ********************************************************************/
 
-pStack CreateStack (void);
+pStack CreateStack (NodeAllocation allocation);
 
 /********************************************************************
 *	CreateQueue - Create a queue									*
-*	Input:	No input												*
+*	Input:	Where the queue's nodes come from						*
 *	Output:	Returns the address of a Queue structure				*
 ********************************************************************/
 
-pQueue CreateQueue (void);
+pQueue CreateQueue (NodeAllocation allocation);
 
 /*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
 /********************************************************************
@@ -223,6 +326,14 @@ BOOL EnqueueQueueNode (pQueue queue, voidStar data, dataType type);
 ********************************************************************/
 /*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
 
+/********************************************************************
+*	SeekListNode - Find a list node from its nearest known node		*
+*	Input:	Head of list to search; index of node					*
+*	Output:	Node at given index in list; list cursor is moved there	*
+********************************************************************/
+
+static pListNode SeekListNode (pListHead listHead, int index);
+
 /********************************************************************
 *	GetListNode - Retrieve a ListNode at a given index from a list	*
 *	Input:	Head of list to retrieve node from; index of node		*
@@ -247,6 +358,30 @@ pStackNode StackTop (pStack stack);
 
 pQueueNode QueueHead (pQueue queue);
 
+/*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
+/********************************************************************
+*																	*
+*							List iteration							*
+*																	*
+********************************************************************/
+/*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
+
+/********************************************************************
+*	InitListIterator - Start a walk over a linked list				*
+*	Input:	Iterator to start; head of list to walk					*
+*	Output:	Iterator stands before the list head					*
+********************************************************************/
+
+void InitListIterator (pListIterator iterator, pListHead listHead);
+
+/********************************************************************
+*	NextListNode - Step an iterator to the next list node			*
+*	Input:	Iterator to step										*
+*	Output:	Next node in list, or NULL once every node is visited	*
+********************************************************************/
+
+pListNode NextListNode (pListIterator iterator);
+
 /*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
 /********************************************************************
 *																	*
@@ -351,4 +486,186 @@ BOOL DestroyStack (pStack stack);
 
 BOOL DestroyHydra (pHydra hydra);
 
+/*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
+/********************************************************************
+*																	*
+*							Vectors									*
+*																	*
+********************************************************************/
+/*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
+
+/********************************************************************
+*	CreateVector - Create a vector									*
+*	Input:	Size of each element; type of data stored				*
+*	Output:	Returns the address of a Vector structure				*
+********************************************************************/
+
+pVector CreateVector (int elementSize, dataType type);
+
+/********************************************************************
+*	ReserveVector - Make room for a count of elements				*
+*	Input:	Vector to grow; count of elements to hold				*
+*	Output:	Success													*
+********************************************************************/
+
+BOOL ReserveVector (pVector vector, int capacity);
+
+/********************************************************************
+*	GrowVector - Make room for more elements, doubling capacity		*
+*	Input:	Vector to grow; count of elements to add				*
+*	Output:	Success													*
+********************************************************************/
+
+static BOOL GrowVector (pVector vector, int numAdded);
+
+/********************************************************************
+*	PushVectorElement - Copy an element onto the end of a vector	*
+*	Input:	Vector to push onto; element to copy					*
+*	Output:	Success													*
+********************************************************************/
+
+BOOL PushVectorElement (pVector vector, voidStar data);
+
+/********************************************************************
+*	InsertVectorElements - Copy a run of elements into a vector		*
+*	Input:	Vector to insert into; elements to copy; index to		*
+*			insert at; count of elements							*
+*	Output:	Success													*
+********************************************************************/
+
+BOOL InsertVectorElements (pVector vector, voidStar data, int index, int count);
+
+/********************************************************************
+*	GetVectorElement - Retrieve an element from a vector			*
+*	Input:	Vector to retrieve element from; index of element		*
+*	Output:	Address of element in place								*
+********************************************************************/
+
+voidStar GetVectorElement (pVector vector, int index);
+
+/********************************************************************
+*	RemoveElementValue - Remove data held in a vector element		*
+*	Input:	Vector holding element; element to remove				*
+*	Output:	Data is removed											*
+********************************************************************/
+
+static void RemoveElementValue (pVector vector, voidStar element);
+
+/********************************************************************
+*	EraseVectorElements - Remove a run of elements from a vector	*
+*	Input:	Vector to erase from; index of first element; count of	*
+*			elements												*
+*	Output:	Success													*
+********************************************************************/
+
+BOOL EraseVectorElements (pVector vector, int index, int count);
+
+/********************************************************************
+*	SortVector - Sort the elements of a vector in place				*
+*	Input:	Vector to sort; comparison function						*
+*	Output:	Elements are sorted										*
+********************************************************************/
+
+void SortVector (pVector vector, int (* compare) (void const * dataA, void const * dataB));
+
+/********************************************************************
+*	EmptyVector - Removes all elements from a vector				*
+*	Input:	Vector to empty											*
+*	Output:	Success; capacity is kept for reuse						*
+********************************************************************/
+
+BOOL EmptyVector (pVector vector);
+
+/********************************************************************
+*	DestroyVector - Destroys a vector								*
+*	Input:	Vector to destroy										*
+*	Output:	Success													*
+********************************************************************/
+
+BOOL DestroyVector (pVector vector);
+
+/*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
+/********************************************************************
+*																	*
+*							Message queues							*
+*																	*
+********************************************************************/
+/*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
+
+/********************************************************************
+*	InitMessageQueue - Initialize a message queue					*
+*	Input:	Queue to initialize										*
+*	Output:	Queue is empty and ready for posts						*
+********************************************************************/
+
+void InitMessageQueue (pMessageQueue queue);
+
+/********************************************************************
+*	LinkMessageNode - Link a node onto the tail of a message queue	*
+*	Input:	Queue to link onto; node to link						*
+*	Output:	Node is visible to the draining thread					*
+********************************************************************/
+
+static void LinkMessageNode (pMessageQueue queue, pMessageNode node);
+
+/********************************************************************
+*	PostQueueMessage - Post a message from any thread				*
+*	Input:	Queue to post to; node owned by poster until taken;		*
+*			data to post; type of data to post						*
+*	Output:	Message is queued										*
+********************************************************************/
+
+void PostQueueMessage (pMessageQueue queue, pMessageNode node, voidStar data, dataType type);
+
+/********************************************************************
+*	TakeQueueMessage - Take the oldest message from a queue			*
+*	Input:	Queue to take from; called by the draining thread alone	*
+*	Output:	Node taken, which passes back to its owner; NULL if the	*
+*			queue is empty or a post is still being linked			*
+********************************************************************/
+
+pMessageNode TakeQueueMessage (pMessageQueue queue);
+
+/********************************************************************
+*	ReleaseMessage - Remove the data held by a message				*
+*	Input:	Message whose data is removed							*
+*	Output:	Data is removed; the node itself is left to its owner	*
+********************************************************************/
+
+void ReleaseMessage (pMessageNode node);
+
+/********************************************************************
+*	InitBoundedMessageQueue - Initialize a bounded message queue	*
+*	Input:	Queue to initialize; fewest messages it must hold		*
+*	Output:	Success													*
+********************************************************************/
+
+BOOL InitBoundedMessageQueue (pBoundedMessageQueue queue, int capacity);
+
+/********************************************************************
+*	PostBoundedMessage - Post a message from any thread				*
+*	Input:	Queue to post to; data to post; type of data to post;	*
+*			method for user-defined data removal, or NULL			*
+*	Output:	Success; FALSE if the queue is full						*
+********************************************************************/
+
+BOOL PostBoundedMessage (pBoundedMessageQueue queue, voidStar data, dataType type, int (* remove) (voidStar data));
+
+/********************************************************************
+*	TakeBoundedMessage - Take the oldest message from a queue		*
+*	Input:	Queue to take from; called by the draining thread		*
+*			alone; node to copy message into						*
+*	Output:	Indicates that a message was taken						*
+********************************************************************/
+
+BOOL TakeBoundedMessage (pBoundedMessageQueue queue, pMessageNode message);
+
+/********************************************************************
+*	DeinitBoundedMessageQueue - Release a bounded message queue		*
+*	Input:	Queue to release; no thread may still post to it		*
+*	Output:	Pending messages are released; slots are freed			*
+********************************************************************/
+
+void DeinitBoundedMessageQueue (pBoundedMessageQueue queue);
+
 #endif
\ No newline at end of file
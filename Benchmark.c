@@ -0,0 +1,717 @@
+/********************************************************************
+*																	*
+*							Benchmark.c								*
+*																	*
+*	Author:		Steven Johnson										*
+*	Purpose:	Timing drivers for SDK tools						*
+*																	*
+********************************************************************/
+
+/********************************************************************
+*																	*
+*							Includes								*
+*																	*
+********************************************************************/
+
+#include "User.h"
+
+#define BENCH_MAPSIZE	1024
+#define BENCH_QUERIES	20000
+#define BENCH_BATCH		256
+#define BENCH_GOALRUN	16
+#define BENCH_EDITS		1000
+#define BENCH_PATHMAX	(BENCH_MAPSIZE << 3)
+#define BENCH_MENUS		2000
+#define BENCH_LABELS	8
+#define BENCH_LOOKUPS	1000000
+#define BENCH_NODES		100000
+#define BENCH_ROUNDS	20
+#define BENCH_LISTNODES	1000000
+#define BENCH_DEPTH		64
+#define BENCH_POSTERS	8
+#define BENCH_MESSAGES	200000
+#define BENCH_BOUND		1024
+#define BENCH_STRESS	50
+
+/********************************************************************
+*																	*
+*							Helpers									*
+*																	*
+********************************************************************/
+
+static COORD RandomOpenCell (pMap map)
+{
+	COORD cell;
+
+	do
+	{
+		cell.X = (SHORT) (rand () % map->width);
+		cell.Y = (SHORT) (rand () % map->height);
+	} while (!PASSABLE(map,cell.X,cell.Y));
+
+	return cell;
+}
+
+static double Seconds (clock_t begin)
+{
+	double elapsed = (double) (clock () - begin) / CLOCKS_PER_SEC;
+
+	return elapsed > 0.0 ? elapsed : 1.0 / CLOCKS_PER_SEC;
+}
+
+/********************************************************************
+*																	*
+*							Pathfinding								*
+*																	*
+********************************************************************/
+
+void PathBenchmark (void)
+{
+	Map map;
+	PathGraph paths;
+	PathQuery queries [BENCH_BATCH];
+	PCOORD steps;
+	COORD goals [BENCH_BATCH / BENCH_GOALRUN];
+	clock_t begin;
+	double elapsed, inOrder = 0.0, grouped = 0.0;
+	int numFound = 0, totalLength = 0;
+	int i, j, x, y;
+
+	ZeroMemory (&map, sizeof (Map));
+
+	map.width = map.height = BENCH_MAPSIZE;
+
+	if (!AllocateBuffer (&map.world, map.width * map.height))
+	{
+		return;
+	}
+
+	CALLOC(steps,BENCH_BATCH * BENCH_PATHMAX,COORD);
+
+	if (!steps)
+	{
+		DeleteMap (&map);
+
+		NORET_MESSAGE("PathBenchmark failed","1");
+	}
+
+	srand (1);
+
+	for (i = 0; i < map.width * map.height; i++)
+	{
+		if (rand () % 100 < 20)
+		{
+			SETFLAG((map.world.buffer + i)->flags,SOLID);
+		}
+	}
+
+	begin = clock ();
+
+	if (!MakePathGraph (&paths, &map))
+	{
+		FREE(steps);
+		DeleteMap (&map);
+
+		return;
+	}
+
+	printf ("Built %dx%d path graph in %.3f s\n", map.width, map.height, Seconds (begin));
+
+	for (i = 0; i < BENCH_BATCH; i++)
+	{
+		queries [i].path = steps + i * BENCH_PATHMAX;
+		queries [i].maxLength = BENCH_PATHMAX;
+	}
+
+	for (i = 0; i < BENCH_QUERIES; i += BENCH_BATCH)
+	{
+		for (j = 0; j < BENCH_BATCH / BENCH_GOALRUN; j++)
+		{
+			goals [j] = RandomOpenCell (&map);
+		}
+
+		for (j = 0; j < BENCH_BATCH; j++)
+		{
+			queries [j].start = RandomOpenCell (&map);
+			queries [j].goal = goals [j % (BENCH_BATCH / BENCH_GOALRUN)];
+		}
+		// Runs of queries share a goal, but no two neighbours in the batch do
+
+		begin = clock ();
+
+		for (j = 0; j < BENCH_BATCH; j++)
+		{
+			FindPath (&paths, queries [j].start, queries [j].goal, queries [j].path, queries [j].maxLength);
+		}
+
+		inOrder += Seconds (begin);
+		// Answered in order, every query links its goal afresh
+
+		begin = clock ();
+
+		numFound += FindPaths (&paths, queries, BENCH_BATCH);
+
+		grouped += Seconds (begin);
+		// Grouped by goal, each goal is linked once per batch
+
+		for (j = 0; j < BENCH_BATCH; j++)
+		{
+			if (queries [j].length != NOPATH)
+			{
+				totalLength += queries [j].length;
+			}
+		}
+	}
+
+	printf ("%d queries, %d found, average length %d, %d per goal\n", i, numFound,
+			numFound ? totalLength / numFound : 0, BENCH_GOALRUN);
+	printf ("In order: %.0f queries/sec; grouped by goal: %.0f queries/sec\n",
+			inOrder > 0.0 ? i / inOrder : 0.0, grouped > 0.0 ? i / grouped : 0.0);
+
+	begin = clock ();
+
+	for (i = 0; i < BENCH_EDITS; i++)
+	{
+		x = rand () % map.width;
+		y = rand () % map.height;
+
+		FLIPFLAG(GETMAPCELL(&map,x,y)->flags,SOLID);
+
+		MarkPathCell (&paths, x, y);
+		RefreshPathGraph (&paths);
+	}
+
+	elapsed = Seconds (begin);
+
+	printf ("%d single-cell edits: %.0f refreshes/sec\n", BENCH_EDITS, BENCH_EDITS / elapsed);
+
+	DestroyPathGraph (&paths);
+
+	FREE(steps);
+	DeleteMap (&map);
+}
+
+/********************************************************************
+*																	*
+*							String interning						*
+*																	*
+********************************************************************/
+
+void StringPoolBenchmark (void)
+{
+	static String vocabulary [] = {
+		"Yes", "No", "Cancel", "OK", "Back", "Next", "Load", "Save",
+		" 0 - NONVISIBLE", " 1 - SOLID", " 2 - OBSCURE", " 3 - OCCUPIED",
+		" 4 - TRIGGER", " 5 - DANGER", " 6 - SHIMMER", " 7 - EXIT"
+	};
+	int numWords = sizeof (vocabulary) / sizeof (String);
+	String labels [BENCH_LABELS];
+	pMenuItem items;
+	MenuItem const * item;
+	StringPoolReport report;
+	StringID id;
+	String target;
+	clock_t begin;
+	long found = 0;
+	int i, j;
+
+	CALLOC(items,BENCH_MENUS,MenuItem);
+
+	if (!items)
+	{
+		NORET_MESSAGE("StringPoolBenchmark failed","1");
+	}
+
+	srand (1);
+
+	for (i = 0; i < BENCH_MENUS; i++)
+	{
+		for (j = 0; j < BENCH_LABELS; j++)
+		{
+			labels [j] = vocabulary [rand () % numWords];
+		}
+
+		if (!LoadMenuItems (items + i, labels, BENCH_LABELS))
+		{
+			break;
+		}
+	}
+
+	GetStringPoolReport (&report);
+
+	printf ("%ld labels, %d distinct: %ld bytes as copies, %ld pooled + %ld overhead, %ld saved\n",
+			report.numRequests, report.numStrings, report.requestBytes, report.storedBytes,
+			report.overheadBytes, report.savedBytes);
+
+	id = InternString (vocabulary [numWords - 1]);
+	target = vocabulary [numWords - 1];
+
+	begin = clock ();
+
+	for (i = 0; i < BENCH_LOOKUPS; i++)
+	{
+		found += FindMenuItemEntry (items + i % BENCH_MENUS, id) >= 0;
+	}
+
+	printf ("%d lookups by ID: %.0f lookups/sec (%ld found)\n", BENCH_LOOKUPS, BENCH_LOOKUPS / Seconds (begin), found);
+
+	found = 0;
+
+	begin = clock ();
+
+	for (i = 0; i < BENCH_LOOKUPS; i++)
+	{
+		item = items + i % BENCH_MENUS;
+
+		for (j = 0; j < item->numItems && strcmp (GetString (item->text [j]), target); j++);
+
+		found += j < item->numItems;
+	}
+
+	printf ("%d lookups by strcmp: %.0f lookups/sec (%ld found)\n", BENCH_LOOKUPS, BENCH_LOOKUPS / Seconds (begin), found);
+
+	for (i = 0; i < BENCH_MENUS; i++)
+	{
+		FREE(items [i].text);
+		FREE(items [i].lParams);
+	}
+
+	FREE(items);
+
+	ClearStringPool ();
+}
+
+/********************************************************************
+*																	*
+*							Node pools								*
+*																	*
+********************************************************************/
+
+void NodePoolBenchmark (void)
+{
+	static String names [kNodeAllocationsCount] = { "heap", "shared pool", "private pool", "array" };
+	NodeAllocation allocation;
+	pStack stack;
+	intStar value;
+	clock_t begin;
+	int i, j;
+
+	for (allocation = kHeapNodes; allocation < kNodeAllocationsCount; allocation++)
+	{
+		stack = CreateStack (allocation);
+
+		if (!stack)
+		{
+			NORET_MESSAGE("NodePoolBenchmark failed","1");
+		}
+
+		begin = clock ();
+
+		for (i = 0; i < BENCH_ROUNDS; i++)
+		{
+			for (j = 0; j < BENCH_NODES; j++)
+			{
+				MALLOC(value,int);
+
+				if (!value || !PushStackNode (stack, value, kInt))
+				{
+					DestroyStack (stack);
+
+					NORET_MESSAGE("NodePoolBenchmark failed","2");
+				}
+			}
+
+			if (i & 1)
+			{
+				EmptyStack (stack);
+			}
+
+			else
+			{
+				while (stack->numNodes) PopStackNode (stack);
+			}
+		}
+
+		printf ("%s: %.0f push/release pairs/sec\n", names [allocation], (double) BENCH_ROUNDS * BENCH_NODES / Seconds (begin));
+
+		DestroyStack (stack);
+	}
+}
+
+void QueueBenchmark (void)
+{
+	static String names [kNodeAllocationsCount] = { "heap", "shared pool", "private pool", "ring" };
+	NodeAllocation allocation;
+	pQueue queue;
+	intStar value;
+	clock_t begin;
+	int i;
+
+	for (allocation = kHeapNodes; allocation < kNodeAllocationsCount; allocation++)
+	{
+		queue = CreateQueue (allocation);
+
+		if (!queue)
+		{
+			NORET_MESSAGE("QueueBenchmark failed","1");
+		}
+
+		begin = clock ();
+
+		for (i = 0; i < BENCH_ROUNDS * BENCH_NODES; i++)
+		{
+			MALLOC(value,int);
+
+			if (!value || !EnqueueQueueNode (queue, value, kInt))
+			{
+				DestroyQueue (queue);
+
+				NORET_MESSAGE("QueueBenchmark failed","2");
+			}
+
+			if (queue->numNodes > BENCH_DEPTH)
+			{
+				DequeueQueueNode (queue);
+			}
+		}
+
+		printf ("%s: %.0f enqueue/dequeue pairs/sec at depth %d\n", names [allocation], (double) BENCH_ROUNDS * BENCH_NODES / Seconds (begin), BENCH_DEPTH);
+
+		DestroyQueue (queue);
+	}
+}
+
+/********************************************************************
+*																	*
+*							Linked lists							*
+*																	*
+********************************************************************/
+
+void ListBenchmark (void)
+{
+	ListIterator iterator;
+	pListHead listHead;
+	pListNode node;
+	intStar value;
+	clock_t begin;
+	long sum = 0;
+	int i;
+
+	listHead = CreateList (kNormal, kPrivatePool);
+
+	if (!listHead)
+	{
+		NORET_MESSAGE("ListBenchmark failed","1");
+	}
+
+	begin = clock ();
+
+	for (i = 0; i < BENCH_LISTNODES; i++)
+	{
+		MALLOC(value,int);
+
+		if (!value || !AppendListNode (listHead, value, kInt))
+		{
+			DestroyList (listHead);
+
+			NORET_MESSAGE("ListBenchmark failed","2");
+		}
+
+		*value = i;
+	}
+
+	printf ("%d appends: %.3f sec\n", BENCH_LISTNODES, Seconds (begin));
+
+	begin = clock ();
+
+	InitListIterator (&iterator, listHead);
+
+	while ((node = NextListNode (&iterator)) != NULL)
+	{
+		sum += *(intStar) node->value;
+	}
+
+	printf ("Iterator walk: %.3f sec (sum %ld)\n", Seconds (begin), sum);
+
+	sum = 0;
+
+	begin = clock ();
+
+	for (i = 0; i < BENCH_LISTNODES; i++)
+	{
+		sum += *(intStar) GetListNode (listHead, i)->value;
+	}
+
+	printf ("Indexed walk: %.3f sec (sum %ld)\n", Seconds (begin), sum);
+
+	begin = clock ();
+
+	DestroyList (listHead);
+
+	printf ("Destroy: %.3f sec\n", Seconds (begin));
+}
+
+/********************************************************************
+*																	*
+*							Vectors									*
+*																	*
+********************************************************************/
+
+static int CompareInts (void const * dataA, void const * dataB)
+{
+	return *(int const *) dataA - *(int const *) dataB;
+}
+
+void VectorBenchmark (void)
+{
+	pVector vector;
+	clock_t begin;
+	long sum = 0;
+	int i, value;
+
+	vector = CreateVector (sizeof (int), kInt);
+
+	if (!vector)
+	{
+		NORET_MESSAGE("VectorBenchmark failed","1");
+	}
+
+	srand (1);
+
+	begin = clock ();
+
+	for (i = 0; i < BENCH_LISTNODES; i++)
+	{
+		value = rand ();
+
+		if (!PushVectorElement (vector, &value))
+		{
+			DestroyVector (vector);
+
+			NORET_MESSAGE("VectorBenchmark failed","2");
+		}
+	}
+
+	printf ("%d pushes: %.3f sec\n", BENCH_LISTNODES, Seconds (begin));
+
+	begin = clock ();
+
+	for (i = 0; i < vector->numElements; i++)
+	{
+		sum += ELEMENT(vector,i,int);
+	}
+
+	printf ("Indexed walk: %.3f sec (sum %ld)\n", Seconds (begin), sum);
+
+	begin = clock ();
+
+	SortVector (vector, CompareInts);
+
+	printf ("Sort: %.3f sec\n", Seconds (begin));
+
+	begin = clock ();
+
+	EraseVectorElements (vector, 0, vector->numElements / 2);
+
+	printf ("Erase front half: %.3f sec (%d left)\n", Seconds (begin), vector->numElements);
+
+	DestroyVector (vector);
+}
+
+/********************************************************************
+*																	*
+*							Message queues							*
+*																	*
+********************************************************************/
+
+typedef struct _BenchPoster {
+	pMessageQueue queue;
+	pBoundedMessageQueue bounded;
+	pMessageNode nodes;
+	LONG volatile * numPosting;
+	int id;
+	int numMessages;
+} BenchPoster;
+
+static DWORD WINAPI PostMessages (LPVOID data)
+{
+	BenchPoster * poster = (BenchPoster *) data;
+	intStar value;
+	int i;
+
+	for (i = 0; i < poster->numMessages; i++)
+	{
+		MALLOC(value,int);
+
+		if (!value)
+		{
+			break;
+		}
+
+		*value = poster->id * poster->numMessages + i;
+
+		if (poster->bounded)
+		{
+			while (!PostBoundedMessage (poster->bounded, value, kInt, NULL))
+			{
+				Sleep (1);
+			}
+		}
+
+		else
+		{
+			PostQueueMessage (poster->queue, poster->nodes + i, value, kInt);
+		}
+	}
+
+	InterlockedDecrement (poster->numPosting);
+
+	return 0;
+}
+
+static long RunMessageQueue (int numPosters, int numMessages, int bound, double * seconds)
+{
+	MessageQueue queue;
+	BoundedMessageQueue bounded;
+	BenchPoster posters [BENCH_POSTERS * 2];
+	HANDLE threads [BENCH_POSTERS * 2];
+	MessageNode taken;
+	pMessageNode node;
+	LONG volatile numPosting = numPosters;
+	LONG done;
+	int expected [BENCH_POSTERS * 2] = { 0 };
+	long numTaken = 0, errors = 0;
+	clock_t begin;
+	int i, value;
+
+	InitMessageQueue (&queue);
+
+	if (bound && !InitBoundedMessageQueue (&bounded, bound))
+	{
+		return -1;
+	}
+
+	for (i = 0; i < numPosters; i++)
+	{
+		posters [i].queue = &queue;
+		posters [i].bounded = bound ? &bounded : NULL;
+		posters [i].numPosting = &numPosting;
+		posters [i].id = i;
+		posters [i].numMessages = numMessages;
+
+		CALLOC(posters [i].nodes,bound ? 1 : numMessages,MessageNode);
+	}
+
+	begin = clock ();
+
+	for (i = 0; i < numPosters; i++)
+	{
+		threads [i] = posters [i].nodes ? CreateThread (NULL, 0, PostMessages, posters + i, 0, NULL) : NULL;
+
+		if (!threads [i])
+		{
+			InterlockedDecrement (&numPosting);
+			// A poster that never starts never finishes; its messages count as lost
+		}
+	}
+
+	for (;;)
+	{
+		done = !numPosting;
+
+		if (bound)
+		{
+			node = TakeBoundedMessage (&bounded, &taken) ? &taken : NULL;
+		}
+
+		else
+		{
+			node = TakeQueueMessage (&queue);
+		}
+
+		if (!node)
+		{
+			if (done)
+			{
+				break;
+			}
+
+			continue;
+		}
+
+		value = *(intStar) node->value;
+
+		if (value % numMessages != expected [value / numMessages]++)
+		{
+			errors++;
+		}
+
+		numTaken++;
+
+		ReleaseMessage (node);
+	}
+
+	*seconds = Seconds (begin);
+
+	for (i = 0; i < numPosters; i++)
+	{
+		if (threads [i])
+		{
+			WaitForSingleObject (threads [i], INFINITE);
+			CloseHandle (threads [i]);
+		}
+
+		FREE(posters [i].nodes);
+	}
+
+	if (bound)
+	{
+		DeinitBoundedMessageQueue (&bounded);
+	}
+
+	return errors + (long) numPosters * numMessages - numTaken;
+}
+
+void MessageQueueStress (void)
+{
+	double seconds;
+	long failures = 0, result;
+	int i, numPosters, bound;
+
+	srand (1);
+
+	for (i = 0; i < BENCH_STRESS; i++)
+	{
+		numPosters = 1 + rand () % (BENCH_POSTERS * 2);
+		bound = i & 1 ? 1 << (rand () % 6) : 0;
+
+		result = RunMessageQueue (numPosters, BENCH_MESSAGES / 20, bound, &seconds);
+
+		if (result)
+		{
+			printf ("Run %d: %d posters, bound %d: %ld messages lost or out of order\n", i, numPosters, bound, result);
+
+			failures++;
+		}
+	}
+
+	printf ("%d stress runs, %ld failed\n", BENCH_STRESS, failures);
+}
+
+void MessageQueueBenchmark (void)
+{
+	double seconds;
+	long result;
+	int numPosters, bound;
+
+	for (bound = 0; bound <= BENCH_BOUND; bound += BENCH_BOUND)
+	{
+		for (numPosters = 1; numPosters <= BENCH_POSTERS; numPosters <<= 1)
+		{
+			result = RunMessageQueue (numPosters, BENCH_MESSAGES, bound, &seconds);
+
+			printf ("%s, %d posters: %.0f messages/sec%s\n", bound ? "bounded" : "unbounded", numPosters,
+					(double) numPosters * BENCH_MESSAGES / seconds, result ? " (FAILED)" : "");
+		}
+	}
+}
@@ -24,6 +24,7 @@
 #include <math.h>
 #include <time.h>
 #include <string.h>
+#include <stddef.h>
 #include <ctype.h>
 #include <assert.h>
 
@@ -45,6 +46,53 @@
 #define WORD_LENGTH 80
 // Designate the maximum length of specialized character buffers
 
+#define CLUSTER_SIZE		16
+#define CLUSTER_NODES		(CLUSTER_SIZE << 2)
+// Designate the side length of a pathfinding cluster, and the most
+// entrances that its four borders may hold
+
+#define ACTOR_REGIONS		8
+// Designate the most trigger regions an actor is tracked within
+
+#define INPUT_RING			256
+#define INPUT_RINGMASK		(INPUT_RING - 1)
+// Designate the count of events the input thread may queue, which must
+// be a power of two
+
+#define NUM_KEYCODES		256
+#define KEYCODE_BYTES		(NUM_KEYCODES >> 3)
+// Designate the count of virtual-keycodes, and the bytes needed to hold
+// one bit per keycode
+
+#define MAX_PARENTWINDOWS	16
+#define NO_OWNER			0xFF
+// Designate the most parent windows a window manager may stack, and the
+// hit-test value of a screen cell no parent window covers
+
+#define LOG_STRIDE			64
+#define LOG_CHUNK			4096
+#define LOG_CHUNKS			4096
+#define LOG_COLUMNS			4096
+// Designate the lines between sparse log index entries, the entries per
+// index chunk, the most chunks, and the widest log line shown
+
+#define STRING_BLOCK		4096
+#define STRING_BUCKETS		256
+#define STRING_BUCKETMASK	(STRING_BUCKETS - 1)
+#define NO_STRING			0
+// Designate the characters per string pool block, the count of hash
+// buckets, which must be a power of two, and the ID of no string
+
+#define NODE_SLAB			256
+// Designate the count of ADT nodes carved from each pool slab
+
+#define VECTOR_MINIMUM		8
+// Designate the fewest elements room is made for when a vector grows
+
+#define NODE_ARRAY			16
+// Designate the first count of nodes held by an array-backed stack or
+// queue, which must be a power of two
+
 #define SPACE			  '\x20'
 // Character used to denote a space
 #define UNDERSCORE		  '\x5F'
@@ -128,6 +176,7 @@ typedef enum _dataType {
 	kQueue,														// Queue
 	kStack,														// Stack
 	kHydra,														// Hydra
+	kVector,													// Vector
 	kUserDefined,												// User-defined data
 	kDefinedTypesCount											// Count of defined types
 } dataType;
@@ -166,6 +215,16 @@ typedef void * voidStar;
 
 typedef char * String;
 
+/********************************************************************
+*																	*
+*							Alias: StringID							*
+*																	*
+*	Purpose:	Used to identify a string in the string pool		*
+*																	*
+********************************************************************/
+
+typedef int StringID;
+
 /********************************************************************
 *																	*
 *							Alias: shortStar						*
@@ -256,6 +315,7 @@ typedef enum _ADTStyle {
 	kADTList,		// Linked list
 	kADTQueue,		// Queue
 	kADTStack,		// Stack
+	kADTMessage,	// Message queue
 	kADTStylesCount // Count of available ADT styles
 } ADTStyle;
 
@@ -273,6 +333,58 @@ typedef enum _listMode {
 	kListModesCount // Count of available list modes
 } listMode;
 
+/********************************************************************
+*																	*
+*							Enumeration: _NodeAllocation			*
+*																	*
+*	Purpose:	Descriptor for where an ADT gets its nodes			*
+*																	*
+********************************************************************/
+
+typedef enum _NodeAllocation {
+	kHeapNodes,				// Each node is allocated from the heap
+	kSharedPool,			// Nodes come from a pool shared by ADTs of a type
+	kPrivatePool,			// Nodes come from a pool the ADT owns
+	kNodeArray,				// Nodes live inline in an array (stacks and queues)
+	kNodeAllocationsCount	// Count of available node allocations
+} NodeAllocation;
+
+/********************************************************************
+*																	*
+*							Aggregate: _NodeSlab					*
+*																	*
+*	Purpose:	Block of nodes allocated at once; nodes follow it	*
+*	Fields:															*
+*		> next	- Slab allocated before this one					*
+*																	*
+********************************************************************/
+
+typedef struct _NodeSlab {
+	struct _NodeSlab * next;
+} NodeSlab, * pNodeSlab;
+
+/********************************************************************
+*																	*
+*							Aggregate: _NodePool					*
+*																	*
+*	Purpose:	Recycles ADT nodes of one size						*
+*	Fields:															*
+*		> nodeSize	- Size of each node								*
+*		> slabs		- Most recently allocated slab					*
+*		> freeNodes	- Chain of released nodes						*
+*		> cursor	- Next unused node in the newest slab			*
+*		> numUnused	- Count of unused nodes in the newest slab		*
+*																	*
+********************************************************************/
+
+typedef struct _NodePool {
+	int nodeSize;
+	pNodeSlab slabs;
+	voidStar freeNodes;
+	PBYTE cursor;
+	int numUnused;
+} NodePool, * pNodePool;
+
 /********************************************************************
 *																	*
 *							Aggregate: _ListNode					*
@@ -301,9 +413,15 @@ typedef struct _ListNode {
 *																	*
 *	Purpose:	Used to compose a linked list ADT; primary object	*
 *	Fields:															*
-*		> numNodes	- Count of list nodes							*
-*		> mode		- Descriptor of the means of implementing list	*
-*		> head		- Head of linked list							*
+*		> numNodes		- Count of list nodes						*
+*		> mode			- Descriptor of the means of implementing	*
+*						  list										*
+*		> head			- Head of linked list						*
+*		> tail			- Last node of linked list					*
+*		> cursor		- Node most recently accessed by index		*
+*		> cursorIndex	- Index of cursor node						*
+*		> allocation	- Where the list gets its nodes				*
+*		> pool			- Pool nodes come from, if any				*
 *																	*
 ********************************************************************/
 
@@ -311,8 +429,31 @@ typedef struct _ListHead {
 	int numNodes;
 	listMode mode;
 	pListNode head;
+	pListNode tail;
+	pListNode cursor;
+	int cursorIndex;
+	NodeAllocation allocation;
+	pNodePool pool;
 } ListHead, * pListHead;
 
+/********************************************************************
+*																	*
+*							Aggregate: _ListIterator				*
+*																	*
+*	Purpose:	Used to walk a linked list front to back			*
+*	Fields:															*
+*		> listHead	- List being walked								*
+*		> node		- Node the next step will return				*
+*		> index		- Index of node									*
+*																	*
+********************************************************************/
+
+typedef struct _ListIterator {
+	pListHead listHead;
+	pListNode node;
+	int index;
+} ListIterator, * pListIterator;
+
 /********************************************************************
 *																	*
 *							Aggregate: _Hydra						*
@@ -355,14 +496,22 @@ typedef struct _StackNode {
 *																	*
 *	Purpose:	Used to compose a stack ADT; primary object			*
 *	Fields:															*
-*		> numNodes	- Count of stack nodes							*
-*		> top		- Top of stack									*
+*		> numNodes		- Count of stack nodes						*
+*		> top			- Top of stack								*
+*		> allocation	- Where the stack gets its nodes			*
+*		> pool			- Pool nodes come from, if any				*
+*		> nodes			- Array of nodes, bottom first, if any		*
+*		> capacity		- Count of nodes the array holds			*
 *																	*
 ********************************************************************/
 
 typedef struct _Stack {
 	int numNodes;
 	pStackNode top;
+	NodeAllocation allocation;
+	pNodePool pool;
+	pStackNode nodes;
+	int capacity;
 } Stack, * pStack;
 
 /********************************************************************
@@ -391,16 +540,126 @@ typedef struct _QueueNode {
 *																	*
 *	Purpose:	Used to compose a queue ADT; primary object			*
 *	Fields:															*
-*		> numNodes	- Count of list nodes							*
-*		> tail		- Tail of queue									*
+*		> numNodes		- Count of list nodes						*
+*		> tail			- Tail of queue								*
+*		> allocation	- Where the queue gets its nodes			*
+*		> pool			- Pool nodes come from, if any				*
+*		> ring			- Ring of nodes, if any						*
+*		> capacity		- Count of nodes the ring holds				*
+*		> head			- Index of the "first-in" node in ring		*
 *																	*
 ********************************************************************/
 
 typedef struct _Queue {
 	int numNodes;
 	pQueueNode tail;
+	NodeAllocation allocation;
+	pNodePool pool;
+	pQueueNode ring;
+	int capacity;
+	int head;
 } Queue, * pQueue;
 
+/********************************************************************
+*																	*
+*							Aggregate: _Vector						*
+*																	*
+*	Purpose:	Used to compose a contiguous, growable array ADT	*
+*	Fields:															*
+*		> numElements	- Count of elements in use					*
+*		> capacity		- Count of elements room is held for		*
+*		> elementSize	- Size of each element						*
+*		> type			- Descriptor of type of data stored			*
+*		> remove		- Method for user-defined data removal		*
+*		> elements		- Element storage, packed inline			*
+*																	*
+********************************************************************/
+
+typedef struct _Vector {
+	int numElements;
+	int capacity;
+	int elementSize;
+	dataType type;
+	int (* remove) (voidStar data);
+	PBYTE elements;
+} Vector, * pVector;
+
+/********************************************************************
+*																	*
+*							Aggregate: _MessageNode					*
+*																	*
+*	Purpose:	Used to compose a message queue; owned by poster	*
+*	Fields:															*
+*		> next		- Pointer to subsequent node in queue			*
+*		> value		- Storage for generic data						*
+*		> type		- Descriptor of type of data stored in node		*
+*		> remove	- Method for user-defined data removal			*
+*																	*
+********************************************************************/
+
+typedef struct _MessageNode {
+	struct _MessageNode * volatile next;
+	voidStar value;
+	dataType type;
+	int (* remove) (voidStar data);
+} MessageNode, * pMessageNode;
+
+/********************************************************************
+*																	*
+*							Aggregate: _MessageQueue				*
+*																	*
+*	Purpose:	Lock-free queue posted by many threads, drained by	*
+*				one													*
+*	Fields:															*
+*		> tail	- Node most recently posted; swapped by posters		*
+*		> head	- Oldest node; read by the draining thread alone	*
+*		> stub	- Placeholder that keeps the chain from emptying	*
+*																	*
+********************************************************************/
+
+typedef struct _MessageQueue {
+	pMessageNode volatile tail;
+	pMessageNode head;
+	MessageNode stub;
+} MessageQueue, * pMessageQueue;
+
+/********************************************************************
+*																	*
+*							Aggregate: _MessageSlot					*
+*																	*
+*	Purpose:	Used to compose a bounded message queue				*
+*	Fields:															*
+*		> sequence	- Count of posts the slot is ready to accept	*
+*		> message	- Message held in slot							*
+*																	*
+********************************************************************/
+
+typedef struct _MessageSlot {
+	LONG volatile sequence;
+	MessageNode message;
+} MessageSlot, * pMessageSlot;
+
+/********************************************************************
+*																	*
+*							Aggregate: _BoundedMessageQueue			*
+*																	*
+*	Purpose:	Lock-free ring posted by many threads, drained by	*
+*				one													*
+*	Fields:															*
+*		> slots		- Ring of message slots							*
+*		> capacity	- Count of slots; a power of two				*
+*		> tail		- Count of posts claimed						*
+*		> head		- Count of messages taken						*
+*																	*
+********************************************************************/
+
+typedef struct _BoundedMessageQueue {
+	pMessageSlot slots;
+	LONG capacity;
+	LONG volatile tail;
+	LONG head;
+} BoundedMessageQueue, * pBoundedMessageQueue;
+
 /********************************************************************
 *																	*
 *							Aggregate: _ADTUnion					*
@@ -461,6 +720,48 @@ typedef enum _InputStyle {
 	kInputStylesCount	// Count of available input styles
 } InputStyle;
 
+/********************************************************************
+*																	*
+*							Enumeration: _InputSource				*
+*																	*
+*	Purpose:	Descriptor for where input events come from			*
+*																	*
+********************************************************************/
+
+typedef enum _InputSource {
+	kLive,				// Events are read from the console
+	kRecord,			// Events are read from the console and journaled
+	kReplay,			// Events are read from a journal
+	kInputSourcesCount	// Count of available input sources
+} InputSource;
+
+/********************************************************************
+*																	*
+*							Aggregate: _InputEntry					*
+*																	*
+*	Purpose:	Packed input event, as stored in a journal			*
+*	Fields:															*
+*		> frame	- Count of GetInput calls preceding event			*
+*		> state	- Key down status, full mouse button state with		*
+*				  wheel delta, or focus								*
+*		> type	- Event type of record								*
+*		> flags	- Mouse event flags									*
+*		> ascii	- Character of key event							*
+*		> code	- Virtual keycode, or mouse x coordinate			*
+*		> y		- Mouse y coordinate								*
+*																	*
+********************************************************************/
+
+typedef struct _InputEntry {
+	DWORD frame;
+	DWORD state;
+	BYTE type;
+	BYTE flags;
+	char ascii;
+	WORD code;
+	WORD y;
+} InputEntry, * pInputEntry;
+
 /********************************************************************
 *																	*
 *							Aggregate: _MouseInfo					*
@@ -485,6 +786,67 @@ typedef struct _MouseInfo {
 	COORD mouseCoord;
 } MouseInfo, * pMouseInfo;
 
+/********************************************************************
+*																	*
+*							Aggregate: _InputRing					*
+*																	*
+*	Purpose:	Queue filled by input thread, drained by GetInput	*
+*	Fields:															*
+*		> records	- Ring of queued input records					*
+*		> head		- Count of records popped						*
+*		> tail		- Count of records pushed						*
+*		> inputH	- Input handle read by the thread				*
+*		> thread	- Thread draining the console					*
+*		> ready		- Event signaled when records are pushed		*
+*		> active	- Indicates that the thread should keep running	*
+*																	*
+********************************************************************/
+
+typedef struct _InputRing {
+	INPUT_RECORD records [INPUT_RING];
+	LONG volatile head;
+	LONG volatile tail;
+	HANDLE inputH;
+	HANDLE thread;
+	HANDLE ready;
+	LONG volatile active;
+} InputRing, * pInputRing;
+
+/********************************************************************
+*																	*
+*							Aggregate: _InputSnapshot				*
+*																	*
+*	Purpose:	Input state gathered once per frame					*
+*	Fields:															*
+*		> held				- Bitmap of keys down at end of frame	*
+*		> pressed			- Bitmap of keys pressed during frame	*
+*		> released			- Bitmap of keys released during frame	*
+*		> numEvents			- Count of events gathered				*
+*		> mouseCoord		- Mouse position at end of frame		*
+*		> xDelta, yDelta	- Mouse movement during frame			*
+*		> leftDown			- Left mouse button is down				*
+*		> rightDown			- Right mouse button is down			*
+*		> numClicks			- Count of left button presses			*
+*		> numDoubleClicks	- Count of double-clicks				*
+*		> wheel				- Net wheel notches, positive away		*
+*							  from the user							*
+*																	*
+********************************************************************/
+
+typedef struct _InputSnapshot {
+	BYTE held [KEYCODE_BYTES];
+	BYTE pressed [KEYCODE_BYTES];
+	BYTE released [KEYCODE_BYTES];
+	int numEvents;
+	COORD mouseCoord;
+	int xDelta, yDelta;
+	BOOL leftDown;
+	BOOL rightDown;
+	int numClicks;
+	int numDoubleClicks;
+	int wheel;
+} InputSnapshot, * pInputSnapshot;
+
 /********************************************************************
 *																	*
 *							Aggregate: _InputInfo					*
@@ -514,6 +876,19 @@ typedef struct _InputInfo {
 *		> lastKeycode	- Last keycode retrieved as input			*
 *		> information	- Application-defined information			*
 *		> lastChar		- Last character retrieved as input			*
+*		> source		- Where events come from					*
+*		> journal		- File events are recorded to or replayed	*
+*						  from										*
+*		> frame			- Count of GetInput calls					*
+*		> pending		- Next journal entry to replay				*
+*		> ring			- Queue filled by the input thread			*
+*		> keysHeld		- Bitmap of keys currently down				*
+*		> keysPressed	- Bitmap of keys pressed since last			*
+*						  snapshot									*
+*		> keysReleased	- Bitmap of keys released since last		*
+*						  snapshot									*
+*		> coalesceMoves	- Collapse runs of mouse moves into the		*
+*						  latest one								*
 *																	*
 ********************************************************************/
 
@@ -525,6 +900,15 @@ typedef struct _Input {
 	int lastKeycode;
 	pInputInfo information;
 	char lastChar;
+	InputSource source;
+	fileStar journal;
+	DWORD frame;
+	InputEntry pending;
+	pInputRing ring;
+	BYTE keysHeld [KEYCODE_BYTES];
+	BYTE keysPressed [KEYCODE_BYTES];
+	BYTE keysReleased [KEYCODE_BYTES];
+	BOOL coalesceMoves;
 } Input, * pInput;
 
 /********************************************************************
@@ -543,6 +927,35 @@ typedef struct _Key {
 	int (* function) (voidStar data, dataType type, long lParam);
 } Key, * pKey;
 
+/********************************************************************
+*																	*
+*							Enumeration: _HotKeyScope				*
+*																	*
+*	Purpose:	Descriptor for a layer of hotkey bindings			*
+*																	*
+********************************************************************/
+
+typedef enum _HotKeyScope {
+	kFocusScope,		// Bindings of the window with focus
+	kWindowScope,		// Bindings of the parent window
+	kGlobalScope,		// Bindings shared by every parent window
+	kHotKeyScopesCount	// Count of available hotkey scopes
+} HotKeyScope;
+
+/********************************************************************
+*																	*
+*							Aggregate: _HotKeyTable					*
+*																	*
+*	Purpose:	Dispatch table of keys, indexed by keycode			*
+*	Fields:															*
+*		> keys	- Key bound to each keycode, if any					*
+*																	*
+********************************************************************/
+
+typedef struct _HotKeyTable {
+	pKey keys [NUM_KEYCODES];
+} HotKeyTable, * pHotKeyTable;
+
 /*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
 /********************************************************************
 *																	*
@@ -1258,7 +1671,7 @@ typedef enum _MessageBoxBroadcast {
 *		> height	- Height of a menu item							*
 *		> entry		- Index of selected menu item entry				*
 *		> numItems	- Count of text / lParam entries				*
-*		> text		- Array of text entries							*
+*		> text		- Array of interned text entries				*
 *		> lParams	- Array of lParam entries						*
 *		> highlight	- Value used to highlight selected menu item	*
 *																	*
@@ -1270,7 +1683,7 @@ typedef struct _MenuItem {
 	int height;
 	int entry;
 	int numItems;
-	String * text;
+	StringID * text;
 	longStar lParams;
 	BYTE highlight;
 } MenuItem, * pMenuItem;
@@ -1286,6 +1699,7 @@ typedef struct _MenuItem {
 *		> keys			- Array of keys for navigating menu			*
 *		> numItems		- Count of menu items						*
 *		> menu			- Array of menu items						*
+*		> table			- Dispatch table compiled from keys			*
 *																	*
 ********************************************************************/
 
@@ -1295,6 +1709,7 @@ typedef struct _Menu {
 	pKey keys;
 	int numItems;
 	pMenuItem menu;
+	pHotKeyTable table;
 } Menu, * pMenu;
 
 /********************************************************************
@@ -1341,6 +1756,12 @@ typedef struct _Receivers {
 *		> numChars	- Count of text characters						*
 *		> text		- Array of text characters						*
 *		> word		- Temporary storage of a word parsed from text	*
+*		> gapStart	- Index of first free character in an edit		*
+*					  box's text									*
+*		> gapEnd	- Index past last free character in an edit		*
+*					  box's text, or 0 before the gap is opened		*
+*		> source	- Interned string shown in place of owned		*
+*					  text, or NO_STRING							*
 *																	*
 ********************************************************************/
 
@@ -1351,8 +1772,93 @@ typedef struct _TextBuffer {
 	int numChars;
 	String text;
 	char word [WORD_LENGTH];
+	int gapStart;
+	int gapEnd;
+	StringID source;
 } TextBuffer, * pTextBuffer;
 
+/********************************************************************
+*																	*
+*							Aggregate: _LayoutRun					*
+*																	*
+*	Purpose:	Run of text laid out on one row of a display		*
+*	Fields:															*
+*		> start		- Index into text of run's first character		*
+*		> cursor	- Index into display of run's first cell		*
+*		> length	- Count of characters in run					*
+*																	*
+********************************************************************/
+
+typedef struct _LayoutRun {
+	int start;
+	int cursor;
+	int length;
+} LayoutRun, * pLayoutRun;
+
+/********************************************************************
+*																	*
+*							Aggregate: _TextLayout					*
+*																	*
+*	Purpose:	Word-wrapped placement of a text on a display		*
+*	Fields:															*
+*		> text		- Text the layout was built from				*
+*		> numChars	- Count of text characters laid out				*
+*		> width		- Display width the layout was built for		*
+*		> numRuns	- Count of runs									*
+*		> runs		- Array of runs, in text order					*
+*																	*
+********************************************************************/
+
+typedef struct _TextLayout {
+	String text;
+	int numChars;
+	int width;
+	int numRuns;
+	pLayoutRun runs;
+} TextLayout, * pTextLayout;
+
+/********************************************************************
+*																	*
+*							Aggregate: _LogView						*
+*																	*
+*	Purpose:	Memory-mapped log file shown in a message box		*
+*	Fields:															*
+*		> fileH		- Handle to log file							*
+*		> mapH		- Handle to mapping of log file					*
+*		> base		- Mapped contents of log file					*
+*		> size		- Count of mapped bytes							*
+*		> chunks	- Sparse index: offset of every LOG_STRIDE-th	*
+*					  line, in chunks of LOG_CHUNK entries			*
+*		> numRows	- Count of indexed lines, including a partial	*
+*					  last line										*
+*		> indexed	- Count of bytes indexed						*
+*		> lines		- Count of complete lines indexed				*
+*		> lastRow	- Row most recently found						*
+*		> lastLine	- Offset of row most recently found				*
+*		> lock		- Guards the mapping while it is read or grown	*
+*		> thread	- Handle to indexing thread						*
+*		> wake		- Event signaled when the mapping grows			*
+*		> active	- Indicates whether the thread should run		*
+*																	*
+********************************************************************/
+
+typedef struct _LogView {
+	HANDLE fileH;
+	HANDLE mapH;
+	PBYTE base;
+	LONGLONG size;
+	LONGLONG * chunks [LOG_CHUNKS];
+	volatile LONG numRows;
+	LONGLONG indexed;
+	long lines;
+	long lastRow;
+	LONGLONG lastLine;
+	CRITICAL_SECTION lock;
+	HANDLE thread;
+	HANDLE wake;
+	volatile LONG active;
+} LogView, * pLogView;
+
 /********************************************************************
 *																	*
 *							Aggregate: _IO_Descriptor				*
@@ -1363,6 +1869,8 @@ typedef struct _TextBuffer {
 *		> writeMode	- Descriptor of the means text is output		*
 *		> text		- Text information								*
 *		> cursor	- Index of read / write cursor					*
+*		> layout	- Cached layout of text, for message boxes		*
+*		> log		- Log file shown, for log viewers				*
 *																	*
 ********************************************************************/
 
@@ -1371,6 +1879,8 @@ typedef struct _IO_Descriptor {
 	WriteMode writeMode;
 	TextBuffer text;
 	int cursor;
+	pTextLayout layout;
+	pLogView log;
 } IO_Descriptor, * pIO_Descriptor;
 
 /********************************************************************
@@ -1409,6 +1919,34 @@ typedef struct _Separator {
 	pSeparatorEntry vertSeparators;
 } Separator, * pSeparator;
 
+/********************************************************************
+*																	*
+*							Aggregate: _VirtualView					*
+*																	*
+*	Purpose:	Produces a window's content on demand				*
+*	Fields:															*
+*		> source		- Callback writing a run of content cells	*
+*		> data			- Data passed to source						*
+*		> numRows		- Row count of content						*
+*		> numColumns	- Column count of content					*
+*		> row			- Content row at top of display region		*
+*		> column		- Content column at left of display region	*
+*		> firstRow		- Content row held in first cached row		*
+*		> overscan		- Rows cached beyond each side of display	*
+*																	*
+********************************************************************/
+
+typedef struct _VirtualView {
+	void (* source) (voidStar data, long row, long column, pCell cells, int count);
+	voidStar data;
+	long numRows;
+	long numColumns;
+	long row;
+	long column;
+	long firstRow;
+	int overscan;
+} VirtualView, * pVirtualView;
+
 /********************************************************************
 *																	*
 *							Aggregate: _Window						*
@@ -1432,6 +1970,8 @@ typedef struct _Separator {
 *		> mode			- Descriptor of window management			*
 *		> data			- Application-defined data					*
 *		> background	- Background color of window				*
+*		> damage		- Region of display changed since last draw	*
+*		> view			- On-demand content source, if virtual		*
 *																	*
 ********************************************************************/
 
@@ -1452,6 +1992,8 @@ typedef struct _Window {
 	WindowMode mode;
 	WORD data;
 	BYTE background;
+	RECT damage;
+	pVirtualView view;
 } Window, * pWindow;
 
 /********************************************************************
@@ -1478,6 +2020,15 @@ typedef struct _Window {
 *		> confirmKey	- Keycode used to confirm information		*
 *		> background	- Background color of parent window			*
 *		> border		- Border / separator color					*
+*		> hotKeys		- Dispatch table of parent window's keys	*
+*		> globalKeys	- Dispatch table shared by parent windows	*
+*		> deadline		- Tick count of next animation update		*
+*		> damage		- Region of screen changed since last		*
+*						  present									*
+*		> chrome		- Composed border and background cells		*
+*		> blob			- Compiled allocation holding the parent,	*
+*						  if it was loaded from a blob				*
+*		> blobSize		- Size of the blob's arena, in bytes		*
 *																	*
 ********************************************************************/
 
@@ -1500,8 +2051,42 @@ typedef struct _ParentWindow {
 	int confirmKey;
 	BYTE background;
 	BYTE border;
+	pHotKeyTable hotKeys;
+	pHotKeyTable globalKeys;
+	DWORD deadline;
+	RECT damage;
+	PCHAR_INFO chrome;
+	PBYTE blob;
+	DWORD blobSize;
 } ParentWindow, * pParentWindow;
 
+/********************************************************************
+*																	*
+*							Aggregate: _WindowManager				*
+*																	*
+*	Purpose:	Stacks overlapping parent windows					*
+*	Fields:															*
+*		> parents		- Parent windows, from bottom to top		*
+*		> numParents	- Count of parent windows					*
+*		> top			- Index of topmost active parent window		*
+*		> owners		- Index of topmost parent window covering	*
+*						  each screen cell							*
+*		> visibleCells	- Count of cells each parent window owns	*
+*		> back			- Surface parent windows are drawn against	*
+*		> dirty			- Indicates that stacking has changed		*
+*																	*
+********************************************************************/
+
+typedef struct _WindowManager {
+	pParentWindow parents [MAX_PARENTWINDOWS];
+	int numParents;
+	int top;
+	BYTE owners [SCREEN_HEIGHT] [SCREEN_WIDTH];
+	int visibleCells [MAX_PARENTWINDOWS];
+	pScreenBuffer back;
+	BOOL dirty;
+} WindowManager, * pWindowManager;
+
 /*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
 /********************************************************************
 *																	*
@@ -1592,6 +2177,46 @@ typedef struct _File {
 	pCompressionIndex compression;
 } File, * pFile;
 
+/********************************************************************
+*																	*
+*							Aggregate: _BlobHeader					*
+*																	*
+*	Purpose:	Leading record of a compiled parent window file		*
+*	Fields:															*
+*		> tag			- Identifies the file as a compiled blob	*
+*		> pointerSize	- Pointer size the blob was compiled for	*
+*		> size			- Size of the blob's arena, in bytes		*
+*		> numFixups		- Count of pointers to be relocated			*
+*																	*
+********************************************************************/
+
+typedef struct _BlobHeader {
+	DWORD tag;
+	DWORD pointerSize;
+	DWORD size;
+	DWORD numFixups;
+} BlobHeader, * pBlobHeader;
+
+/********************************************************************
+*																	*
+*							Aggregate: _BlobWriter					*
+*																	*
+*	Purpose:	Lays a parent window out as a relocatable arena		*
+*	Fields:															*
+*		> arena			- Memory being written; NULL when sizing	*
+*		> size			- Bytes placed in the arena so far			*
+*		> fixups		- Offsets of pointers within the arena		*
+*		> numFixups		- Count of pointers placed so far			*
+*																	*
+********************************************************************/
+
+typedef struct _BlobWriter {
+	PBYTE arena;
+	DWORD size;
+	LPDWORD fixups;
+	DWORD numFixups;
+} BlobWriter, * pBlobWriter;
+
 /*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
 /********************************************************************
 *																	*
@@ -1628,6 +2253,260 @@ typedef struct _Scene {
 	BYTE bField, bField2, bField3;
 } Scene, * pScene;
 
+/*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
+/********************************************************************
+*																	*
+*							World data structures					*
+*																	*
+********************************************************************/
+/*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
+
+/********************************************************************
+*																	*
+*							Aggregate: _PathEntrance				*
+*																	*
+*	Purpose:	Passage between two neighboring path clusters		*
+*	Fields:															*
+*		> offset	- Offset of passage along shared border			*
+*		> nodeA		- Node index in west or north cluster			*
+*		> nodeB		- Node index in east or south cluster			*
+*																	*
+********************************************************************/
+
+typedef struct _PathEntrance {
+	int offset;
+	int nodeA, nodeB;
+} PathEntrance, * pPathEntrance;
+
+/********************************************************************
+*																	*
+*							Aggregate: _PathBorder					*
+*																	*
+*	Purpose:	Passages through one side of a path cluster			*
+*	Fields:															*
+*		> numEntrances	- Count of entrances						*
+*		> entrances		- Array of entrances						*
+*																	*
+********************************************************************/
+
+typedef struct _PathBorder {
+	int numEntrances;
+	PathEntrance entrances [CLUSTER_SIZE];
+} PathBorder, * pPathBorder;
+
+/********************************************************************
+*																	*
+*							Aggregate: _PathCluster					*
+*																	*
+*	Purpose:	Square region of a map used in abstract searches	*
+*	Fields:															*
+*		> bounds	- Corners of cluster, right and bottom excluded	*
+*		> numNodes	- Count of abstract nodes						*
+*		> nodes		- Locations of abstract nodes					*
+*		> sides		- Border each node lies on						*
+*		> entries	- Entrance index of each node along its border	*
+*		> costs		- Matrix of travel costs between nodes			*
+*		> dirty		- Indicates that cells have changed				*
+*		> stale		- Indicates that nodes must be regathered		*
+*																	*
+********************************************************************/
+
+typedef struct _PathCluster {
+	RECT bounds;
+	int numNodes;
+	COORD nodes [CLUSTER_NODES];
+	BYTE sides [CLUSTER_NODES];
+	BYTE entries [CLUSTER_NODES];
+	intStar costs;
+	BOOL dirty;
+	BOOL stale;
+} PathCluster, * pPathCluster;
+
+/********************************************************************
+*																	*
+*							Aggregate: _PathQuery					*
+*																	*
+*	Purpose:	Request for a path, used in batched searches		*
+*	Fields:															*
+*		> start		- Cell to begin path at							*
+*		> goal		- Cell to end path at							*
+*		> path		- Buffer to receive steps of path				*
+*		> maxLength	- Capacity of path buffer						*
+*		> length	- Count of steps in path, or -1 if none found	*
+*																	*
+********************************************************************/
+
+typedef struct _PathQuery {
+	COORD start;
+	COORD goal;
+	PCOORD path;
+	int maxLength;
+	int length;
+} PathQuery, * pPathQuery;
+
+/********************************************************************
+*																	*
+*							Aggregate: _PathGraph					*
+*																	*
+*	Purpose:	Abstract graph used to find paths across a map		*
+*	Fields:															*
+*		> map			- Map whose SOLID cells are avoided			*
+*		> xClusters		- Count of clusters across map				*
+*		> yClusters		- Count of clusters down map				*
+*		> clusters		- Array of clusters							*
+*		> east			- Array of east borders of clusters			*
+*		> south			- Array of south borders of clusters		*
+*		> numDirty		- Count of clusters awaiting rebuild		*
+*		> numSlots		- Count of abstract node slots				*
+*		> stamp			- Search generation, used in lieu of clears	*
+*		> visited		- Search generation of each node			*
+*		> closed		- Indicates that a node has been expanded	*
+*		> costs			- Cost from start to each node				*
+*		> scores		- Estimated total cost through each node	*
+*		> parents		- Predecessor of each node					*
+*		> heap			- Open list of nodes						*
+*		> heapIndex		- Position of each node in open list		*
+*		> heapSize		- Count of nodes in open list				*
+*		> localStamp	- Generation of cluster-local searches		*
+*		> localSeen		- Local search generation of each cell		*
+*		> localDist		- Local distance to each cell				*
+*		> localParent	- Local predecessor of each cell			*
+*		> localQueue	- Queue used in local searches				*
+*		> startCosts	- Costs from start to its cluster's nodes	*
+*		> goalCosts		- Costs from goal's cluster's nodes to goal	*
+*		> lastGoal		- Goal whose costs are held in goalCosts	*
+*		> route			- Abstract nodes along most recent route	*
+*																	*
+********************************************************************/
+
+typedef struct _PathGraph {
+	pMap map;
+	int xClusters, yClusters;
+	pPathCluster clusters;
+	pPathBorder east;
+	pPathBorder south;
+	int numDirty;
+	int numSlots;
+	DWORD stamp;
+	LPDWORD visited;
+	PBYTE closed;
+	intStar costs;
+	intStar scores;
+	intStar parents;
+	intStar heap;
+	intStar heapIndex;
+	int heapSize;
+	DWORD localStamp;
+	DWORD localSeen [CLUSTER_SIZE * CLUSTER_SIZE];
+	int localDist [CLUSTER_SIZE * CLUSTER_SIZE];
+	int localParent [CLUSTER_SIZE * CLUSTER_SIZE];
+	int localQueue [CLUSTER_SIZE * CLUSTER_SIZE];
+	int startCosts [CLUSTER_NODES];
+	int goalCosts [CLUSTER_NODES];
+	COORD lastGoal;
+	intStar route;
+} PathGraph, * pPathGraph;
+
+/********************************************************************
+*																	*
+*							Aggregate: _Sight						*
+*																	*
+*	Purpose:	Cached field of view over a map						*
+*	Fields:															*
+*		> map		- Map whose OBSCURE and SOLID cells block view	*
+*		> viewer	- Cell that view was last cast from				*
+*		> radius	- Farthest distance that can be seen			*
+*		> span		- Side length of visibility grid				*
+*		> visible	- Grid of visible cells, centered on viewer		*
+*		> dirty		- Indicates that a blocker has changed			*
+*																	*
+********************************************************************/
+
+typedef struct _Sight {
+	pMap map;
+	COORD viewer;
+	int radius;
+	int span;
+	PBYTE visible;
+	BOOL dirty;
+} Sight, * pSight;
+
+/********************************************************************
+*																	*
+*							Enumeration: _RegionEvent				*
+*																	*
+*	Purpose:	Descriptor for an actor's passage across a region	*
+*																	*
+********************************************************************/
+
+typedef enum _RegionEvent {
+	kRegionEnter,		// Actor has moved into a region
+	kRegionExit,		// Actor has moved out of a region
+	kRegionEventsCount	// Count of region events
+} RegionEvent;
+
+/********************************************************************
+*																	*
+*							Aggregate: _Region						*
+*																	*
+*	Purpose:	Contiguous run of cells sharing a trigger flag		*
+*	Fields:															*
+*		> flag		- TRIGGER, DANGER, or EXIT						*
+*		> data		- Data of first cell found in region			*
+*		> bounds	- Corners of region, right and bottom excluded	*
+*		> numCells	- Count of cells in region						*
+*																	*
+********************************************************************/
+
+typedef struct _Region {
+	BYTE flag;
+	BYTE data;
+	RECT bounds;
+	int numCells;
+} Region, * pRegion;
+
+/********************************************************************
+*																	*
+*							Aggregate: _RegionActor					*
+*																	*
+*	Purpose:	Mover whose passage across regions is tracked		*
+*	Fields:															*
+*		> bounds		- Cells covered, right and bottom excluded	*
+*		> numRegions	- Count of regions presently overlapped		*
+*		> regions		- IDs of regions presently overlapped		*
+*		> data			- Application-defined data storage			*
+*																	*
+********************************************************************/
+
+typedef struct _RegionActor {
+	RECT bounds;
+	int numRegions;
+	int regions [ACTOR_REGIONS];
+	voidStar data;
+} RegionActor, * pRegionActor;
+
+/********************************************************************
+*																	*
+*							Aggregate: _RegionIndex					*
+*																	*
+*	Purpose:	Lookup of trigger regions over a map				*
+*	Fields:															*
+*		> map			- Map whose flagged cells are indexed		*
+*		> numRegions	- Count of regions							*
+*		> regions		- Array of regions, indexed by ID			*
+*		> labels		- Region ID plus one of each cell, per flag	*
+*		> handler		- Function called on enter and exit events	*
+*																	*
+********************************************************************/
+
+typedef struct _RegionIndex {
+	pMap map;
+	int numRegions;
+	pRegion regions;
+	intStar labels;
+	int (* handler) (pRegionActor actor, pRegion region, RegionEvent event);
+} RegionIndex, * pRegionIndex;
+
 /*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
 /********************************************************************
 *																	*
@@ -1636,6 +2515,96 @@ typedef struct _Scene {
 ********************************************************************/
 /*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
 
+/********************************************************************
+*																	*
+*							Aggregate: _StringEntry					*
+*																	*
+*	Purpose:	An interned string, chained by hash					*
+*	Fields:															*
+*		> string	- Characters of the string						*
+*		> length	- Length of the string							*
+*		> next		- Next ID in the string's hash chain			*
+*																	*
+********************************************************************/
+
+typedef struct _StringEntry {
+	String string;
+	int length;
+	StringID next;
+} StringEntry, * pStringEntry;
+
+/********************************************************************
+*																	*
+*							Aggregate: _StringBlock					*
+*																	*
+*	Purpose:	Storage for interned characters, which never moves	*
+*	Fields:															*
+*		> next		- Block allocated before this one				*
+*		> chars		- Characters of the block's strings				*
+*		> used		- Count of characters in use					*
+*		> size		- Count of characters available					*
+*																	*
+********************************************************************/
+
+typedef struct _StringBlock {
+	struct _StringBlock * next;
+	String chars;
+	int used;
+	int size;
+} StringBlock, * pStringBlock;
+
+/********************************************************************
+*																	*
+*							Aggregate: _StringPool					*
+*																	*
+*	Purpose:	Pool of interned strings, identified by ID			*
+*	Fields:															*
+*		> entries		- Array of strings, indexed by ID - 1		*
+*		> numStrings	- Count of strings interned					*
+*		> maxStrings	- Count of entries available				*
+*		> buckets		- First ID in each hash chain				*
+*		> blocks		- Most recently allocated block				*
+*		> numRequests	- Count of strings asked to be interned		*
+*		> requestBytes	- Bytes private copies of those strings		*
+*						  would have taken							*
+*																	*
+********************************************************************/
+
+typedef struct _StringPool {
+	pStringEntry entries;
+	int numStrings;
+	int maxStrings;
+	StringID buckets [STRING_BUCKETS];
+	pStringBlock blocks;
+	long numRequests;
+	long requestBytes;
+} StringPool, * pStringPool;
+
+/********************************************************************
+*																	*
+*							Aggregate: _StringPoolReport			*
+*																	*
+*	Purpose:	Memory use of the string pool						*
+*	Fields:															*
+*		> numStrings	- Count of distinct strings					*
+*		> numRequests	- Count of strings asked to be interned		*
+*		> requestBytes	- Bytes private copies would have taken		*
+*		> storedBytes	- Bytes of characters held by the pool		*
+*		> overheadBytes	- Bytes of entries, buckets, and unused		*
+*						  block space								*
+*		> savedBytes	- Bytes saved over private copies			*
+*																	*
+********************************************************************/
+
+typedef struct _StringPoolReport {
+	int numStrings;
+	long numRequests;
+	long requestBytes;
+	long storedBytes;
+	long overheadBytes;
+	long savedBytes;
+} StringPoolReport, * pStringPoolReport;
+
 /********************************************************************
 *																	*
 *							Aggregate: _RefCounts					*
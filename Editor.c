@@ -202,6 +202,7 @@ image:
 	strcpy (filename, objects.fileObj.filename);
 
 	ConsoleInit (&objects, ENABLE_PROCESSED_INPUT | ENABLE_MOUSE_INPUT, TRUE);
+	StartJournal (&objects.inputObj);
 	
 	objects.fileObj.fp = fp;
 	strcpy (objects.fileObj.filename, filename);
@@ -273,6 +274,10 @@ void MapEdit (Map * map, Objects * objects)
 	WORD curColor = (WORD) MAKEBYTE(foreColor, backColor);
 	char curChar = END;
 	PCHAR_INFO compression;
+	PathGraph paths;
+	COORD pathEnds [2];
+	COORD pathSteps [SCREEN_WIDTH * SCREEN_HEIGHT];
+	int numEnds = 0, pathLength = NOPATH;
 
 	ParentWindow CharactersAndColors, MapFlags, MapData, Compression;
 
@@ -289,6 +294,12 @@ void MapEdit (Map * map, Objects * objects)
 		// Return failure
 	}
 
+	if (!MakePathGraph (&paths, map))
+	{
+		NORET_MESSAGE("MapEdit failed","3");
+		// Return failure
+	}
+
 	for (i = 0; i < objects->fileObj.numIndices; i++)
 	{
 		index = (objects->fileObj.compression + i)->indexValue;
@@ -418,6 +429,14 @@ void MapEdit (Map * map, Objects * objects)
 
 			break;
 
+		case 'P':
+			pathEnds [numEnds & 1].X = map->xOffset + GetMouseXPos (&objects->inputObj);
+			pathEnds [numEnds & 1].Y = map->yOffset + GetMouseYPos (&objects->inputObj);
+
+			numEnds++;
+
+			break;
+
 		case VK_ESCAPE:
 			loop = FALSE;
 
@@ -444,6 +463,11 @@ void MapEdit (Map * map, Objects * objects)
 				//	SETFLAG(*(map->world.flags + index),curFlag);
 					SETFLAG(G_mapCell->flags,curFlag);
 
+					if (FLAGSET(curFlag,SOLID))
+					{
+						MarkPathCell (&paths, map->xOffset + mouseX, map->yOffset + mouseY);
+					}
+
 					break;
 
 				case 2:
@@ -487,6 +511,11 @@ void MapEdit (Map * map, Objects * objects)
 				//	CLEARFLAG(*(map->world.flags + index),curFlag);
 					CLEARFLAG(G_mapCell->flags,curFlag);
 
+					if (FLAGSET(curFlag,SOLID))
+					{
+						MarkPathCell (&paths, map->xOffset + mouseX, map->yOffset + mouseY);
+					}
+
 					break;
 
 				case 2:
@@ -542,6 +571,22 @@ void MapEdit (Map * map, Objects * objects)
 				break;
 		}
 
+		if (numEnds > 1)
+		{
+			pathLength = FindPath (&paths, pathEnds [0], pathEnds [1], pathSteps, SCREEN_WIDTH * SCREEN_HEIGHT);
+
+			for (i = 0; i < pathLength && i < SCREEN_WIDTH * SCREEN_HEIGHT; i++)
+			{
+				mouseX = pathSteps [i].X - map->xOffset;
+				mouseY = pathSteps [i].Y - map->yOffset;
+
+				if (mouseX >= 0 && mouseX < SCREEN_WIDTH && mouseY >= 0 && mouseY < SCREEN_HEIGHT)
+				{
+					(*(objects->outputObj.outputBuf.buffer + mouseY) + mouseX)->Char.AsciiChar = '*';
+				}
+			}
+		}
+
 		UpdateScreen (&objects->outputObj);
 	}
 
@@ -550,6 +595,8 @@ void MapEdit (Map * map, Objects * objects)
 	DeleteParentWindow (&MapData);
 	DeleteParentWindow (&Compression);
 
+	DestroyPathGraph (&paths);
+
 	FREE(compression);
 }
 
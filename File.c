@@ -18,6 +18,8 @@
 /*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
 
 #include "ADT.h"
+#include "Interface.h"
+#include "Resources.h"
 
 /*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
 /********************************************************************
@@ -37,6 +39,12 @@ static pAnimation G_endAnimation;
 // Used to quicken Animation loops
 static pPattern G_endPattern;
 // Used to quicken Pattern loops
+static pReceiverEntry G_endRecEntry;
+// Used to quicken ReceiverEntry loops
+static pKey G_endKey;
+// Used to quicken Key loops
+static pMenuItem G_endItem;
+// Used to quicken MenuItem loops
 static pPointSet G_endSet;
 // Used to quicken PointSet loops
 static pTriangle G_endTriangle;
@@ -51,6 +59,9 @@ static PCHAR_INFO G_cell;
 
 static pCell G_bufCell, G_end;
 
+static int (* G_menuCommands [MENU_COMMANDS]) (voidStar data, dataType type, long lParam) = { MoveToPreviousItem, MoveToNextItem, ToggleMenuItemLeft, ToggleMenuItemRight };
+// Commands a menu file binds to keys, by index
+
 /*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
 /********************************************************************
 *																	*
@@ -66,9 +77,9 @@ static void MakePrimary (File * fileObj, fileStar secondary)
 	fileObj->fp = secondary;
 }
 
-static void MakeSecondary (File * fileObj, fileStar secondary)
+static void MakeSecondary (File * fileObj, fileStar * secondary)
 {
-	secondary = fileObj->fp;
+	*secondary = fileObj->fp;
 
 	fileObj->fp = NULL;
 }
@@ -317,14 +328,22 @@ static void LoadTextSequence (File * fileObj, String string)
 
 static void LoadWindowData (File * fileObj, Window * window)
 {
-	fscanf (fileObj->fp, "%d\n", &window->data);
-	fscanf (fileObj->fp, "%d\n", &window->background);
+	int data, background, x, y;	// Fields narrower than the integers read
+
+	fscanf (fileObj->fp, "%d\n", &data);
+	fscanf (fileObj->fp, "%d\n", &background);
 	fscanf (fileObj->fp, "%d %d\n", &window->xOffset, &window->yOffset);
 	fscanf (fileObj->fp, "%d %d\n", &window->width, &window->height);
 	fscanf (fileObj->fp, "%d %d\n", &window->windowWidth, &window->windowHeight);
-	fscanf (fileObj->fp, "%d %d\n", &window->windowCoord.X, &window->windowCoord.Y);
+	fscanf (fileObj->fp, "%d %d\n", &x, &y);
 	fscanf (fileObj->fp, "%d\n", &window->state);
 	fscanf (fileObj->fp, "%d\n", &window->mode);
+
+	window->data = (WORD) data;
+	window->background = (BYTE) background;
+	window->windowCoord.X = (SHORT) x;
+	window->windowCoord.Y = (SHORT) y;
+	// Narrow the fields, so no read spills into its neighbors
 }
 
 /********************************************************************
@@ -333,10 +352,12 @@ static void LoadWindowData (File * fileObj, Window * window)
 
 static BOOL LoadSeparators (File * fileObj, ParentWindow * parentWindow)
 {
-	pSeparator separators = parentWindow->separators;
+	pSeparator separators;
 	pSeparatorEntry separatorEntry;
 
-	MALLOC(separators,Separator);
+	MALLOC(parentWindow->separators,Separator);
+
+	separators = parentWindow->separators;
 
 	if (!separators)
 	{
@@ -390,12 +411,14 @@ static BOOL LoadVisuals (File * fileObj, Window * window)
 {
 	char filename [WORD_LENGTH];
 	fileStar secondary = NULL;
-	pVisuals visuals = window->visuals;
+	pVisuals visuals;
 	pAnimation animation;
 	pImage image;
 	pPattern pattern;
 
-	MALLOC(visuals,Visuals);
+	MALLOC(window->visuals,Visuals);
+
+	visuals = window->visuals;
 
 	if (!visuals)
 	{
@@ -403,7 +426,17 @@ static BOOL LoadVisuals (File * fileObj, Window * window)
 		// Return failure
 	}
 
-	fscanf (fileObj->fp, "%d\n", visuals->numAnimations); 
+	fscanf (fileObj->fp, "%d\n", &visuals->numAnimations);
+
+	CALLOC(visuals->animations,visuals->numAnimations,Animation);
+
+	if (visuals->numAnimations && !visuals->animations)
+	{
+		visuals->numAnimations = 0;
+
+		ERROR_MESSAGE("LoadVisuals failed","5");
+		// Return failure
+	}
 
 	G_endAnimation = visuals->animations + visuals->numAnimations;
 
@@ -411,7 +444,7 @@ static BOOL LoadVisuals (File * fileObj, Window * window)
 	{
 		fscanf (fileObj->fp, "%s\n", filename);
 
-		MakeSecondary (fileObj, secondary);
+		MakeSecondary (fileObj, &secondary);
 
 		if (!ReloadAnimation (fileObj, animation, filename))
 		{
@@ -422,7 +455,17 @@ static BOOL LoadVisuals (File * fileObj, Window * window)
 		MakePrimary (fileObj, secondary);
 	}
 
-	fscanf (fileObj->fp, "%d\n", visuals->numImages); 
+	fscanf (fileObj->fp, "%d\n", &visuals->numImages);
+
+	CALLOC(visuals->images,visuals->numImages,Image);
+
+	if (visuals->numImages && !visuals->images)
+	{
+		visuals->numImages = 0;
+
+		ERROR_MESSAGE("LoadVisuals failed","6");
+		// Return failure
+	}
 
 	G_endImage = visuals->images + visuals->numImages;
 
@@ -430,7 +473,7 @@ static BOOL LoadVisuals (File * fileObj, Window * window)
 	{
 		fscanf (fileObj->fp, "%s\n", filename);
 
-		MakeSecondary (fileObj, secondary);
+		MakeSecondary (fileObj, &secondary);
 
 		if (!ReloadImage (fileObj, image, filename))
 		{
@@ -441,7 +484,17 @@ static BOOL LoadVisuals (File * fileObj, Window * window)
 		MakePrimary (fileObj, secondary);
 	}
 
-	fscanf (fileObj->fp, "%d\n", visuals->numPatterns); 
+	fscanf (fileObj->fp, "%d\n", &visuals->numPatterns);
+
+	CALLOC(visuals->patterns,visuals->numPatterns,Pattern);
+
+	if (visuals->numPatterns && !visuals->patterns)
+	{
+		visuals->numPatterns = 0;
+
+		ERROR_MESSAGE("LoadVisuals failed","7");
+		// Return failure
+	}
 
 	G_endPattern = visuals->patterns + visuals->numPatterns;
 
@@ -449,7 +502,7 @@ static BOOL LoadVisuals (File * fileObj, Window * window)
 	{
 		fscanf (fileObj->fp, "%s\n", filename);
 
-		MakeSecondary (fileObj, secondary);
+		MakeSecondary (fileObj, &secondary);
 
 		if (!ReloadPattern (fileObj, pattern, filename))
 		{
@@ -464,6 +517,48 @@ static BOOL LoadVisuals (File * fileObj, Window * window)
 	// Return success
 }
 
+/********************************************************************
+*	LoadReceivers - Load receivers into a window					*
+********************************************************************/
+
+static BOOL LoadReceivers (File * fileObj, Window * window)
+{
+	pReceivers receivers;
+	pReceiverEntry receiverEntry;
+
+	MALLOC(window->receivers,Receivers);
+
+	receivers = window->receivers;
+
+	if (!receivers)
+	{
+		ERROR_MESSAGE("LoadReceivers failed","1");
+		// Return failure
+	}
+
+	fscanf (fileObj->fp, "%d\n", &receivers->numReceivers);
+
+	CALLOC(receivers->receivers,receivers->numReceivers,ReceiverEntry);
+
+	if (receivers->numReceivers && !receivers->receivers)
+	{
+		receivers->numReceivers = 0;
+
+		ERROR_MESSAGE("LoadReceivers failed","2");
+		// Return failure
+	}
+
+	G_endRecEntry = receivers->receivers + receivers->numReceivers;
+
+	for (receiverEntry = receivers->receivers; receiverEntry < G_endRecEntry; receiverEntry++)
+	{
+		fscanf (fileObj->fp, "%d %d\n", &receiverEntry->windowID, &receiverEntry->instruction);
+	}
+
+	return TRUE;
+	// Return success
+}
+
 /********************************************************************
 *	LoadBasicWindow - Load basic window								*
 ********************************************************************/
@@ -493,9 +588,11 @@ static BOOL LoadBasicWindow (File * fileObj, Window * window)
 
 static BOOL LoadEditBoxWindow (File * fileObj, Window * window)
 {
-	pIO_Descriptor IO = window->IO;
+	pIO_Descriptor IO;
+
+	MALLOC(window->IO,IO_Descriptor);
 
-	MALLOC(IO,IO_Descriptor);
+	IO = window->IO;
 
 	if (!IO)
 	{
@@ -539,7 +636,7 @@ static BOOL LoadMenuWindow (File * fileObj, Window * window)
 
 	fscanf (fileObj->fp, "%s\n", filename);
 
-	MakeSecondary (fileObj, secondary);
+	MakeSecondary (fileObj, &secondary);
 
 	if (!ReloadMenu (fileObj, window->menu, filename))
 	{
@@ -559,9 +656,11 @@ static BOOL LoadMenuWindow (File * fileObj, Window * window)
 
 static BOOL LoadMessageBoxWindow (File * fileObj, Window * window)
 {
-	pIO_Descriptor IO = window->IO;
+	pIO_Descriptor IO;
 
-	MALLOC(IO,IO_Descriptor);
+	MALLOC(window->IO,IO_Descriptor);
+
+	IO = window->IO;
 
 	if (!IO)
 	{
@@ -573,20 +672,93 @@ static BOOL LoadMessageBoxWindow (File * fileObj, Window * window)
 	fscanf (fileObj->fp, "%d\n", &IO->writeMode);
 
 	fscanf (fileObj->fp, "%d %d\n", &IO->text.limit, &IO->text.numChars);
+	// Read the stored capacity; the pooled message below replaces it
 
-	CALLOC(IO->text.text,IO->text.numChars,char);
+	IO->text.source = InternString ("");
 
-	if (!IO->text.text)
+	if (!IO->text.source)
 	{
 		ERROR_MESSAGE("LoadMessageBoxWindow failed","2");
 		// Return failure
 	}
-	// Verify that window's IO field points to valid memory
+	// Start from an empty pooled message rather than a private copy
+
+	IO->text.text = GetString (IO->text.source);
+	IO->text.numChars = IO->text.limit = GetStringLength (IO->text.source) + 1;
+
+	return TRUE;
+	// Return success
+}
+
+/********************************************************************
+*	CreateWindowADT - Create the ADT a loaded window owns			*
+********************************************************************/
+
+static BOOL CreateWindowADT (Window * window)
+{
+	switch (window->dataADT.ADTSharing)	// Get the exclusive mode
+	{
+	case kSingleOwner:					// Single owner case
+		switch (window->dataADT.type)	// Get the ADT style
+		{
+		case kADTList:			// List case
+			window->dataADT.data.list = CreateList (kRing, kSharedPool);
+
+			break;	// Break out of switch statement
+
+		case kADTQueue:			// Queue case
+			window->dataADT.data.queue = CreateQueue (kSharedPool);
+
+			break;	// Break out of switch statement
+
+		case kADTStack:			// Stack case
+			window->dataADT.data.stack = CreateStack (kSharedPool);
+
+			break;	// Break out of switch statement
+
+		default:
+			ERROR_MESSAGE("Unsupported ADT style: CreateWindowADT failed","1");
+			// Return failure
+		}
+
+		if (!window->dataADT.data.data)
+		{
+			ERROR_MESSAGE("CreateWindowADT failed","2");
+			// Return failure
+		}
+		// Verify that window's ADT was created
+
+		break;	// Break out of switch statement
+
+	case kShared:						// Shared case
+		break;	// Break out of switch statement
+	}
 
 	return TRUE;
 	// Return success
 }
 
+/********************************************************************
+*	FindMenuCommand - Find the index of the command bound to a key	*
+********************************************************************/
+
+static int FindMenuCommand (Key const * key)
+{
+	int command;	// Loop variable
+
+	for (command = 0; command < MENU_COMMANDS; command++)
+	{
+		if (key->function == G_menuCommands [command])
+		{
+			return command;
+			// Return the command's index
+		}
+	}
+
+	return -1;
+	// Return failure
+}
+
 /*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
 /********************************************************************
 *																	*
@@ -873,7 +1045,7 @@ BOOL ReloadPattern (File * fileObj, Pattern * pattern, String filename)
 BOOL ReloadParentWindow (File * fileObj, ParentWindow * parentWindow, String filename)
 {
 	int dimensions;
-	BOOL usingSeparators, usingADT;
+	BOOL usingSeparators, usingADT, usingReceivers;
 	pWindow window;
 
 	assert (fileObj && parentWindow && filename);
@@ -914,6 +1086,9 @@ BOOL ReloadParentWindow (File * fileObj, ParentWindow * parentWindow, String fil
 	}
 	// Verify that parentWindow's backData field points to valid memory
 
+	FREE(parentWindow->chrome);
+	// Chrome is recomposed from the new backData on the next redraw
+
 	fscanf (fileObj->fp, "%c %c\n", &parentWindow->background, &parentWindow->border);
 
 	fscanf (fileObj->fp, "%d\n", &usingSeparators);
@@ -951,35 +1126,10 @@ BOOL ReloadParentWindow (File * fileObj, ParentWindow * parentWindow, String fil
 		{
 			fscanf (fileObj->fp, "%d %d", &window->dataADT.ADTSharing, &window->dataADT.type);
 
-			switch (window->dataADT.ADTSharing)
+			if (!CreateWindowADT (window))
 			{
-			case kSingleOwner:
-				switch (window->dataADT.type)
-				{
-				case kList:
-					window->dataADT.data.list = CreateList (kRing);
-
-					break;	// Break out of switch statement
-
-				case kQueue:
-					window->dataADT.data.queue = CreateQueue ();
-
-					break;	// Break out of switch statement
-
-				case kStack:
-					window->dataADT.data.stack = CreateStack ();
-
-					break;	// Break out of switch statement
-
-				default:
-					ERROR_MESSAGE("Unsupported ADT style: ReloadParentWindow failed","5");
-					// Return failure
-				}
-
-				break;	// Break out of switch statement
-
-			case kShared:
-				break;	// Break out of switch statement
+				ERROR_MESSAGE("ReloadParentWindow failed","5");
+				// Return failure
 			}
 		}
 
@@ -1057,168 +1207,466 @@ BOOL ReloadParentWindow (File * fileObj, ParentWindow * parentWindow, String fil
 			ERROR_MESSAGE("Unsupported mode: ReloadParentWindow failed","11");
 			// Return failure
 		}
-	}
 
-	fscanf (fileObj->fp, "%d\n", &parentWindow->state);
+		fscanf (fileObj->fp, "%d\n", &usingReceivers);
 
-	return TRUE;
-	// Return success
-}
+		if (usingReceivers)
+		{
+			if (!LoadReceivers (fileObj, window))
+			{
+				ERROR_MESSAGE("ReloadParentWindow failed","12");
+				// Return failure
+			}
+		}
+	}
 
-/********************************************************************
-*	ReloadMenu - Load a menu from a file to memory					*
-********************************************************************/
+	fscanf (fileObj->fp, "%d\n", &parentWindow->state);
 
-BOOL ReloadMenu (File * fileObj, Menu * menu, String filename)
-{
 	return TRUE;
 	// Return success
 }
 
 /********************************************************************
-*	ReloadMap - Load a map from a file to memory					*
+*	ReloadParentWindowBlob - Load a compiled parent window with a	*
+*		single read into a single allocation						*
 ********************************************************************/
 
-BOOL ReloadMap (File * fileObj, Map * map, String filename)
+BOOL ReloadParentWindowBlob (File * fileObj, ParentWindow * parentWindow, String filename)
 {
-	int dimensions;	// Area of map
+	BlobHeader header;				// Leading record of the blob
+	PBYTE blob;						// Arena followed by its fixup table
+	LPDWORD fixup, endFixup;		// Fixup loop variables
+	pParentWindow root;				// Parent window leading the arena
+	pWindow window;					// Window loop variable
+	pKey key;						// Key loop variable
+	pMenuItem menuItem;				// Menu item loop variable
+	String * labels;				// Labels of a menu item, lying in the blob
+	longStar lParams;				// lParams of a menu item, lying in the blob
+	ULONG_PTR command;				// Index of the command bound to a key
+	int entry;						// Entry chosen in a menu item
+	DWORD extent;					// Size of the arena and fixup table
 
-	assert (fileObj && map && filename);
-	// Verify that fileObj, map, and filename point to valid memory
+	assert (fileObj && parentWindow && filename);
+	// Verify that fileObj, parentWindow, and filename point to valid memory
 
 	ReopenFile (fileObj, filename, kRead, kBinary);
-	// Open the desired map
+	// Open the desired blob
 
-	fscanf (fileObj->fp, "%d %d\n", &map->width, &map->height);
-	// Read map's width and height
+	if (!fileObj->fp || fread (&header, sizeof (BlobHeader), 1, fileObj->fp) != 1)
+	{
+		ERROR_MESSAGE("ReloadParentWindowBlob failed","1");
+		// Return failure
+	}
 
-	if (!map->width || !map->height)
+	if (header.tag != BLOB_TAG || header.pointerSize != sizeof (voidStar) || header.size < sizeof (ParentWindow))
 	{
-		ERROR_MESSAGE("ReloadMap failed","1");
+		ERROR_MESSAGE("Incompatible blob: ReloadParentWindowBlob failed","2");
 		// Return failure
 	}
-	// Verify that map's width and height are non-zero
+	// Verify that the blob was compiled for this build
 
-	fscanf (fileObj->fp, "%d %d\n", &map->xScroll, &map->yScroll);
-	// Read map's horizontal and vertical scroll values
+	extent = header.size + header.numFixups * sizeof (DWORD);	// Fixups trail the arena
 
-	dimensions = map->width * map->height;	// Calculate map's area
+	CALLOC(blob,extent,BYTE);
 
-	if (!AllocateBuffer (&map->world, dimensions))
+	if (!blob)
 	{
-		ERROR_MESSAGE("ReloadMap failed","2");
+		ERROR_MESSAGE("ReloadParentWindowBlob failed","3");
 		// Return failure
 	}
+	// Verify that blob points to valid memory
 
-	switch (map->world.bufSharing)
+	if (fread (blob, extent, 1, fileObj->fp) != 1)
 	{
-	case kSingleOwner:
-		Inflate (fileObj, &map->world, dimensions);
-		// Inflate map's visual data
-
-		break;	// Break out of switch statement
+		FREE(blob);
+		// Free memory pointed to by blob
 
-	case kShared:
-		break;	// Break out of switch statement
+		ERROR_MESSAGE("ReloadParentWindowBlob failed","4");
+		// Return failure
 	}
+	// Read the arena and its fixup table in one pass
 
-	return TRUE;
-}
+	fixup = (LPDWORD) (blob + header.size);
+	endFixup = fixup + header.numFixups;
 
-/*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
-/********************************************************************
-*																	*
-*							File Writing							*
-*																	*
-********************************************************************/
-/*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
+	for (; fixup < endFixup; fixup++)
+	{
+		if (*fixup > header.size - sizeof (voidStar))
+		{
+			FREE(blob);
+			// Free memory pointed to by blob
 
-/********************************************************************
-*	WriteConfigFile	- Primary wrapper for config file writing		*
-********************************************************************/
+			ERROR_MESSAGE("Corrupt blob: ReloadParentWindowBlob failed","5");
+			// Return failure
+		}
+		// Verify that the pointer lies within the arena
 
-/********************************************************************
-*	Compress - Used to compress data stored within an output buffer	*
-********************************************************************/
+		*(ULONG_PTR *) (blob + *fixup) += (ULONG_PTR) blob;
+		// Turn the stored arena offset into an address
+	}
 
-static void Compress (File * fileObj, OutputBuffer const * outputBuf, int dimensions)
-{
-	int i = 0;				// Loop variable
-	int index = 0;			// Index variable
-	int value;				// Index value
-	int compressMode, width;// Mode used to compress data; width of region
+	root = (pParentWindow) blob;	// Parent window leads the arena
+
+	parentWindow->bufferSharing = root->bufferSharing;
+	parentWindow->back = root->back;
+	parentWindow->delay = root->delay;
+	parentWindow->width = root->width;
+	parentWindow->height = root->height;
+	parentWindow->backData = root->backData;
+	parentWindow->background = root->background;
+	parentWindow->border = root->border;
+	parentWindow->separators = root->separators;
+	parentWindow->focusKey = root->focusKey;
+	parentWindow->closeKey = root->closeKey;
+	parentWindow->confirmKey = root->confirmKey;
+	parentWindow->numWindows = root->numWindows;
+	parentWindow->windows = root->windows;
+	parentWindow->state = root->state;
+	// Take the same fields ReloadParentWindow reads from text
+
+	parentWindow->blob = blob;	// parentWindow now owns the blob
+	parentWindow->blobSize = header.size;
+
+	FREE(parentWindow->chrome);
+	// Chrome is recomposed from the new backData on the next redraw
 
-	fprintf (fileObj->fp, "%d\n", fileObj->numIndices);
-	// Write the count of compression indices
+	G_endWindow = parentWindow->windows + parentWindow->numWindows;
 
-	while (i < fileObj->numIndices)
+	for (window = parentWindow->windows; window < G_endWindow; window++)
 	{
-		value = (fileObj->compression + i)->indexValue;	// Retrieve index value from compression table
-		compressMode = (fileObj->compression + i)->mode;// Retrieve compress mode from compression table
-
-		if (++i < fileObj->numIndices)
+		if (!CreateWindowADT (window))
 		{
-			width = (fileObj->compression + i)->indexValue - value;
-			// Calculate width of normal region in compression table
+			ERROR_MESSAGE("ReloadParentWindowBlob failed","6");
+			// Return failure
 		}
+		// ADTs grow at run time, so they live outside the blob
 
-		else
+		if (window->mode == kMessageBox && window->IO)	// Check whether window shows a message
 		{
-			width = dimensions - value;
-			// Calculate width of final entry in compression table
+			window->IO->text.source = InternString (window->IO->text.text);
+
+			if (!window->IO->text.source)
+			{
+				ERROR_MESSAGE("ReloadParentWindowBlob failed","7");
+				// Return failure
+			}
+			// Pool the message, so loading another never frees text lying in the blob
+
+			window->IO->text.text = GetString (window->IO->text.source);
+			window->IO->text.numChars = window->IO->text.limit = GetStringLength (window->IO->text.source) + 1;
 		}
 
-		fprintf (fileObj->fp, "\n\n%d %d\n", compressMode, width);
-		// Write compressMode and width at given index
+		if (!window->menu)	// Ensure that window's menu field points to something
+		{
+			continue;	// Go to the next window
+		}
 
-		switch (compressMode)	// Get the compression mode
+		for (key = window->menu->keys, G_endKey = key + window->menu->numKeys; key < G_endKey; key++)
 		{
-		case kMerge:			// Merge case
-			WriteMerge (fileObj, outputBuf, &index, width);
-			// Write merged data at given index
+			command = *(ULONG_PTR *) ((PBYTE) key + offsetof (Key, function));
 
-			break;	// Break out of switch statement
+			if (command >= MENU_COMMANDS)
+			{
+				ERROR_MESSAGE("Corrupt blob: ReloadParentWindowBlob failed","8");
+				// Return failure
+			}
 
-		case kCompressZeroes:	// CompressZeroes case
-			WriteCompressZeroes (fileObj, outputBuf, &index, width);
-			// Write compressed-zero data at given index
+			key->function = G_menuCommands [command];
+			// Bind the command stored in place of the function
+		}
 
-			break;	// Break out of switch statement
+		G_endItem = window->menu->menu + window->menu->numItems;
 
-		case kNotZero:			// NotZero case
-			WriteNotZero (fileObj, outputBuf, &index, width);
-			// Write non-zero data at given index
+		for (menuItem = window->menu->menu; menuItem < G_endItem; menuItem++)
+		{
+			if (!menuItem->text)	// Ensure that menuItem has entries
+			{
+				continue;	// Go to the next item
+			}
 
-			break;	// Break out of switch statement
+			labels = (String *) menuItem->text;
+			lParams = menuItem->lParams;
+			entry = menuItem->entry;
 
-		case kConstantValue:	// ConstantValue case
-			WriteConstantValue (fileObj, outputBuf, &index, width);
-			// Write constant data at given index
+			menuItem->text = NULL;
+			menuItem->lParams = NULL;
+			// The labels and lParams lie in the blob, so keep LoadMenuItems from freeing them
 
-			break;	// Break out of switch statement
+			if (!LoadMenuItems (menuItem, labels, menuItem->numItems))
+			{
+				ERROR_MESSAGE("ReloadParentWindowBlob failed","9");
+				// Return failure
+			}
+			// Pool the labels, so menus loaded either way share their strings
 
-		default:
-			NORET_MESSAGE("Unsupported compressMode: Compress failed","1");
-			// Return failure
+			if (lParams)	// Ensure that lParams points to something
+			{
+				memcpy (menuItem->lParams, lParams, menuItem->numItems * sizeof (long));
+			}
+
+			menuItem->entry = entry;
 		}
 	}
+
+	return TRUE;
+	// Return success
 }
 
 /********************************************************************
-*	WriteMerge - Output buffer cells are merged prior to writing	*
+*	ReloadMenu - Load a menu from a file to memory					*
 ********************************************************************/
 
-static void WriteMerge (File * fileObj, OutputBuffer const * outputBuf, intStar index, int width)
+BOOL ReloadMenu (File * fileObj, Menu * menu, String filename)
 {
-	int extent;	// Extent to write to
-	int format;	// Format for data written
+	char label [WORD_LENGTH];		// Label of a menu item entry
+	int x, y, highlight, command;	// Fields narrower than the integers read
+	int index;						// Loop variable
+	pKey key;
+	pMenuItem menuItem;
 
-	extent = (*index) + width;	// Compute the extent to write
+	assert (fileObj && menu && filename);
+	// Verify that fileObj, menu, and filename point to valid memory
 
-	for (*index; *index < extent; (*index)++)
-	{
-		format = MERGE(outputBuf,*index);
-		// Merge the data to be written
+	ReopenFile (fileObj, filename, kRead, kBinary);
+	// Open the desired menu
+
+	if (!fileObj->fp)
+	{
+		ERROR_MESSAGE("ReloadMenu failed","1");
+		// Return failure
+	}
+
+	fscanf (fileObj->fp, "%d\n", &menu->itemChosen);
+
+	fscanf (fileObj->fp, "%d\n", &menu->numKeys);
+
+	CALLOC(menu->keys,menu->numKeys,Key);
+
+	if (menu->numKeys && !menu->keys)
+	{
+		menu->numKeys = 0;
+
+		ERROR_MESSAGE("ReloadMenu failed","2");
+		// Return failure
+	}
+
+	G_endKey = menu->keys + menu->numKeys;
+
+	for (key = menu->keys; key < G_endKey; key++)
+	{
+		fscanf (fileObj->fp, "%d %d\n", &key->keycode, &command);
+
+		if (command < 0 || command >= MENU_COMMANDS)
+		{
+			ERROR_MESSAGE("Unknown command: ReloadMenu failed","3");
+			// Return failure
+		}
+
+		key->function = G_menuCommands [command];
+	}
+
+	fscanf (fileObj->fp, "%d\n", &menu->numItems);
+
+	CALLOC(menu->menu,menu->numItems,MenuItem);
+
+	if (menu->numItems && !menu->menu)
+	{
+		menu->numItems = 0;
+
+		ERROR_MESSAGE("ReloadMenu failed","4");
+		// Return failure
+	}
+
+	G_endItem = menu->menu + menu->numItems;
+
+	for (menuItem = menu->menu; menuItem < G_endItem; menuItem++)
+	{
+		fscanf (fileObj->fp, "%d %d %d %d %d %d\n", &x, &y, &menuItem->width, &menuItem->height, &highlight, &menuItem->numItems);
+
+		menuItem->location.X = (SHORT) x;
+		menuItem->location.Y = (SHORT) y;
+		menuItem->highlight = (BYTE) highlight;
+
+		CALLOC(menuItem->text,menuItem->numItems,StringID);
+		CALLOC(menuItem->lParams,menuItem->numItems,long);
+
+		if (menuItem->numItems && (!menuItem->text || !menuItem->lParams))
+		{
+			ERROR_MESSAGE("ReloadMenu failed","5");
+			// Return failure
+		}
+
+		for (index = 0; index < menuItem->numItems; index++)
+		{
+			fscanf (fileObj->fp, "%ld ", menuItem->lParams + index);
+
+			if (!fgets (label, WORD_LENGTH, fileObj->fp))
+			{
+				ERROR_MESSAGE("ReloadMenu failed","6");
+				// Return failure
+			}
+
+			label [strcspn (label, "\r\n")] = '\0';	// Strip the line ending
+
+			menuItem->text [index] = InternString (label);
+
+			if (!menuItem->text [index])
+			{
+				ERROR_MESSAGE("ReloadMenu failed","7");
+				// Return failure
+			}
+			// Labels shared between menus are stored once
+		}
+	}
+
+	return TRUE;
+	// Return success
+}
+
+/********************************************************************
+*	ReloadMap - Load a map from a file to memory					*
+********************************************************************/
+
+BOOL ReloadMap (File * fileObj, Map * map, String filename)
+{
+	int dimensions;	// Area of map
+
+	assert (fileObj && map && filename);
+	// Verify that fileObj, map, and filename point to valid memory
+
+	ReopenFile (fileObj, filename, kRead, kBinary);
+	// Open the desired map
+
+	fscanf (fileObj->fp, "%d %d\n", &map->width, &map->height);
+	// Read map's width and height
+
+	if (!map->width || !map->height)
+	{
+		ERROR_MESSAGE("ReloadMap failed","1");
+		// Return failure
+	}
+	// Verify that map's width and height are non-zero
+
+	fscanf (fileObj->fp, "%d %d\n", &map->xScroll, &map->yScroll);
+	// Read map's horizontal and vertical scroll values
+
+	dimensions = map->width * map->height;	// Calculate map's area
+
+	if (!AllocateBuffer (&map->world, dimensions))
+	{
+		ERROR_MESSAGE("ReloadMap failed","2");
+		// Return failure
+	}
+
+	switch (map->world.bufSharing)
+	{
+	case kSingleOwner:
+		Inflate (fileObj, &map->world, dimensions);
+		// Inflate map's visual data
+
+		break;	// Break out of switch statement
+
+	case kShared:
+		break;	// Break out of switch statement
+	}
+
+	return TRUE;
+}
+
+/*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
+/********************************************************************
+*																	*
+*							File Writing							*
+*																	*
+********************************************************************/
+/*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
+
+/********************************************************************
+*	WriteConfigFile	- Primary wrapper for config file writing		*
+********************************************************************/
+
+/********************************************************************
+*	Compress - Used to compress data stored within an output buffer	*
+********************************************************************/
+
+static void Compress (File * fileObj, OutputBuffer const * outputBuf, int dimensions)
+{
+	int i = 0;				// Loop variable
+	int index = 0;			// Index variable
+	int value;				// Index value
+	int compressMode, width;// Mode used to compress data; width of region
+
+	fprintf (fileObj->fp, "%d\n", fileObj->numIndices);
+	// Write the count of compression indices
+
+	while (i < fileObj->numIndices)
+	{
+		value = (fileObj->compression + i)->indexValue;	// Retrieve index value from compression table
+		compressMode = (fileObj->compression + i)->mode;// Retrieve compress mode from compression table
+
+		if (++i < fileObj->numIndices)
+		{
+			width = (fileObj->compression + i)->indexValue - value;
+			// Calculate width of normal region in compression table
+		}
+
+		else
+		{
+			width = dimensions - value;
+			// Calculate width of final entry in compression table
+		}
+
+		fprintf (fileObj->fp, "\n\n%d %d\n", compressMode, width);
+		// Write compressMode and width at given index
+
+		switch (compressMode)	// Get the compression mode
+		{
+		case kMerge:			// Merge case
+			WriteMerge (fileObj, outputBuf, &index, width);
+			// Write merged data at given index
+
+			break;	// Break out of switch statement
+
+		case kCompressZeroes:	// CompressZeroes case
+			WriteCompressZeroes (fileObj, outputBuf, &index, width);
+			// Write compressed-zero data at given index
+
+			break;	// Break out of switch statement
+
+		case kNotZero:			// NotZero case
+			WriteNotZero (fileObj, outputBuf, &index, width);
+			// Write non-zero data at given index
+
+			break;	// Break out of switch statement
+
+		case kConstantValue:	// ConstantValue case
+			WriteConstantValue (fileObj, outputBuf, &index, width);
+			// Write constant data at given index
+
+			break;	// Break out of switch statement
+
+		default:
+			NORET_MESSAGE("Unsupported compressMode: Compress failed","1");
+			// Return failure
+		}
+	}
+}
+
+/********************************************************************
+*	WriteMerge - Output buffer cells are merged prior to writing	*
+********************************************************************/
+
+static void WriteMerge (File * fileObj, OutputBuffer const * outputBuf, intStar index, int width)
+{
+	int extent;	// Extent to write to
+	int format;	// Format for data written
+
+	extent = (*index) + width;	// Compute the extent to write
+
+	for (*index; *index < extent; (*index)++)
+	{
+		format = MERGE(outputBuf,*index);
+		// Merge the data to be written
 
 		fprintf (fileObj->fp, "%d ", format);
 		// Write formatted data
@@ -1410,6 +1858,514 @@ BOOL WriteMap (File * fileObj, Map const * map)
 	// Return success
 }
 
+/********************************************************************
+*	PlaceBlob - Reserve and fill a part of a blob's arena			*
+********************************************************************/
+
+static DWORD PlaceBlob (BlobWriter * writer, void const * source, DWORD size)
+{
+	DWORD offset = writer->size;	// Part begins at the end of the arena
+
+	if (writer->arena && source)	// Ensure that the arena is being written
+	{
+		memcpy (writer->arena + offset, source, size);
+		// Copy the part into the arena
+	}
+
+	writer->size += ALIGNBLOB(size);	// Keep the next part aligned
+
+	return offset;
+	// Return the part's offset
+}
+
+/********************************************************************
+*	FixBlob - Point a field of a blob at another part of the arena	*
+********************************************************************/
+
+static void FixBlob (BlobWriter * writer, DWORD field, DWORD target)
+{
+	if (writer->arena)	// Ensure that the arena is being written
+	{
+		*(ULONG_PTR *) (writer->arena + field) = target;
+		// Store the target as an offset, to be relocated on load
+
+		writer->fixups [writer->numFixups] = field;	// Record the field for relocation
+	}
+
+	writer->numFixups++;	// Count the fixup
+}
+
+/********************************************************************
+*	ClearBlob - Nullify a pointer field the blob does not carry		*
+********************************************************************/
+
+static void ClearBlob (BlobWriter * writer, DWORD field)
+{
+	if (writer->arena)	// Ensure that the arena is being written
+	{
+		*(ULONG_PTR *) (writer->arena + field) = 0;
+		// Drop the pointer copied from the source
+	}
+}
+
+/********************************************************************
+*	LayoutOutputBlob - Lay an output buffer's cells out within a	*
+*		blob's arena												*
+********************************************************************/
+
+static void LayoutOutputBlob (BlobWriter * writer, DWORD field, OutputBuffer const * outputBuf, int dimensions)
+{
+	if (outputBuf->buffer && outputBuf->bufSharing == kSingleOwner)
+	{
+		FixBlob (writer, field + offsetof (OutputBuffer, buffer), PlaceBlob (writer, outputBuf->buffer, dimensions * sizeof (Cell)));
+
+		if (writer->arena)	// Ensure that the arena is being written
+		{
+			((pOutputBuffer) (writer->arena + field))->bufSharing = kShared;
+			// The cells lie in the blob, so they are never freed on their own
+		}
+	}
+
+	else
+	{
+		ClearBlob (writer, field + offsetof (OutputBuffer, buffer));
+	}
+}
+
+/********************************************************************
+*	LayoutImagesBlob - Lay an array of images out within a blob's	*
+*		arena														*
+********************************************************************/
+
+static void LayoutImagesBlob (BlobWriter * writer, DWORD field, Image const * images, int numImages)
+{
+	int index;		// Loop variable
+	DWORD array;	// Offset of the image array
+
+	if (!images || !numImages)	// Ensure that there are images to lay out
+	{
+		ClearBlob (writer, field);
+
+		return;	// Return if there are none
+	}
+
+	array = PlaceBlob (writer, images, numImages * sizeof (Image));
+
+	FixBlob (writer, field, array);
+
+	for (index = 0; index < numImages; index++)
+	{
+		LayoutOutputBlob (writer, array + index * sizeof (Image) + offsetof (Image, image), &images [index].image, images [index].width * images [index].height);
+	}
+}
+
+/********************************************************************
+*	LayoutVisualsBlob - Lay visuals out within a blob's arena		*
+********************************************************************/
+
+static void LayoutVisualsBlob (BlobWriter * writer, DWORD field, Visuals const * visuals)
+{
+	int index, state;						// Loop variables
+	DWORD base, array, animation, states;	// Offsets of the visuals, an array, an animation, and its states
+	Animation const * source;				// Animation being laid out
+
+	base = PlaceBlob (writer, visuals, sizeof (Visuals));
+
+	FixBlob (writer, field, base);
+
+	LayoutImagesBlob (writer, base + offsetof (Visuals, images), visuals->images, visuals->numImages);
+
+	if (visuals->patterns && visuals->numPatterns)	// Ensure that there are patterns to lay out
+	{
+		array = PlaceBlob (writer, visuals->patterns, visuals->numPatterns * sizeof (Pattern));
+
+		FixBlob (writer, base + offsetof (Visuals, patterns), array);
+
+		for (index = 0; index < visuals->numPatterns; index++)
+		{
+			LayoutOutputBlob (writer, array + index * sizeof (Pattern) + offsetof (Pattern, pattern), &visuals->patterns [index].pattern, visuals->patterns [index].width * visuals->patterns [index].height);
+		}
+	}
+
+	else
+	{
+		ClearBlob (writer, base + offsetof (Visuals, patterns));
+	}
+
+	if (!visuals->animations || !visuals->numAnimations)	// Ensure that there are animations to lay out
+	{
+		ClearBlob (writer, base + offsetof (Visuals, animations));
+
+		return;	// Return if there are none
+	}
+
+	array = PlaceBlob (writer, visuals->animations, visuals->numAnimations * sizeof (Animation));
+
+	FixBlob (writer, base + offsetof (Visuals, animations), array);
+
+	for (index = 0; index < visuals->numAnimations; index++)
+	{
+		source = visuals->animations + index;					// Get the animation to lay out
+		animation = array + index * sizeof (Animation);	// Get its offset in the arena
+
+		ClearBlob (writer, animation + offsetof (Animation, activeImage));
+		// The active frame is picked at run time
+
+		if (source->path.control && source->path.numControls)	// Ensure that the path has control points
+		{
+			FixBlob (writer, animation + offsetof (Animation, path) + offsetof (Curve2, control), PlaceBlob (writer, source->path.control, source->path.numControls * sizeof (Point2)));
+		}
+
+		else
+		{
+			ClearBlob (writer, animation + offsetof (Animation, path) + offsetof (Curve2, control));
+		}
+
+		if (source->states && source->numStates)	// Ensure that the animation has states
+		{
+			states = PlaceBlob (writer, source->states, source->numStates * sizeof (AnimationState));
+
+			FixBlob (writer, animation + offsetof (Animation, states), states);
+
+			for (state = 0; state < source->numStates; state++)
+			{
+				LayoutImagesBlob (writer, states + state * sizeof (AnimationState) + offsetof (AnimationState, frames), source->states [state].frames, source->states [state].numFrames);
+			}
+		}
+
+		else
+		{
+			ClearBlob (writer, animation + offsetof (Animation, states));
+		}
+	}
+}
+
+/********************************************************************
+*	LayoutMenuBlob - Lay a menu out within a blob's arena			*
+********************************************************************/
+
+static void LayoutMenuBlob (BlobWriter * writer, DWORD field, Menu const * menu)
+{
+	int index, entry;					// Loop variables
+	DWORD base, array, item, labels;	// Offsets of the menu, an array, an item, and its labels
+	MenuItem const * source;			// Menu item being laid out
+
+	base = PlaceBlob (writer, menu, sizeof (Menu));
+
+	FixBlob (writer, field, base);
+
+	ClearBlob (writer, base + offsetof (Menu, table));
+	// The dispatch table is compiled at run time
+
+	if (menu->keys && menu->numKeys)	// Ensure that the menu has keys
+	{
+		array = PlaceBlob (writer, menu->keys, menu->numKeys * sizeof (Key));
+
+		FixBlob (writer, base + offsetof (Menu, keys), array);
+
+		for (index = 0; writer->arena && index < menu->numKeys; index++)
+		{
+			*(ULONG_PTR *) (writer->arena + array + index * sizeof (Key) + offsetof (Key, function)) = FindMenuCommand (menu->keys + index);
+			// Store the command's index, to be bound on load
+		}
+	}
+
+	else
+	{
+		ClearBlob (writer, base + offsetof (Menu, keys));
+	}
+
+	if (!menu->menu || !menu->numItems)	// Ensure that the menu has items
+	{
+		ClearBlob (writer, base + offsetof (Menu, menu));
+
+		return;	// Return if there are none
+	}
+
+	array = PlaceBlob (writer, menu->menu, menu->numItems * sizeof (MenuItem));
+
+	FixBlob (writer, base + offsetof (Menu, menu), array);
+
+	for (index = 0; index < menu->numItems; index++)
+	{
+		source = menu->menu + index;					// Get the menu item to lay out
+		item = array + index * sizeof (MenuItem);	// Get its offset in the arena
+
+		if (!source->text || !source->numItems)	// Ensure that the item has entries
+		{
+			ClearBlob (writer, item + offsetof (MenuItem, text));
+			ClearBlob (writer, item + offsetof (MenuItem, lParams));
+
+			continue;	// Go to the next item
+		}
+
+		labels = PlaceBlob (writer, NULL, source->numItems * sizeof (String));
+
+		FixBlob (writer, item + offsetof (MenuItem, text), labels);
+
+		for (entry = 0; entry < source->numItems; entry++)
+		{
+			FixBlob (writer, labels + entry * sizeof (String), PlaceBlob (writer, GetString (source->text [entry]), GetStringLength (source->text [entry]) + 1));
+		}
+		// Labels are carried as text, and pooled again on load
+
+		if (source->lParams)	// Ensure that source's lParams field points to something
+		{
+			FixBlob (writer, item + offsetof (MenuItem, lParams), PlaceBlob (writer, source->lParams, source->numItems * sizeof (long)));
+		}
+
+		else
+		{
+			ClearBlob (writer, item + offsetof (MenuItem, lParams));
+		}
+	}
+}
+
+/********************************************************************
+*	LayoutBlob - Lay a parent window out within a blob's arena		*
+********************************************************************/
+
+static void LayoutBlob (BlobWriter * writer, ParentWindow const * parentWindow)
+{
+	int index;					// Loop variable
+	DWORD base, separators;		// Offsets of the parent window and its separators
+	DWORD windows, window, IO;	// Offsets of the window array, a window, and its IO
+	DWORD receivers;			// Offset of a window's receivers
+	pWindow source;				// Window being laid out
+
+	base = PlaceBlob (writer, parentWindow, sizeof (ParentWindow));
+	// Parent window leads the arena
+
+	if (parentWindow->back && parentWindow->bufferSharing == kSingleOwner)
+	{
+		FixBlob (writer, base + offsetof (ParentWindow, back), PlaceBlob (writer, NULL, sizeof (ScreenBuffer)));
+		// Reserve an empty surface, as ReloadParentWindow does
+	}
+
+	else
+	{
+		ClearBlob (writer, base + offsetof (ParentWindow, back));
+		// A shared surface is supplied by the caller
+	}
+
+	if (parentWindow->separators)	// Ensure that parentWindow's separators field points to something
+	{
+		separators = PlaceBlob (writer, parentWindow->separators, sizeof (Separator));
+
+		FixBlob (writer, base + offsetof (ParentWindow, separators), separators);
+		FixBlob (writer, separators + offsetof (Separator, horzSeparators), PlaceBlob (writer, parentWindow->separators->horzSeparators, parentWindow->separators->numHorzSeparators * sizeof (SeparatorEntry)));
+		FixBlob (writer, separators + offsetof (Separator, vertSeparators), PlaceBlob (writer, parentWindow->separators->vertSeparators, parentWindow->separators->numVertSeparators * sizeof (SeparatorEntry)));
+	}
+
+	else
+	{
+		ClearBlob (writer, base + offsetof (ParentWindow, separators));
+	}
+
+	FixBlob (writer, base + offsetof (ParentWindow, backData), PlaceBlob (writer, parentWindow->backData, parentWindow->width * parentWindow->height));
+
+	windows = PlaceBlob (writer, parentWindow->windows, parentWindow->numWindows * sizeof (Window));
+
+	FixBlob (writer, base + offsetof (ParentWindow, windows), windows);
+
+	ClearBlob (writer, base + offsetof (ParentWindow, hotKeys));
+	ClearBlob (writer, base + offsetof (ParentWindow, globalKeys));
+	ClearBlob (writer, base + offsetof (ParentWindow, chrome));
+	ClearBlob (writer, base + offsetof (ParentWindow, blob));
+	// Key tables and chrome are bound at run time
+
+	for (index = 0; index < parentWindow->numWindows; index++)
+	{
+		source = parentWindow->windows + index;				// Get the window to lay out
+		window = windows + index * sizeof (Window);	// Get its offset in the arena
+
+		LayoutOutputBlob (writer, window + offsetof (Window, display), &source->display, source->width * source->height);
+
+		if (source->IO)	// Ensure that source's IO field points to something
+		{
+			IO = PlaceBlob (writer, source->IO, sizeof (IO_Descriptor));
+
+			FixBlob (writer, window + offsetof (Window, IO), IO);
+
+			if (source->IO->text.text)	// Ensure that source's text points to something
+			{
+				FixBlob (writer, IO + offsetof (IO_Descriptor, text) + offsetof (TextBuffer, text), PlaceBlob (writer, source->IO->text.text, source->IO->text.numChars));
+			}
+
+			ClearBlob (writer, IO + offsetof (IO_Descriptor, layout));
+			ClearBlob (writer, IO + offsetof (IO_Descriptor, log));
+			// Layouts and log views are built at run time
+		}
+
+		else
+		{
+			ClearBlob (writer, window + offsetof (Window, IO));
+		}
+
+		if (source->menu)	// Ensure that source's menu field points to something
+		{
+			LayoutMenuBlob (writer, window + offsetof (Window, menu), source->menu);
+		}
+
+		else
+		{
+			ClearBlob (writer, window + offsetof (Window, menu));
+		}
+
+		if (source->receivers)	// Ensure that source's receivers field points to something
+		{
+			receivers = PlaceBlob (writer, source->receivers, sizeof (Receivers));
+
+			FixBlob (writer, window + offsetof (Window, receivers), receivers);
+
+			if (source->receivers->receivers && source->receivers->numReceivers)
+			{
+				FixBlob (writer, receivers + offsetof (Receivers, receivers), PlaceBlob (writer, source->receivers->receivers, source->receivers->numReceivers * sizeof (ReceiverEntry)));
+			}
+
+			else
+			{
+				ClearBlob (writer, receivers + offsetof (Receivers, receivers));
+			}
+		}
+
+		else
+		{
+			ClearBlob (writer, window + offsetof (Window, receivers));
+		}
+
+		if (source->visuals)	// Ensure that source's visuals field points to something
+		{
+			LayoutVisualsBlob (writer, window + offsetof (Window, visuals), source->visuals);
+		}
+
+		else
+		{
+			ClearBlob (writer, window + offsetof (Window, visuals));
+		}
+
+		ClearBlob (writer, window + offsetof (Window, view));
+		ClearBlob (writer, window + offsetof (Window, dataADT) + offsetof (ADT, data));
+		// The ADT is recreated on load
+
+		if (writer->arena && !source->dataADT.data.data)
+		{
+			((pWindow) (writer->arena + window))->dataADT.ADTSharing = kShared;
+			// Windows without an ADT of their own must not get one on load
+		}
+	}
+}
+
+/********************************************************************
+*	CompileParentWindow - Compile a parent window's text definition	*
+*		into a relocatable binary blob								*
+********************************************************************/
+
+BOOL CompileParentWindow (File * fileObj, String source, String target)
+{
+	ParentWindow parentWindow;	// Parent window loaded from text
+	BlobWriter writer;			// Writer laying out the blob
+	BlobHeader header;			// Leading record of the blob
+	pWindow window;				// Window loop variable
+	pKey key;					// Key loop variable
+	BOOL written;				// Indicates whether the blob was written
+
+	assert (fileObj && source && target);
+	// Verify that fileObj, source, and target point to valid memory
+
+	ZeroMemory (&parentWindow, sizeof (ParentWindow));
+	ZeroMemory (&writer, sizeof (BlobWriter));
+	// Zero memory out
+
+	if (!ReloadParentWindow (fileObj, &parentWindow, source))
+	{
+		DeleteParentWindow (&parentWindow);
+		// Remove whatever was loaded
+
+		ERROR_MESSAGE("CompileParentWindow failed","1");
+		// Return failure
+	}
+
+	G_endWindow = parentWindow.windows + parentWindow.numWindows;
+
+	for (window = parentWindow.windows; window < G_endWindow; window++)
+	{
+		if (!window->menu)	// Ensure that window's menu field points to something
+		{
+			continue;	// Go to the next window
+		}
+
+		for (key = window->menu->keys, G_endKey = key + window->menu->numKeys; key < G_endKey; key++)
+		{
+			if (FindMenuCommand (key) < 0)
+			{
+				DeleteParentWindow (&parentWindow);
+				// Remove the loaded parent window
+
+				ERROR_MESSAGE("Menu key has no command: CompileParentWindow failed","2");
+				// Return failure
+			}
+		}
+		// Verify that every menu key can be bound again on load
+	}
+
+	LayoutBlob (&writer, &parentWindow);
+	// Size the arena and count its pointers
+
+	header.tag = BLOB_TAG;
+	header.pointerSize = sizeof (voidStar);
+	header.size = writer.size;
+	header.numFixups = writer.numFixups;
+
+	CALLOC(writer.arena,header.size,BYTE);
+	CALLOC(writer.fixups,header.numFixups,DWORD);
+
+	if (!writer.arena || !writer.fixups)
+	{
+		FREE(writer.arena);
+		FREE(writer.fixups);
+		// Free whichever allocation succeeded
+
+		DeleteParentWindow (&parentWindow);
+		// Remove the loaded parent window
+
+		ERROR_MESSAGE("CompileParentWindow failed","3");
+		// Return failure
+	}
+	// Verify that writer's arena and fixups fields point to valid memory
+
+	writer.size = writer.numFixups = 0;	// Rewind the writer
+
+	LayoutBlob (&writer, &parentWindow);
+	// Write the arena and record its pointers
+
+	DeleteParentWindow (&parentWindow);
+	// Remove the loaded parent window
+
+	ReopenFile (fileObj, target, kWrite, kBinary);
+	// Open the target blob
+
+	written = fileObj->fp
+			  && fwrite (&header, sizeof (BlobHeader), 1, fileObj->fp) == 1
+			  && fwrite (writer.arena, header.size, 1, fileObj->fp) == 1
+			  && fwrite (writer.fixups, header.numFixups * sizeof (DWORD), 1, fileObj->fp) == 1
+			  && !fflush (fileObj->fp);
+	// Write the header, arena, and fixup table, and flush them out
+
+	FREE(writer.arena);
+	FREE(writer.fixups);
+	// Free memory pointed to by writer's arena and fixups fields
+
+	if (!written)
+	{
+		ERROR_MESSAGE("CompileParentWindow failed","4");
+		// Return failure
+	}
+
+	return TRUE;
+	// Return success
+}
+
 /*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
 /********************************************************************
 *																	*
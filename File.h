@@ -26,6 +26,15 @@
 #define INITIAL_VALUE			1
 // Used to set initial values in various contexts
 
+#define BLOB_TAG				0x32424955
+// Tag leading a compiled parent window file ("UIB2")
+
+#define BLOB_ALIGN				8
+// Alignment of each part placed in a compiled parent window
+
+#define MENU_COMMANDS			4
+// Count of commands a menu file can bind to keys
+
 /*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
 /********************************************************************
 *																	*
@@ -55,6 +64,12 @@
 								    		 MAKEWORD(((buf)->buffer + (index))->Char.AsciiChar,((buf)->buffer + (index))->Attributes))*/
 // Used to merge data
 
+#define ALIGNBLOB(size)			(((size) + BLOB_ALIGN - 1) & ~(BLOB_ALIGN - 1))
+// Used to round a part's size up to the blob alignment
+
+#define INBLOB(parent,address)	((parent)->blob && (PBYTE) (address) >= (parent)->blob && (PBYTE) (address) < (parent)->blob + (parent)->blobSize)
+// Used to test whether memory lies in a parent window's blob
+
 /*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
 /********************************************************************
 *																	*
@@ -65,7 +80,7 @@
 
 static void MakePrimary (pFile fileObj, fileStar secondary);
 
-static void MakeSecondary (pFile fileObj, fileStar secondary);
+static void MakeSecondary (pFile fileObj, fileStar * secondary);
 
 /*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
 /********************************************************************
@@ -131,6 +146,12 @@ static BOOL LoadSeparators (pFile fileObj, pParentWindow parentWindow);
 
 static BOOL LoadVisuals (pFile fileObj, pWindow window);
 
+/********************************************************************
+*	LoadReceivers - Load receivers into a window					*
+********************************************************************/
+
+static BOOL LoadReceivers (pFile fileObj, pWindow window);
+
 /********************************************************************
 *	LoadBasicWindow - Load basic window								*
 ********************************************************************/
@@ -155,6 +176,18 @@ static BOOL LoadMenuWindow (pFile fileObj, pWindow window);
 
 static BOOL LoadMessageBoxWindow (pFile fileObj, pWindow window);
 
+/********************************************************************
+*	CreateWindowADT - Create the ADT a loaded window owns			*
+********************************************************************/
+
+static BOOL CreateWindowADT (pWindow window);
+
+/********************************************************************
+*	FindMenuCommand - Find the index of the command bound to a key	*
+********************************************************************/
+
+static int FindMenuCommand (Key const * key);
+
 /*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
 /********************************************************************
 *																	*
@@ -227,6 +260,13 @@ BOOL ReloadPointSet (pFile fileObj, pPointSet pointSet, String filename);
 
 BOOL ReloadParentWindow (pFile fileObj, pParentWindow parentWindow, String filename);
 
+/********************************************************************
+*	ReloadParentWindowBlob - Load a compiled parent window with a	*
+*		single read into a single allocation						*
+********************************************************************/
+
+BOOL ReloadParentWindowBlob (pFile fileObj, pParentWindow parentWindow, String filename);
+
 /********************************************************************
 *	ReloadMenu - Load a menu from a file into memory				*
 ********************************************************************/
@@ -305,6 +345,63 @@ BOOL WritePointSet (pFile fileObj, PointSet const * pointSet);
 
 BOOL WriteMap (pFile fileObj, Map const * map);
 
+/********************************************************************
+*	PlaceBlob - Reserve and fill a part of a blob's arena			*
+********************************************************************/
+
+static DWORD PlaceBlob (pBlobWriter writer, void const * source, DWORD size);
+
+/********************************************************************
+*	FixBlob - Point a field of a blob at another part of the arena	*
+********************************************************************/
+
+static void FixBlob (pBlobWriter writer, DWORD field, DWORD target);
+
+/********************************************************************
+*	ClearBlob - Nullify a pointer field the blob does not carry		*
+********************************************************************/
+
+static void ClearBlob (pBlobWriter writer, DWORD field);
+
+/********************************************************************
+*	LayoutOutputBlob - Lay an output buffer's cells out within a	*
+*		blob's arena												*
+********************************************************************/
+
+static void LayoutOutputBlob (pBlobWriter writer, DWORD field, OutputBuffer const * outputBuf, int dimensions);
+
+/********************************************************************
+*	LayoutImagesBlob - Lay an array of images out within a blob's	*
+*		arena														*
+********************************************************************/
+
+static void LayoutImagesBlob (pBlobWriter writer, DWORD field, Image const * images, int numImages);
+
+/********************************************************************
+*	LayoutVisualsBlob - Lay visuals out within a blob's arena		*
+********************************************************************/
+
+static void LayoutVisualsBlob (pBlobWriter writer, DWORD field, Visuals const * visuals);
+
+/********************************************************************
+*	LayoutMenuBlob - Lay a menu out within a blob's arena			*
+********************************************************************/
+
+static void LayoutMenuBlob (pBlobWriter writer, DWORD field, Menu const * menu);
+
+/********************************************************************
+*	LayoutBlob - Lay a parent window out within a blob's arena		*
+********************************************************************/
+
+static void LayoutBlob (pBlobWriter writer, ParentWindow const * parentWindow);
+
+/********************************************************************
+*	CompileParentWindow - Compile a parent window's text definition	*
+*		into a relocatable binary blob								*
+********************************************************************/
+
+BOOL CompileParentWindow (pFile fileObj, String source, String target);
+
 /*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
 /********************************************************************
 *																	*
@@ -23,6 +23,12 @@
 #define fallDec		(float) 0.33
 #define moveInc		(float) 1.0
 #define jumpBonus	(float) 0.15
+#define holdBonus	(float) 0.05
+#define tickDelay	10
+#define moveDelay	30
+
+#define FNV_BASIS	2166136261UL
+#define FNV_PRIME	16777619UL
 
 typedef struct _Hero {
 	char displayChar;
@@ -33,6 +39,8 @@ typedef struct _Hero {
 	BOOL falling;
 	float jumpHeight;
 	float jumpMax;
+	BOOL hurt;
+	BOOL exited;
 } Hero, * pHero;
 
 typedef enum _direction {
@@ -40,6 +48,52 @@ typedef enum _direction {
 	kMoveRight
 } direction;
 
+typedef struct _ScriptStep {
+	int keycode;
+	int repeat;
+} ScriptStep, * pScriptStep;
+
+static ScriptStep G_script [] = {
+	{VK_RIGHT, 40}, {VK_SPACE, 1}, {VK_RIGHT, 25}, {0, 30},
+	{VK_LEFT, 15}, {VK_SPACE, 3}, {VK_LEFT, 20}, {0, 10},
+	{VK_RIGHT, 60}, {VK_SPACE, 1}, {0, 45}, {VK_TAB, 1}
+};
+
+#define NUM_SCRIPTSTEPS (sizeof (G_script) / sizeof (ScriptStep))
+
+void ResetHero (pHero hero, pMap map, pMap back)
+{
+	hero->globalX = hero->globalY  = hero->jumpHeight = 0.0;
+	hero->falling = hero->jumping = hero->hurt = FALSE;
+
+	map->xOffset = map->yOffset = 0;
+
+	back->xOffset = back->yOffset = 0;
+}
+
+int HeroRegionEvent (pRegionActor actor, pRegion region, RegionEvent event)
+{
+	pHero hero = (pHero) actor->data;
+
+	if (event == kRegionEnter)
+	{
+		switch (region->flag)
+		{
+		case DANGER:
+			hero->hurt = TRUE;
+
+			break;
+
+		case EXIT:
+			hero->exited = TRUE;
+
+			break;
+		}
+	}
+
+	return TRUE;
+}
+
 void MoveHero (pHero hero, pMap map, pMap back, direction dir)
 {
 	int width = map->width;
@@ -76,7 +130,7 @@ void MoveHero (pHero hero, pMap map, pMap back, direction dir)
 	}
 }
 
-void Jump (pHero hero, pMap map, pMap back)
+int Jump (pHero hero, pMap map, pMap back)
 {
 	int width = map->width;
 
@@ -84,6 +138,8 @@ void Jump (pHero hero, pMap map, pMap back)
 	{
 		hero->jumping = FALSE;
 		hero->jumpHeight = 0.0;
+
+		return 0;
 	}
 
 	else
@@ -104,11 +160,11 @@ void Jump (pHero hero, pMap map, pMap back)
 			ScrollMap (map, kHorzFix, kUp);
 		}
 
-		Sleep (10);
+		return tickDelay;
 	}	
 }
 
-void Fall (pHero hero, pMap map, pMap back)
+int Fall (pHero hero, pMap map, pMap back)
 {
 	int width = map->width;
 	int height = map->height;
@@ -116,7 +172,7 @@ void Fall (pHero hero, pMap map, pMap back)
 	if (FLAGSET(/**(map->world.flags*/(map->world.buffer + ((int) (hero->globalY + fallDec) * width + (int) hero->globalX))->flags,SOLID) || hero->jumping)
 	{
 		hero->falling = FALSE;
-		return;
+		return 0;
 	}
 
 	else
@@ -135,10 +191,103 @@ void Fall (pHero hero, pMap map, pMap back)
 			ScrollMap (map, kHorzFix, kDown);
 		}
 
-		Sleep (10);
+		return tickDelay;
 	}
 }
 
+int Tick (pHero hero, pMap map, pMap back, pRegionIndex regions, pRegionActor actor, InputSnapshot const * input)
+{
+	int delay = 0;
+
+	if (hero->jumping)
+	{
+		delay += Jump (hero, map, back);
+	}
+
+	delay += Fall (hero, map, back);
+
+	if (KeyIsHeld (input, VK_LEFT) != KeyIsHeld (input, VK_RIGHT))
+	{
+		MoveHero (hero, map, back, KeyIsHeld (input, VK_LEFT) ? kMoveLeft : kMoveRight);
+
+		if (delay < moveDelay)
+		{
+			delay = moveDelay;
+		}
+	}
+
+	if (!hero->falling)
+	{
+		if (KeyWasPressed (input, VK_SPACE))
+		{
+			if (!hero->jumping)
+			{
+				hero->jumping = TRUE;
+			}
+
+			else
+			{
+				hero->jumpMax += jumpBonus;
+			}
+		}
+
+		else if (hero->jumping && KeyIsHeld (input, VK_SPACE))
+		{
+			hero->jumpMax += holdBonus;
+		}
+	}
+
+	if (KeyWasPressed (input, VK_TAB))
+	{
+		ResetHero (hero, map, back);
+	}
+
+	actor->bounds.left = (int) hero->globalX;
+	actor->bounds.top = (int) hero->globalY;
+	actor->bounds.right = actor->bounds.left + 1;
+	actor->bounds.bottom = actor->bounds.top + 1;
+
+	UpdateRegionActors (regions, actor, 1);
+
+	if (hero->hurt)
+	{
+		ResetHero (hero, map, back);
+	}
+
+	return delay;
+}
+
+DWORD HashState (DWORD hash, pHero hero, pMap map)
+{
+	PBYTE bytes [4];
+	int sizes [4];
+	int i, j;
+
+	bytes [0] = (PBYTE) &hero->globalX, sizes [0] = sizeof (float) * 2;
+	bytes [1] = (PBYTE) &hero->jumping, sizes [1] = sizeof (BOOL) * 2;
+	bytes [2] = (PBYTE) &hero->jumpHeight, sizes [2] = sizeof (float) * 2;
+	bytes [3] = (PBYTE) &map->xOffset, sizes [3] = sizeof (int) * 2;
+
+	for (i = 0; i < 4; i++)
+	{
+		for (j = 0; j < sizes [i]; j++)
+		{
+			hash = (hash ^ *(bytes [i] + j)) * FNV_PRIME;
+		}
+	}
+
+	return hash;
+}
+
+void InitHero (pHero hero)
+{
+	ZeroMemory (hero, sizeof (Hero));
+
+	hero->displayChar = HERO;
+	hero->displayChar2 = HERO2;
+	hero->jumpMax = jumpAmount;
+}
+
 /********************************************************************
 *																	*
 *							Game Wrapper							*
@@ -149,18 +298,22 @@ void Game (void)
 {
 	Hero hero;
 	pMap map, back;
+	Sight sight;
+	COORD viewer;
+	RegionIndex regions;
+	RegionActor actor;
+	InputSnapshot input;
 	Objects objects;
 	int xIndex, yIndex, mapIndex;
+	int delay;
 	int loop = TRUE;
 
-	ZeroMemory (&hero, sizeof (Hero));
-	ZeroMemory (&objects, sizeof (Objects));
+	InitHero (&hero);
 
-	hero.displayChar = HERO;
-	hero.displayChar2 = HERO2;
-	hero.jumpMax = jumpAmount;
+	ZeroMemory (&objects, sizeof (Objects));
 
 	ConsoleInit (&objects, ENABLE_PROCESSED_INPUT, FALSE);
+	StartJournal (&objects.inputObj);
 
 	MALLOC(map,Map);
 	MALLOC(back,Map);
@@ -168,64 +321,54 @@ void Game (void)
 	ReloadMap (&objects.fileObj, map, "Map.map");
 	ReloadMap (&objects.fileObj, back, "Back.map");
 
-	while (loop)
-	{
-		if (hero.jumping)
-		{
-			Jump (&hero, map, back);
-		}
-
-		Fall (&hero, map, back);
+	ZeroMemory (&regions, sizeof (RegionIndex));
 
-		switch (GetInput (&objects.inputObj, kAsync))
-		{
-		case VK_LEFT:
-			MoveHero (&hero, map, back, kMoveLeft);
+	if (!MakeSight (&sight, map, SCREEN_WIDTH >> 1) || !MakeRegionIndex (&regions, map))
+	{
+		DestroySight (&sight);
+		DestroyRegionIndex (&regions);
 
-			break;
+		DeleteMap (map);
+		FREE(map);
 
-		case VK_RIGHT:
-			MoveHero (&hero, map, back, kMoveRight);
+		DeleteMap (back);
+		FREE(back);
 
-			break;
+		DeinitializeObjects (&objects);
 
-		case VK_SPACE:
-			if (!hero.falling)
-			{
-				if (!hero.jumping)
-				{
-					hero.jumping = TRUE;
-				}
-
-				else
-				{
-					hero.jumpMax += jumpBonus;
-				}
-			}
+		NORET_MESSAGE("Game failed","1");
+	}
+	// Drawing and region events need both tables
 
-			break;
+	SetRegionHandler (&regions, HeroRegionEvent);
 
+	ZeroMemory (&actor, sizeof (RegionActor));
 
-		case VK_TAB:
-			hero.globalX = hero.globalY  = hero.jumpHeight = 0.0;
-			hero.falling = hero.jumping = FALSE;
+	actor.data = &hero;
 
-			map->xOffset = map->yOffset = 0;
+	while (loop)
+	{
+		TakeInputSnapshot (&objects.inputObj, &input);
 
-			back->xOffset = back->yOffset = 0;
+		delay = Tick (&hero, map, back, &regions, &actor, &input);
 
-			break;
+		if (delay && !InputReplaying (&objects.inputObj))
+		{
+			Sleep (delay);
+		}
 
-		case VK_ESCAPE:
+		if (KeyWasPressed (&input, VK_ESCAPE) || hero.exited)
+		{
 			loop = FALSE;
-			break;
-		
-		default:
-			break;
 		}
 
+		viewer.X = (SHORT) hero.globalX;
+		viewer.Y = (SHORT) hero.globalY;
+
+		UpdateSight (&sight, viewer);
+
 		CopyMapToBuffer (&objects.outputObj.outputBuf, back);
-		CopyMapToBuffer (&objects.outputObj.outputBuf, map);
+		CopyVisibleMapToBuffer (&objects.outputObj.outputBuf, map, &sight);
 
 		yIndex = (int) (hero.globalY - map->yOffset);
 		xIndex = (int) (hero.globalX - map->xOffset);
@@ -243,6 +386,9 @@ void Game (void)
 		UpdateScreen (&objects.outputObj);
 	}
 
+	DestroySight (&sight);
+	DestroyRegionIndex (&regions);
+
 	DeleteMap (map);
 	FREE(map);
 
@@ -252,6 +398,120 @@ void Game (void)
 	DeinitializeObjects (&objects);
 }
 
+/********************************************************************
+*																	*
+*							Headless Simulation						*
+*																	*
+********************************************************************/
+
+void Simulate (long ticks, long hashInterval)
+{
+	Hero hero;
+	Map map, back;
+	File fileObj;
+	RegionIndex regions;
+	RegionActor actor;
+	InputSnapshot input;
+	DWORD hash = FNV_BASIS;
+	clock_t begin;
+	double elapsed;
+	long tick;
+	int step = 0, repeat = G_script [0].repeat, keycode = 0;
+
+	ZeroMemory (&map, sizeof (Map));
+	ZeroMemory (&back, sizeof (Map));
+
+	if (!InitializeFileObject (&fileObj))
+	{
+		return;
+	}
+
+	if (!ReloadMap (&fileObj, &map, "Map.map") || !ReloadMap (&fileObj, &back, "Back.map"))
+	{
+		DeinitializeFileObject (&fileObj);
+
+		NORET_MESSAGE("Simulate failed","1");
+	}
+
+	InitHero (&hero);
+
+	if (!MakeRegionIndex (&regions, &map))
+	{
+		DestroyRegionIndex (&regions);
+
+		DeleteMap (&map);
+		DeleteMap (&back);
+
+		DeinitializeFileObject (&fileObj);
+
+		NORET_MESSAGE("Simulate failed","2");
+	}
+	// Hashes would diverge silently without region events
+
+	SetRegionHandler (&regions, HeroRegionEvent);
+
+	ZeroMemory (&actor, sizeof (RegionActor));
+
+	actor.data = &hero;
+
+	if (hashInterval <= 0)
+	{
+		hashInterval = ticks;
+	}
+
+	begin = clock ();
+
+	for (tick = 1; tick <= ticks; tick++)
+	{
+		if (!repeat--)
+		{
+			step = (step + 1) % NUM_SCRIPTSTEPS;
+			repeat = G_script [step].repeat - 1;
+		}
+
+		ZeroMemory (&input, sizeof (InputSnapshot));
+
+		if (G_script [step].keycode)
+		{
+			SETKEYBIT(input.held,G_script [step].keycode);
+
+			if (G_script [step].keycode != keycode)
+			{
+				SETKEYBIT(input.pressed,G_script [step].keycode);
+			}
+		}
+
+		keycode = G_script [step].keycode;
+
+		Tick (&hero, &map, &back, &regions, &actor, &input);
+
+		if (hero.exited)
+		{
+			hero.exited = FALSE;
+
+			ResetHero (&hero, &map, &back);
+		}
+
+		hash = HashState (hash, &hero, &map);
+
+		if (!(tick % hashInterval))
+		{
+			printf ("tick %ld\thash %08lX\n", tick, hash);
+		}
+	}
+
+	elapsed = (double) (clock () - begin) / CLOCKS_PER_SEC;
+
+	printf ("%ld ticks in %.3f s: %.0f ticks/sec\n", ticks, elapsed, elapsed > 0.0 ? ticks / elapsed : 0.0);
+
+	DestroyRegionIndex (&regions);
+
+	DeleteMap (&map);
+	DeleteMap (&back);
+
+	DeinitializeFileObject (&fileObj);
+}
+
 /********************************************************************
 *																	*
 *							Loop									*
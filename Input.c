@@ -219,6 +219,68 @@ void SetInputMethod (Key * keyObj, int (* function) (voidStar data, dataType typ
 	// Assign the given method to the key structure
 }
 
+/********************************************************************
+*	MakeHotKeyTable - Compile keys into a dispatch table			*
+*	Input:	Array of keys, and count of keys						*
+*	Output:	Table, or NULL on failure								*
+********************************************************************/
+
+HotKeyTable * MakeHotKeyTable (Key * keys, int numKeys)
+{
+	pHotKeyTable table;	// Table to compile
+	int i;				// Loop variable
+
+	CALLOC(table,1,HotKeyTable);
+
+	if (!table)
+	{
+		NULL_MESSAGE("MakeHotKeyTable failed","1");
+		// Return failure
+	}
+
+	for (i = numKeys - 1; i >= 0; i--)
+	{
+		BindHotKey (table, (keys + i)->keycode, keys + i);
+		// Bind in reverse, so the first key for a keycode wins, as in a scan
+	}
+
+	return table;
+	// Return compiled table
+}
+
+/********************************************************************
+*	BindHotKey - Bind a key to a keycode in a dispatch table		*
+*	Input:	A dispatch table, a keycode, and key to bind			*
+*	Output:	Table entry is set										*
+********************************************************************/
+
+void BindHotKey (HotKeyTable * table, int keycode, Key * keyObj)
+{
+	assert (table);
+	// Verify that table points to valid memory
+
+	if (keycode > 0 && keycode < NUM_KEYCODES)	// Ensure that keycode fits the table
+	{
+		table->keys [keycode] = keyObj;
+		// Bind key, or unbind it if keyObj is NULL
+	}
+}
+
+/********************************************************************
+*	SetMouseCoalescing - Set whether runs of mouse moves collapse	*
+*	Input:	An input structure, and the coalescing status			*
+*	Output:	Input structure's coalesceMoves field is set			*
+********************************************************************/
+
+void SetMouseCoalescing (Input * inputObj, BOOL coalesce)
+{
+	assert (inputObj);
+	// Verify that inputObj points to valid memory
+
+	inputObj->coalesceMoves = coalesce;
+	// Assign coalescing status to the input structure
+}
+
 /*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
 /********************************************************************
 *																	*
@@ -269,7 +331,99 @@ int GetInput (Input * inputObj, InputStyle style)
 	assert (inputObj);
 	// Verify that inputObj points to valid memory
 
-	switch (style)	// Get input style
+	keyCode = ReadInput (inputObj, style);
+	// Get a single event
+
+	inputObj->frame++;	// Count the call
+
+	return keyCode;
+	// Return input received
+}
+
+/********************************************************************
+*	GetInputBatch - Retrieve every event since the last frame		*
+*	Input:	An input structure, array to receive records, and the	*
+*			array's capacity										*
+*	Output:	Count of records received								*
+********************************************************************/
+
+int GetInputBatch (Input * inputObj, INPUT_RECORD * records, int maxRecords)
+{
+	int numRecords = 0;	// Count of records received
+
+	assert (inputObj && records);
+	// Verify that inputObj and records point to valid memory
+
+	while (numRecords < maxRecords)
+	{
+		ReadInput (inputObj, kAsync);
+		// Get the next pending event
+
+		if (!inputObj->Count)
+		{
+			break;
+			// Stop once no events remain
+		}
+
+		*(records + numRecords++) = inputObj->inputRec;
+	}
+
+	inputObj->frame++;	// Count the call
+
+	return numRecords;
+	// Return count of records received
+}
+
+/********************************************************************
+*	WaitForInput - Block until input is available					*
+*	Input:	An input structure, and timeout in milliseconds			*
+*	Output:	Indicates that input may be available					*
+********************************************************************/
+
+BOOL WaitForInput (Input * inputObj, DWORD timeout)
+{
+	assert (inputObj);
+	// Verify that inputObj points to valid memory
+
+	if (inputObj->source == kReplay)
+	{
+		return TRUE;
+		// Journaled input never waits
+	}
+
+	if (inputObj->ring)	// Ensure that inputObj's ring field points to something
+	{
+		if (inputObj->ring->head != inputObj->ring->tail)
+		{
+			return TRUE;
+			// Return at once if events are queued
+		}
+
+		return WaitForSingleObject (inputObj->ring->ready, timeout) == WAIT_OBJECT_0;
+		// Wait for the input thread to push events; a stale signal only wakes early
+	}
+
+	return WaitForSingleObject (inputObj->inputH, timeout) == WAIT_OBJECT_0;
+	// Wait for the console to receive events
+}
+
+/********************************************************************
+*	ReadInput - Retrieve and process a single event					*
+*	Input:	An input structure, and the style of input to receive	*
+*	Output:	Return appropriate virtual-keycode to process			*
+********************************************************************/
+
+static int ReadInput (Input * inputObj, InputStyle style)
+{
+	int keyCode;	// Keycode to return as received input
+
+	if (inputObj->source == kReplay)
+	{
+		keyCode = GetInputReplay (inputObj, style);
+		// Get journaled input
+	}
+
+	else switch (style)	// Get input style
 	{
 	case kSync:		// Synchronous case
 		keyCode = GetInputSync (inputObj);	
@@ -290,6 +444,18 @@ int GetInput (Input * inputObj, InputStyle style)
 		break;	// Break out of switch statement
 	}
 
+	if (inputObj->coalesceMoves && inputObj->source != kReplay)
+	{
+		CoalesceMouseMoves (inputObj);
+		// Collapse a run of moves before it is journaled
+	}
+
+	if (inputObj->source == kRecord && inputObj->Count)
+	{
+		WriteJournalEntry (inputObj);
+		// Journal the event just consumed
+	}
+
 	inputObj->lastChar = keyCode ? inputObj->inputRec.Event.KeyEvent.uChar.AsciiChar : END;
 	// Store the last character received as input
 	inputObj->lastKeycode = keyCode;
@@ -298,6 +464,9 @@ int GetInput (Input * inputObj, InputStyle style)
 	UpdateMouse (inputObj);
 	// Update mouse information
 
+	UpdateKeys (inputObj);
+	// Update key information
+
 	return keyCode;
 	// Return input received
 }
@@ -310,21 +479,21 @@ int GetInput (Input * inputObj, InputStyle style)
 
 static int GetInputSync (Input * inputObj)
 {
-	if (!ReadConsoleInput (inputObj->inputH, &inputObj->inputRec, 1, &inputObj->Count))
+	if (inputObj->ring)	// Ensure that inputObj's ring field points to something
 	{
-		ERROR_MESSAGE("GetInputSync failed","1");
-		// Return failure
+		PopInput (inputObj, kSync);
+		// Wait on the input thread
 	}
-	// Read console input
 
-	if (inputObj->inputRec.EventType == KEY_EVENT && inputObj->inputRec.Event.KeyEvent.bKeyDown)
+	else if (!ReadConsoleInput (inputObj->inputH, &inputObj->inputRec, 1, &inputObj->Count))
 	{
-		return inputObj->inputRec.Event.KeyEvent.wVirtualKeyCode;
-		// Return keycode if conditions are met
+		ERROR_MESSAGE("GetInputSync failed","1");
+		// Return failure
 	}
+	// Read console input
 
-	return 0;
-	// Return null input otherwise
+	return GetRecordKeyCode (inputObj);
+	// Return keycode of input read
 }
 
 /********************************************************************
@@ -335,6 +504,12 @@ static int GetInputSync (Input * inputObj)
 
 static int GetInputAsync (Input * inputObj)
 {
+	if (inputObj->ring)	// Ensure that inputObj's ring field points to something
+	{
+		return PopInput (inputObj, kAsync) ? GetRecordKeyCode (inputObj) : 0;
+		// Return keycode of queued input, or null input if queue is empty
+	}
+
 	if (!PeekConsoleInput (inputObj->inputH, &inputObj->inputRec, 1, &inputObj->Count))
 	{
 		ERROR_MESSAGE("GetInputAsync failed","1");
@@ -373,6 +548,683 @@ static void UpdateMouse (Input * inputObj)
 	}
 }
 
+/********************************************************************
+*	GetRecordKeyCode - Get keycode of the current input record		*
+*	Input:	An input structure										*
+*	Output:	Virtual-keycode of a key press, or null input			*
+********************************************************************/
+
+static int GetRecordKeyCode (Input const * inputObj)
+{
+	if (inputObj->Count && inputObj->inputRec.EventType == KEY_EVENT && inputObj->inputRec.Event.KeyEvent.bKeyDown)
+	{
+		return inputObj->inputRec.Event.KeyEvent.wVirtualKeyCode;
+		// Return keycode if conditions are met
+	}
+
+	return 0;
+	// Return null input otherwise
+}
+
+/********************************************************************
+*	UpdateKeys - Updates held keys and key edges					*
+*	Input:	An input structure										*
+*	Output:	Key bitmaps are updated									*
+********************************************************************/
+
+static void UpdateKeys (Input * inputObj)
+{
+	int keycode, i;	// Keycode of event, and loop counter
+
+	if (!inputObj->Count)	// Ensure that an event was read
+	{
+		return;	// Return if no event was read
+	}
+
+	switch (inputObj->inputRec.EventType)	// Get event type
+	{
+	case KEY_EVENT:		// Key case
+		keycode = inputObj->inputRec.Event.KeyEvent.wVirtualKeyCode & (NUM_KEYCODES - 1);
+
+		if (inputObj->inputRec.Event.KeyEvent.bKeyDown)
+		{
+			if (!KEYBIT(inputObj->keysHeld,keycode))
+			{
+				SETKEYBIT(inputObj->keysHeld,keycode);
+				SETKEYBIT(inputObj->keysPressed,keycode);
+			}
+			// Auto-repeat does not count as a new press
+		}
+
+		else if (KEYBIT(inputObj->keysHeld,keycode))
+		{
+			CLEARKEYBIT(inputObj->keysHeld,keycode);
+			SETKEYBIT(inputObj->keysReleased,keycode);
+		}
+
+		break;	// Break out of switch statement
+
+	case FOCUS_EVENT:	// Focus case
+		if (!inputObj->inputRec.Event.FocusEvent.bSetFocus)
+		{
+			for (i = 0; i < KEYCODE_BYTES; i++)
+			{
+				inputObj->keysReleased [i] |= inputObj->keysHeld [i];
+				inputObj->keysHeld [i] = 0;
+			}
+			// Key releases are lost while unfocused, so release every key now
+		}
+
+		break;	// Break out of switch statement
+	}
+}
+
+/********************************************************************
+*	CoalesceMouseMoves - Skip to the last of consecutive moves		*
+*	Input:	An input structure										*
+*	Output:	Input record holds the latest position					*
+********************************************************************/
+
+static void CoalesceMouseMoves (Input * inputObj)
+{
+	pInputRing ring = inputObj->ring;	// Queue to look ahead in
+	INPUT_RECORD next;					// Record following the current one
+	DWORD buttonState, count;			// Buttons held during the run, and count of records peeked
+
+	if (!inputObj->Count || inputObj->inputRec.EventType != MOUSE_EVENT || inputObj->inputRec.Event.MouseEvent.dwEventFlags != MOUSE_MOVED)
+	{
+		return;	// Return if the record is not a move
+	}
+
+	buttonState = inputObj->inputRec.Event.MouseEvent.dwButtonState;
+
+	if (ring)	// Ensure that inputObj's ring field points to something
+	{
+		while (ring->head != ring->tail && IsMouseMove (ring->records + (ring->head & INPUT_RINGMASK), buttonState))
+		{
+			inputObj->inputRec = ring->records [ring->head & INPUT_RINGMASK];
+
+			InterlockedIncrement (&ring->head);
+			// Consume the newer move
+		}
+	}
+
+	else
+	{
+		while (PeekConsoleInput (inputObj->inputH, &next, 1, &count) && count && IsMouseMove (&next, buttonState))
+		{
+			ReadConsoleInput (inputObj->inputH, &inputObj->inputRec, 1, &count);
+			// Consume the newer move
+		}
+	}
+	// Clicks, double-clicks, wheel and key events end the run, so their order is kept
+}
+
+/********************************************************************
+*	IsMouseMove - Indicates that a record only moves the mouse		*
+*	Input:	An input record, and the button state it must match		*
+*	Output:	Move status												*
+********************************************************************/
+
+static BOOL IsMouseMove (INPUT_RECORD const * inputRec, DWORD buttonState)
+{
+	return inputRec->EventType == MOUSE_EVENT && inputRec->Event.MouseEvent.dwEventFlags == MOUSE_MOVED && inputRec->Event.MouseEvent.dwButtonState == buttonState;
+	// Retrieve move status
+}
+
+/*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
+/********************************************************************
+*																	*
+*							Input snapshots							*
+*																	*
+********************************************************************/
+/*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
+
+/********************************************************************
+*	TakeInputSnapshot - Gather every event since the last frame		*
+*	Input:	An input structure, and snapshot to fill				*
+*	Output:	Count of events gathered								*
+********************************************************************/
+
+int TakeInputSnapshot (Input * inputObj, InputSnapshot * snapshot)
+{
+	COORD start;		// Mouse position at start of frame
+	BOOL leftWasDown;	// Left button status before event
+	SHORT notches;		// Wheel movement of event
+
+	assert (inputObj && snapshot);
+	// Verify that inputObj and snapshot point to valid memory
+
+	ZeroMemory (snapshot, sizeof (InputSnapshot));
+
+	start = inputObj->mouse.mouseCoord;
+
+	while (TRUE)
+	{
+		leftWasDown = inputObj->mouse.leftClicked;
+
+		ReadInput (inputObj, kAsync);
+		// Get the next pending event
+
+		if (!inputObj->Count)
+		{
+			break;
+			// Stop once no events remain
+		}
+
+		snapshot->numEvents++;
+
+		if (inputObj->inputRec.EventType != MOUSE_EVENT)
+		{
+			continue;
+			// Keys are tracked by UpdateKeys
+		}
+
+		if (inputObj->mouse.leftClicked && !leftWasDown)
+		{
+			snapshot->numClicks++;
+		}
+
+		if (inputObj->mouse.doubleClicked)
+		{
+			snapshot->numDoubleClicks++;
+		}
+
+		if (inputObj->mouse.wheelUsed)
+		{
+			notches = (SHORT) HIWORD(inputObj->inputRec.Event.MouseEvent.dwButtonState);
+
+			snapshot->wheel += notches > 0 ? 1 : -1;
+		}
+	}
+
+	inputObj->frame++;	// Count the call
+
+	memcpy (snapshot->held, inputObj->keysHeld, KEYCODE_BYTES);
+	memcpy (snapshot->pressed, inputObj->keysPressed, KEYCODE_BYTES);
+	memcpy (snapshot->released, inputObj->keysReleased, KEYCODE_BYTES);
+	// Copy key state
+
+	ZeroMemory (inputObj->keysPressed, KEYCODE_BYTES);
+	ZeroMemory (inputObj->keysReleased, KEYCODE_BYTES);
+	// Begin collecting edges for the next frame
+
+	snapshot->mouseCoord = inputObj->mouse.mouseCoord;
+	snapshot->xDelta = inputObj->mouse.mouseCoord.X - start.X;
+	snapshot->yDelta = inputObj->mouse.mouseCoord.Y - start.Y;
+
+	snapshot->leftDown = inputObj->mouse.leftClicked;
+	snapshot->rightDown = inputObj->mouse.rightClicked;
+	// Copy mouse state
+
+	return snapshot->numEvents;
+	// Return count of events gathered
+}
+
+/********************************************************************
+*	KeyIsHeld - Indicates that a key was down at end of frame		*
+*	Input:	A snapshot, and a virtual-keycode						*
+*	Output:	Key status												*
+********************************************************************/
+
+BOOL KeyIsHeld (InputSnapshot const * snapshot, int keycode)
+{
+	assert (snapshot);
+	// Verify that snapshot points to valid memory
+
+	return KEYBIT(snapshot->held,keycode & (NUM_KEYCODES - 1)) != 0;
+	// Retrieve key status
+}
+
+/********************************************************************
+*	KeyWasPressed - Indicates that a key went down during frame		*
+*	Input:	A snapshot, and a virtual-keycode						*
+*	Output:	Key status												*
+********************************************************************/
+
+BOOL KeyWasPressed (InputSnapshot const * snapshot, int keycode)
+{
+	assert (snapshot);
+	// Verify that snapshot points to valid memory
+
+	return KEYBIT(snapshot->pressed,keycode & (NUM_KEYCODES - 1)) != 0;
+	// Retrieve key status
+}
+
+/********************************************************************
+*	KeyWasReleased - Indicates that a key went up during frame		*
+*	Input:	A snapshot, and a virtual-keycode						*
+*	Output:	Key status												*
+********************************************************************/
+
+BOOL KeyWasReleased (InputSnapshot const * snapshot, int keycode)
+{
+	assert (snapshot);
+	// Verify that snapshot points to valid memory
+
+	return KEYBIT(snapshot->released,keycode & (NUM_KEYCODES - 1)) != 0;
+	// Retrieve key status
+}
+
+/*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
+/********************************************************************
+*																	*
+*							Input thread							*
+*																	*
+********************************************************************/
+/*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
+
+/********************************************************************
+*	StartInputThread - Drain the console on a dedicated thread		*
+*	Input:	An input structure										*
+*	Output:	Success													*
+********************************************************************/
+
+BOOL StartInputThread (Input * inputObj)
+{
+	pInputRing ring;	// Queue shared with the thread
+
+	assert (inputObj);
+	// Verify that inputObj points to valid memory
+
+	if (inputObj->ring)	// Ensure that no thread is running
+	{
+		return TRUE;
+		// Return success if thread is already running
+	}
+
+	CALLOC(ring,1,InputRing);
+
+	if (!ring)
+	{
+		ERROR_MESSAGE("StartInputThread failed","1");
+		// Return failure
+	}
+	// Verify that ring was allocated
+
+	ring->inputH = inputObj->inputH;
+	ring->active = TRUE;
+
+	ring->ready = CreateEvent (NULL, FALSE, FALSE, NULL);
+
+	if (!ring->ready)
+	{
+		FREE(ring);
+
+		ERROR_MESSAGE("StartInputThread failed","2");
+		// Return failure
+	}
+	// Create an auto-reset event to wake synchronous readers
+
+	ring->thread = CreateThread (NULL, 0, InputThread, ring, 0, NULL);
+
+	if (!ring->thread)
+	{
+		CloseHandle (ring->ready);
+		FREE(ring);
+
+		ERROR_MESSAGE("StartInputThread failed","3");
+		// Return failure
+	}
+	// Launch the thread
+
+	inputObj->ring = ring;
+
+	return TRUE;
+	// Return success
+}
+
+/********************************************************************
+*	StopInputThread - Stop the input thread and release its queue	*
+*	Input:	An input structure										*
+********************************************************************/
+
+void StopInputThread (Input * inputObj)
+{
+	assert (inputObj);
+	// Verify that inputObj points to valid memory
+
+	if (!inputObj->ring)	// Ensure that inputObj's ring field points to something
+	{
+		return;	// Return if no thread is running
+	}
+
+	InterlockedExchange (&inputObj->ring->active, FALSE);
+	// Ask the thread to stop
+
+	WaitForSingleObject (inputObj->ring->thread, INFINITE);
+	// Wait for the thread to notice, at most one wait interval later
+
+	CloseHandle (inputObj->ring->thread);
+	CloseHandle (inputObj->ring->ready);
+
+	FREE(inputObj->ring);
+}
+
+/********************************************************************
+*	InputThread - Push console events into the input ring			*
+*	Input:	An input ring											*
+*	Output:	Thread exit code										*
+********************************************************************/
+
+static DWORD WINAPI InputThread (LPVOID data)
+{
+	pInputRing ring = (pInputRing) data;	// Queue to fill
+	DWORD space, count;						// Room in queue, and count of records read
+	LONG slot;								// Index of first free record
+
+	while (ring->active)
+	{
+		if (WaitForSingleObject (ring->inputH, INPUT_WAIT) != WAIT_OBJECT_0)
+		{
+			continue;
+			// Recheck the active flag if no input arrived
+		}
+
+		space = INPUT_RING - (ring->tail - ring->head);
+		// The consumer only advances head, so space can only grow
+
+		if (!space)
+		{
+			Sleep (1);
+
+			continue;
+			// Leave events in the console until the consumer catches up
+		}
+
+		slot = ring->tail & INPUT_RINGMASK;
+
+		if (space > (DWORD) (INPUT_RING - slot))
+		{
+			space = INPUT_RING - slot;
+			// Read only up to the end of the ring; the rest follows next pass
+		}
+
+		if (!ReadConsoleInput (ring->inputH, ring->records + slot, space, &count))
+		{
+			break;
+			// Stop if the console can no longer be read
+		}
+
+		InterlockedExchangeAdd (&ring->tail, (LONG) count);
+		// Publish the records after they are written
+
+		SetEvent (ring->ready);
+		// Wake any synchronous reader
+	}
+
+	return 0;
+	// Return thread exit code
+}
+
+/********************************************************************
+*	PopInput - Pop the oldest queued event into the input record	*
+*	Input:	An input structure, and the style of input to receive	*
+*	Output:	Indicates that an event was popped						*
+********************************************************************/
+
+static BOOL PopInput (Input * inputObj, InputStyle style)
+{
+	pInputRing ring = inputObj->ring;	// Queue to drain
+
+	while (ring->head == ring->tail)
+	{
+		if (style == kAsync)
+		{
+			inputObj->Count = 0;
+
+			return FALSE;
+			// Return failure if queue is empty
+		}
+
+		WaitForSingleObject (ring->ready, INFINITE);
+		// Block until the thread pushes records
+	}
+
+	inputObj->inputRec = ring->records [ring->head & INPUT_RINGMASK];
+	inputObj->Count = 1;
+
+	InterlockedIncrement (&ring->head);
+	// Release the record's slot once it is copied
+
+	return TRUE;
+	// Return success
+}
+
+/*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
+/********************************************************************
+*																	*
+*							Input journaling						*
+*																	*
+********************************************************************/
+/*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
+
+/********************************************************************
+*	RecordInput - Journal every event consumed by GetInput			*
+*	Input:	An input structure, and the journal's filename			*
+*	Output:	Success													*
+********************************************************************/
+
+BOOL RecordInput (Input * inputObj, String filename)
+{
+	assert (inputObj && filename);
+	// Verify that inputObj and filename point to valid memory
+
+	StopJournal (inputObj);
+	// Close any journal already in use
+
+	inputObj->journal = fopen (filename, "wb");
+
+	if (!inputObj->journal)
+	{
+		ERROR_MESSAGE("RecordInput failed","1");
+		// Return failure
+	}
+	// Verify that journal was opened
+
+	fwrite (JOURNAL_TAG, 1, JOURNAL_TAGSIZE, inputObj->journal);
+	// Tag the journal
+
+	inputObj->source = kRecord;
+	inputObj->frame = 0;
+	// Count frames from the start of the journal
+
+	return TRUE;
+	// Return success
+}
+
+/********************************************************************
+*	ReplayInput - Feed GetInput from a journal						*
+*	Input:	An input structure, and the journal's filename			*
+*	Output:	Success													*
+********************************************************************/
+
+BOOL ReplayInput (Input * inputObj, String filename)
+{
+	char tag [JOURNAL_TAGSIZE];	// Tag read from journal
+
+	assert (inputObj && filename);
+	// Verify that inputObj and filename point to valid memory
+
+	StopJournal (inputObj);
+	// Close any journal already in use
+
+	inputObj->journal = fopen (filename, "rb");
+
+	if (!inputObj->journal)
+	{
+		ERROR_MESSAGE("ReplayInput failed","1");
+		// Return failure
+	}
+	// Verify that journal was opened
+
+	if (fread (tag, 1, JOURNAL_TAGSIZE, inputObj->journal) != JOURNAL_TAGSIZE || memcmp (tag, JOURNAL_TAG, JOURNAL_TAGSIZE))
+	{
+		StopJournal (inputObj);
+
+		ERROR_MESSAGE("ReplayInput failed","2");
+		// Return failure
+	}
+	// Verify that file is a journal
+
+	inputObj->source = kReplay;
+	inputObj->frame = 0;
+	// Count frames from the start of the journal
+
+	if (!ReadJournalEntry (inputObj))
+	{
+		StopJournal (inputObj);
+		// Return to live input if journal is empty
+	}
+
+	return TRUE;
+	// Return success
+}
+
+/********************************************************************
+*	StopJournal - Close any journal and return to live input		*
+*	Input:	An input structure										*
+********************************************************************/
+
+void StopJournal (Input * inputObj)
+{
+	assert (inputObj);
+	// Verify that inputObj points to valid memory
+
+	if (inputObj->journal)	// Ensure that inputObj's journal field points to something
+	{
+		fclose (inputObj->journal);
+
+		inputObj->journal = NULL;
+	}
+
+	inputObj->source = kLive;
+}
+
+/********************************************************************
+*	InputReplaying - Indicates that a journal is being replayed		*
+*	Input:	An input structure										*
+*	Output:	Replay status											*
+********************************************************************/
+
+BOOL InputReplaying (Input const * inputObj)
+{
+	assert (inputObj);
+	// Verify that inputObj points to valid memory
+
+	return inputObj->source == kReplay;
+	// Retrieve replay status
+}
+
+/********************************************************************
+*	GetInputReplay - Retrieve input from a journal					*
+*	Input:	An input structure, and the style of input to receive	*
+*	Output:	Return appropriate virtual-keycode to process			*
+********************************************************************/
+
+static int GetInputReplay (Input * inputObj, InputStyle style)
+{
+	pInputEntry entry = &inputObj->pending;	// Entry to replay
+
+	if (style == kAsync && entry->frame > inputObj->frame)
+	{
+		inputObj->Count = 0;
+
+		return 0;
+		// Return null input if the entry belongs to a later frame
+	}
+	// Synchronous reads take the next entry, as a live read would block for it
+
+	ZeroMemory (&inputObj->inputRec, sizeof (INPUT_RECORD));
+
+	inputObj->inputRec.EventType = entry->type;
+	inputObj->Count = 1;
+
+	switch (entry->type)	// Get event type
+	{
+	case KEY_EVENT:		// Key case
+		inputObj->inputRec.Event.KeyEvent.bKeyDown = entry->state;
+		inputObj->inputRec.Event.KeyEvent.wVirtualKeyCode = entry->code;
+		inputObj->inputRec.Event.KeyEvent.uChar.AsciiChar = entry->ascii;
+
+		break;	// Break out of switch statement
+
+	case MOUSE_EVENT:	// Mouse case
+		inputObj->inputRec.Event.MouseEvent.dwButtonState = entry->state;
+		inputObj->inputRec.Event.MouseEvent.dwEventFlags = entry->flags;
+		inputObj->inputRec.Event.MouseEvent.dwMousePosition.X = (SHORT) entry->code;
+		inputObj->inputRec.Event.MouseEvent.dwMousePosition.Y = (SHORT) entry->y;
+
+		break;	// Break out of switch statement
+	case FOCUS_EVENT:	// Focus case
+		inputObj->inputRec.Event.FocusEvent.bSetFocus = entry->state;
+
+		break;	// Break out of switch statement
+	}
+	// Unpack the entry into the input record
+
+	if (!ReadJournalEntry (inputObj))
+	{
+		StopJournal (inputObj);
+		// Return to live input once the journal runs out
+	}
+
+	return GetRecordKeyCode (inputObj);
+	// Return keycode of replayed input
+}
+
+/********************************************************************
+*	WriteJournalEntry - Pack the current record into the journal	*
+*	Input:	An input structure										*
+********************************************************************/
+
+static void WriteJournalEntry (Input * inputObj)
+{
+	InputEntry entry;	// Entry to write
+
+	ZeroMemory (&entry, sizeof (InputEntry));
+
+	entry.frame = inputObj->frame;
+	entry.type = (BYTE) inputObj->inputRec.EventType;
+
+	switch (inputObj->inputRec.EventType)	// Get event type
+	{
+	case KEY_EVENT:		// Key case
+		entry.state = (BYTE) inputObj->inputRec.Event.KeyEvent.bKeyDown;
+		entry.code = inputObj->inputRec.Event.KeyEvent.wVirtualKeyCode;
+		entry.ascii = inputObj->inputRec.Event.KeyEvent.uChar.AsciiChar;
+
+		break;	// Break out of switch statement
+
+	case MOUSE_EVENT:	// Mouse case
+		entry.state = inputObj->inputRec.Event.MouseEvent.dwButtonState;	// Keep the wheel delta in the high word
+		entry.flags = (BYTE) inputObj->inputRec.Event.MouseEvent.dwEventFlags;
+		entry.code = (WORD) inputObj->inputRec.Event.MouseEvent.dwMousePosition.X;
+		entry.y = (WORD) inputObj->inputRec.Event.MouseEvent.dwMousePosition.Y;
+
+		break;	// Break out of switch statement
+	case FOCUS_EVENT:	// Focus case
+		entry.state = (BYTE) inputObj->inputRec.Event.FocusEvent.bSetFocus;
+
+		break;	// Break out of switch statement
+	}
+	// Keep only the fields that GetInput, UpdateMouse and UpdateKeys read
+
+	fwrite (&entry, sizeof (InputEntry), 1, inputObj->journal);
+}
+
+/********************************************************************
+*	ReadJournalEntry - Read the next entry to replay				*
+*	Input:	An input structure										*
+*	Output:	Indicates that an entry was read						*
+********************************************************************/
+
+static BOOL ReadJournalEntry (Input * inputObj)
+{
+	return fread (&inputObj->pending, sizeof (InputEntry), 1, inputObj->journal) == 1;
+	// Read the next entry, failing at the journal's end
+}
+
 /*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
 /********************************************************************
 *																	*
@@ -387,6 +1239,12 @@ static void UpdateMouse (Input * inputObj)
 
 BOOL DeinitializeInputObject (Input * inputObj)
 {
+	StopJournal (inputObj);
+	// Flush and close any journal
+
+	StopInputThread (inputObj);
+	// Stop draining the console
+
 	if (inputObj->information)	// Ensure that inputObj's information field points to something
 	{
 		FREE(inputObj->information->infoItems);
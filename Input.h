@@ -12,6 +12,31 @@
 
 #include "Common.h"
 
+/*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
+/********************************************************************
+*																	*
+*							Defines									*
+*																	*
+********************************************************************/
+/*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
+
+#define JOURNAL_TAG		"INJ2"
+#define JOURNAL_TAGSIZE	4
+// Tag written at the head of an input journal, and its length
+
+#define INPUT_WAIT		50
+// Milliseconds the input thread waits on the console before checking
+// whether it should stop
+
+#define KEYBIT(bits,key)		(*((bits) + ((key) >> 3)) & (1 << ((key) & 7)))
+#define SETKEYBIT(bits,key)		*((bits) + ((key) >> 3)) |= 1 << ((key) & 7)
+#define CLEARKEYBIT(bits,key)	*((bits) + ((key) >> 3)) &= ~(1 << ((key) & 7))
+// Access a keycode's bit within a key bitmap
+
+#define GETHOTKEY(table,keycode)	\
+	((table) && (unsigned) (keycode) < NUM_KEYCODES ? (table)->keys [keycode] : NULL)
+// Used to retrieve the key bound to a keycode
+
 /*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
 /********************************************************************
 *																	*
@@ -132,6 +157,30 @@ int GetLastKeyCode (Input const * inputObj);
 
 void SetInputMethod (pKey keyObj, int (* function) (voidStar data, dataType type, long lParam));
 
+/********************************************************************
+*	MakeHotKeyTable - Compile keys into a dispatch table			*
+*	Input:	Array of keys, and count of keys						*
+*	Output:	Table, or NULL on failure								*
+********************************************************************/
+
+pHotKeyTable MakeHotKeyTable (pKey keys, int numKeys);
+
+/********************************************************************
+*	BindHotKey - Bind a key to a keycode in a dispatch table		*
+*	Input:	A dispatch table, a keycode, and key to bind			*
+*	Output:	Table entry is set										*
+********************************************************************/
+
+void BindHotKey (pHotKeyTable table, int keycode, pKey keyObj);
+
+/********************************************************************
+*	SetMouseCoalescing - Set whether runs of mouse moves collapse	*
+*	Input:	An input structure, and the coalescing status			*
+*	Output:	Input structure's coalesceMoves field is set			*
+********************************************************************/
+
+void SetMouseCoalescing (pInput inputObj, BOOL coalesce);
+
 /*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
 /********************************************************************
 *																	*
@@ -162,6 +211,31 @@ BOOL InitializeInputObject (pInput inputObj);
 
 int GetInput (pInput inputObj, InputStyle style);
 
+/********************************************************************
+*	GetInputBatch - Retrieve every event since the last frame		*
+*	Input:	An input structure, array to receive records, and the	*
+*			array's capacity										*
+*	Output:	Count of records received								*
+********************************************************************/
+
+int GetInputBatch (pInput inputObj, PINPUT_RECORD records, int maxRecords);
+
+/********************************************************************
+*	WaitForInput - Block until input is available					*
+*	Input:	An input structure, and timeout in milliseconds			*
+*	Output:	Indicates that input may be available					*
+********************************************************************/
+
+BOOL WaitForInput (pInput inputObj, DWORD timeout);
+
+/********************************************************************
+*	ReadInput - Retrieve and process a single event					*
+*	Input:	An input structure, and the style of input to receive	*
+*	Output:	Return appropriate virtual-keycode to process			*
+********************************************************************/
+
+static int ReadInput (pInput inputObj, InputStyle style);
+
 /********************************************************************
 *	GetInputSync - Retrieve synchronous input						*
 *	Input:	An input structure										*
@@ -186,6 +260,179 @@ static int GetInputAsync (pInput inputObj);
 
 static void UpdateMouse (pInput inputObj);
 
+/********************************************************************
+*	GetRecordKeyCode - Get keycode of the current input record		*
+*	Input:	An input structure										*
+*	Output:	Virtual-keycode of a key press, or null input			*
+********************************************************************/
+
+static int GetRecordKeyCode (Input const * inputObj);
+
+/********************************************************************
+*	UpdateKeys - Updates held keys and key edges					*
+*	Input:	An input structure										*
+*	Output:	Key bitmaps are updated									*
+********************************************************************/
+
+static void UpdateKeys (pInput inputObj);
+
+/********************************************************************
+*	CoalesceMouseMoves - Skip to the last of consecutive moves		*
+*	Input:	An input structure										*
+*	Output:	Input record holds the latest position					*
+********************************************************************/
+
+static void CoalesceMouseMoves (pInput inputObj);
+
+/********************************************************************
+*	IsMouseMove - Indicates that a record only moves the mouse		*
+*	Input:	An input record, and the button state it must match		*
+*	Output:	Move status												*
+********************************************************************/
+
+static BOOL IsMouseMove (INPUT_RECORD const * inputRec, DWORD buttonState);
+
+/*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
+/********************************************************************
+*																	*
+*							Input snapshots							*
+*																	*
+********************************************************************/
+/*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
+
+/********************************************************************
+*	TakeInputSnapshot - Gather every event since the last frame		*
+*	Input:	An input structure, and snapshot to fill				*
+*	Output:	Count of events gathered								*
+********************************************************************/
+
+int TakeInputSnapshot (pInput inputObj, pInputSnapshot snapshot);
+
+/********************************************************************
+*	KeyIsHeld - Indicates that a key was down at end of frame		*
+*	Input:	A snapshot, and a virtual-keycode						*
+*	Output:	Key status												*
+********************************************************************/
+
+BOOL KeyIsHeld (InputSnapshot const * snapshot, int keycode);
+
+/********************************************************************
+*	KeyWasPressed - Indicates that a key went down during frame		*
+*	Input:	A snapshot, and a virtual-keycode						*
+*	Output:	Key status												*
+********************************************************************/
+
+BOOL KeyWasPressed (InputSnapshot const * snapshot, int keycode);
+
+/********************************************************************
+*	KeyWasReleased - Indicates that a key went up during frame		*
+*	Input:	A snapshot, and a virtual-keycode						*
+*	Output:	Key status												*
+********************************************************************/
+
+BOOL KeyWasReleased (InputSnapshot const * snapshot, int keycode);
+
+/*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
+/********************************************************************
+*																	*
+*							Input thread							*
+*																	*
+********************************************************************/
+/*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
+
+/********************************************************************
+*	StartInputThread - Drain the console on a dedicated thread		*
+*	Input:	An input structure										*
+*	Output:	Success													*
+********************************************************************/
+
+BOOL StartInputThread (pInput inputObj);
+
+/********************************************************************
+*	StopInputThread - Stop the input thread and release its queue	*
+*	Input:	An input structure										*
+********************************************************************/
+
+void StopInputThread (pInput inputObj);
+
+/********************************************************************
+*	InputThread - Push console events into the input ring			*
+*	Input:	An input ring											*
+*	Output:	Thread exit code										*
+********************************************************************/
+
+static DWORD WINAPI InputThread (LPVOID data);
+
+/********************************************************************
+*	PopInput - Pop the oldest queued event into the input record	*
+*	Input:	An input structure, and the style of input to receive	*
+*	Output:	Indicates that an event was popped						*
+********************************************************************/
+
+static BOOL PopInput (pInput inputObj, InputStyle style);
+
+/*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
+/********************************************************************
+*																	*
+*							Input journaling						*
+*																	*
+********************************************************************/
+/*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
+
+/********************************************************************
+*	RecordInput - Journal every event consumed by GetInput			*
+*	Input:	An input structure, and the journal's filename			*
+*	Output:	Success													*
+********************************************************************/
+
+BOOL RecordInput (pInput inputObj, String filename);
+
+/********************************************************************
+*	ReplayInput - Feed GetInput from a journal						*
+*	Input:	An input structure, and the journal's filename			*
+*	Output:	Success													*
+********************************************************************/
+
+BOOL ReplayInput (pInput inputObj, String filename);
+
+/********************************************************************
+*	StopJournal - Close any journal and return to live input		*
+*	Input:	An input structure										*
+********************************************************************/
+
+void StopJournal (pInput inputObj);
+
+/********************************************************************
+*	InputReplaying - Indicates that a journal is being replayed		*
+*	Input:	An input structure										*
+*	Output:	Replay status											*
+********************************************************************/
+
+BOOL InputReplaying (Input const * inputObj);
+
+/********************************************************************
+*	GetInputReplay - Retrieve input from a journal					*
+*	Input:	An input structure, and the style of input to receive	*
+*	Output:	Return appropriate virtual-keycode to process			*
+********************************************************************/
+
+static int GetInputReplay (pInput inputObj, InputStyle style);
+
+/********************************************************************
+*	WriteJournalEntry - Pack the current record into the journal	*
+*	Input:	An input structure										*
+********************************************************************/
+
+static void WriteJournalEntry (pInput inputObj);
+
+/********************************************************************
+*	ReadJournalEntry - Read the next entry to replay				*
+*	Input:	An input structure										*
+*	Output:	Indicates that an entry was read						*
+********************************************************************/
+
+static BOOL ReadJournalEntry (pInput inputObj);
+
 /*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
 /********************************************************************
 *																	*
@@ -34,8 +34,10 @@ static pWindow G_endWindow;
 // Used to quicken Window loops
 static pMenuItem G_endItem;
 // Used to quicken MenuItem loops
-static pKey G_endKey;
-// Used to quicken Key loops
+static Key G_focusCommand = {0, FocusCommand};
+static Key G_closeCommand = {0, CloseCommand};
+static Key G_confirmCommand = {0, ConfirmCommand};
+// Keys bound to each parent window's focus, close and confirm keycodes
 static pSeparatorEntry G_endSepEntry;
 // Used to quicken SeparatorEntry loops
 static pReceiverEntry G_endRecEntry;
@@ -57,6 +59,13 @@ static PCHAR_INFO G_endCell;
 
 static PCOORD G_location;
 // Used to redraw windows
+static PRECT G_damage;
+// Used to collect screen damage of the active parent window
+static BYTE (* G_owners) [SCREEN_WIDTH];
+static BYTE G_owner;
+// Used to clip drawing to the cells a stacked parent window owns
+static pWindowManager G_manager;
+// Used to repair the stack beneath a dragged parent window
 
 static PCHAR_INFO G_cell;
 // Used for output
@@ -77,6 +86,9 @@ static pCell G_end, G_bufCell;
 static void IncXOffset (Window * window)
 {
 	window->xOffset++;
+
+	DAMAGEVISIBLE(window);
+	// New cells scroll into view
 }
 
 /********************************************************************
@@ -86,6 +98,9 @@ static void IncXOffset (Window * window)
 static void DecXOffset (Window * window)
 {
 	window->xOffset--;
+
+	DAMAGEVISIBLE(window);
+	// New cells scroll into view
 }
 
 /********************************************************************
@@ -95,6 +110,9 @@ static void DecXOffset (Window * window)
 static void IncYOffset (Window * window)
 {
 	window->yOffset++;
+
+	DAMAGEVISIBLE(window);
+	// New cells scroll into view
 }
 
 /********************************************************************
@@ -104,30 +122,9 @@ static void IncYOffset (Window * window)
 static void DecYOffset (Window * window)
 {
 	window->yOffset--;
-}
-
-/********************************************************************
-*	AdvanceCursor - Advance a Window structure's read/write cursor	*
-********************************************************************/
-
-static void AdvanceCursor (Window * window, int amount)
-{
-	if (window->IO->cursor + amount < window->IO->text.limit)
-	{
-		window->IO->cursor += amount;
-	}
-}
 
-/********************************************************************
-*	RegressCursor - Regress a Window structure's read/write cursor	*
-********************************************************************/
-
-static void RegressCursor (Window * window, int amount)
-{
-	if (window->IO->cursor - amount >= 0)
-	{
-		window->IO->cursor -= amount;
-	}
+	DAMAGEVISIBLE(window);
+	// New cells scroll into view
 }
 
 /********************************************************************
@@ -180,6 +177,7 @@ void ActivateWindows (ParentWindow * parentWindow)
 	SETFLAG(parentWindow->state,WINDOWSACTIVE);
 
 	G_location = &parentWindow->location;
+	G_damage = &parentWindow->damage;
 }
 
 /********************************************************************
@@ -194,6 +192,7 @@ void DeactivateWindows (ParentWindow * parentWindow)
 	CLEARFLAG(parentWindow->state,WINDOWSACTIVE);
 
 	G_location = NULL;
+	G_damage = NULL;
 }
 
 /********************************************************************
@@ -228,11 +227,28 @@ void MakeParentWindow (ParentWindow * parentWindow, int x, int y, int focus)
 	// Verify that parentWindow and parentWindow's windows field point to valid memory
 
 	InitParentWindow (parentWindow);
+	ComposeChrome (parentWindow);
+
+	FREE(parentWindow->hotKeys);
+	// Free memory pointed to by parentWindow's hotKeys field, if rebuilding; globalKeys is shared and kept
+
+	parentWindow->hotKeys = MakeHotKeyTable (NULL, 0);
+
+	if (parentWindow->hotKeys)	// Ensure that parentWindow's hotKeys field points to something
+	{
+		BindHotKey (parentWindow->hotKeys, parentWindow->confirmKey, &G_confirmCommand);
+		BindHotKey (parentWindow->hotKeys, parentWindow->closeKey, &G_closeCommand);
+		BindHotKey (parentWindow->hotKeys, parentWindow->focusKey, &G_focusCommand);
+	}
 
 	G_endWindow = parentWindow->windows + parentWindow->numWindows;
 
+	SetRectEmpty (&parentWindow->damage);
+
 	for (window = parentWindow->windows; window < G_endWindow; window++)
 	{
+		DAMAGEWINDOW(window);
+
 		if (window->mode == kMenu)
 		{
 			InitMenu (window);
@@ -259,13 +275,16 @@ static void InitMenu (Window * window)
 
 	menu = window->menu;
 
+	menu->table = MakeHotKeyTable (menu->keys, menu->numKeys);
+
 	G_endItem = menu->menu + menu->numItems;
 
 	for (menuItem = menu->menu; menuItem < G_endItem; menuItem++)
 	{
 		offset = menuItem->location.Y * window->width + menuItem->location.X;
 
-		WriteText (&window->display, *GETMENUITEMTEXT(menuItem), offset);
+		WriteText (&window->display, GetString (*GETMENUITEMTEXT(menuItem)), offset);
+		DamageSpan (window, offset, GetStringLength (*GETMENUITEMTEXT(menuItem)));
 	}
 
 	HighlightMenuItem (window, menu->itemChosen);
@@ -400,6 +419,47 @@ static void InitParentWindow (ParentWindow * parentWindow)
 	}
 }
 
+/********************************************************************
+*	ComposeChrome - Compose the border and background cells of a	*
+*		parent window, to be called again after restyling it		*
+********************************************************************/
+
+BOOL ComposeChrome (ParentWindow * parentWindow)
+{
+	int size;	// Number of cells in parent window
+	PBYTE backData;
+	BYTE check;
+
+	assert (parentWindow && parentWindow->backData);
+	// Verify that parentWindow and parentWindow's backData field point to valid memory
+
+	size = parentWindow->width * parentWindow->height;
+
+	if (!parentWindow->chrome)
+	{
+		CALLOC(parentWindow->chrome,size,CHAR_INFO);
+
+		if (!parentWindow->chrome)
+		{
+			ERROR_MESSAGE("ComposeChrome failed","1");
+			// Return failure
+		}
+		// Verify that parentWindow's chrome field points to valid memory
+	}
+
+	backData = parentWindow->backData;
+
+	for (G_cell = parentWindow->chrome, G_endCell = G_cell + size; G_cell < G_endCell; G_cell++)
+	{
+		check = G_cell->Char.AsciiChar = *backData++;
+
+		G_cell->Attributes = check ? parentWindow->border : parentWindow->background;
+	}
+
+	return TRUE;
+	// Return success
+}
+
 /*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
 /********************************************************************
 *																	*
@@ -449,23 +509,46 @@ void Update (ParentWindow * parentWindow, Objects * objects, voidStar data)
 {
 	int keycode;
 	pWindow window;
+	pKey key;
+	BOOL eventDriven, animate = TRUE, changed = TRUE;
 
 	assert (parentWindow && objects);
 	// Verify that parentWindow and objects point to valid memory
 
+	eventDriven = FLAGSET(parentWindow->state,EVENTDRIVEN);
+
+	if (eventDriven)
+	{
+		animate = WaitForUpdate (parentWindow, objects);
+	}
+
 	G_endWindow = parentWindow->windows + parentWindow->numWindows;
 
-	if (FLAGSET(parentWindow->state,GRABBED) && MouseWasMoved (&objects->inputObj))
+	if (!eventDriven && FLAGSET(parentWindow->state,GRABBED) && MouseWasMoved (&objects->inputObj))
 	{
-		ClearScreen (&objects->outputObj);
-		CopyBuffer (&objects->outputObj.outputBuf, parentWindow->back);
-		RepositionWindows (parentWindow, objects);
-		RedrawWindows (parentWindow, objects);
+		DragParentWindow (parentWindow, objects);
 	}
 
  	keycode = GetInput (&objects->inputObj, kAsync);
 
-	for (window = parentWindow->windows; window < G_endWindow; window++)
+	if (eventDriven)
+	{
+		changed = animate || objects->inputObj.Count;
+
+		if (!changed)
+		{
+			return;
+			// Nothing to update or present on a spurious wake
+		}
+
+		if (FLAGSET(parentWindow->state,GRABBED) && MouseWasMoved (&objects->inputObj))
+		{
+			DragParentWindow (parentWindow, objects);
+		}
+		// Follow the event just read; the wait may not return until more input arrives
+	}
+
+	for (window = parentWindow->windows; window < G_endWindow && animate; window++)
 	{
 		if (FLAGSET(window->state,ACTIVEWITHOUTFOCUS) && !HasFocus (window))
 		{
@@ -489,33 +572,82 @@ void Update (ParentWindow * parentWindow, Objects * objects, voidStar data)
 		}
 	}
 	
-	if (keycode)
+	key = FindHotKey (parentWindow, keycode, kWindowScope, NULL);
+
+	if (key)
 	{
-		if (keycode == parentWindow->focusKey)
-		{
-			SwitchFocus (parentWindow);
-		}
+		ProcessInput (key, parentWindow, kParentWindow, (long) objects);
+	}
+	// A focused menu binding the same key handles it as well; it does not shadow the parent's commands
 
-		if (keycode == parentWindow->closeKey)
-		{
-			DeactivateWindows (parentWindow);
-		}
+	UpdateScreenRect (&objects->outputObj, &parentWindow->damage);
+	SetRectEmpty (&parentWindow->damage);
+	// Present only what changed
+
+	if (!eventDriven)
+	{
+		Sleep (parentWindow->delay);
+	}
+}
+
+/********************************************************************
+*	WaitForUpdate - Block until input or the animation deadline		*
+********************************************************************/
+
+static BOOL WaitForUpdate (ParentWindow * parentWindow, Objects * objects)
+{
+	DWORD now = GetTickCount (), timeout = INFINITE;
+
+	if (WindowsAnimated (parentWindow))
+	{
+		timeout = (long) (parentWindow->deadline - now) > 0 ? parentWindow->deadline - now : 0;
+		// Wait no longer than the next animation update
+	}
+
+	WaitForInput (&objects->inputObj, timeout);
+
+	now = GetTickCount ();
+
+	if (timeout == INFINITE || (long) (parentWindow->deadline - now) > 0)
+	{
+		return FALSE;
+		// Woken by input before any animation is due
+	}
+
+	parentWindow->deadline = now + parentWindow->delay;
+
+	return TRUE;
+}
+
+/********************************************************************
+*	WindowsAnimated - Indicates that windows change without input	*
+********************************************************************/
+
+static BOOL WindowsAnimated (ParentWindow const * parentWindow)
+{
+	pWindow window, focus = GETFOCUS(parentWindow);
+
+	if (focus->mode == kMessageBox && focus->IO->writeMode == kWriteCharacter)
+	{
+		return TRUE;
+		// A message box written one character per update is animated
+	}
+
+	if (focus->mode == kMessageBox && focus->IO->log)
+	{
+		return TRUE;
+		// A log viewer tails its file on each update, so poll for growth
+	}
 
-		if (keycode == parentWindow->confirmKey)
+	for (window = parentWindow->windows, G_endWindow = window + parentWindow->numWindows; window < G_endWindow; window++)
+	{
+		if (FLAGSET(window->state,ACTIVEWITHOUTFOCUS) && window != focus)
 		{
-			for (window = parentWindow->windows; window < G_endWindow; window++)
-			{
-				if (HasFocus (window) || FLAGSET(window->state,SAVEWITHOUTFOCUS))
-				{
-					SaveMessage (window);
-				}
-			}
+			return TRUE;
 		}
 	}
 
-	UpdateScreen (&objects->outputObj);
-
-	Sleep (parentWindow->delay);
+	return FALSE;
 }
 
 /********************************************************************
@@ -572,12 +704,11 @@ static void SendEditBoxInformation (ParentWindow * parentWindow, Objects * objec
 	int lastKey = GetLastKeyCode (&objects->inputObj);
 //	PCHAR_INFO cell;
 	pWindow window;
-	HorzScroll horzMode = kHorzFix;
-	VertScroll vertMode = kVertFix;
+	pIO_Descriptor IO;
+	int length;
 	
 	window = GETFOCUS(parentWindow);
-
-	SCROLL(window,horzMode,vertMode,lastKey);
+	IO = window->IO;
 
 	switch (window->IO->readMode)	// Get the read mode
 	{
@@ -601,29 +732,75 @@ static void SendEditBoxInformation (ParentWindow * parentWindow, Objects * objec
 		// Return failure
 	}
 
-	if (lastKey != parentWindow->focusKey && lastKey != parentWindow->closeKey && lastKey != parentWindow->confirmKey)
+	if (FindHotKey (parentWindow, lastKey, kFocusScope, NULL))
 	{
-	/*	cell*/G_bufCell = GETCURSORCELL(window);
+		return;
+	}
 
-		if (lastKey == VK_BACK)
+	MoveGap (&IO->text, IO->cursor);
+	// Edits happen at the cursor, where the gap normally already is
+
+	length = TEXTLENGTH(&IO->text);
+
+	switch (lastKey)	// Get the last key
+	{
+	case VK_BACK:
+		if (EraseText (&IO->text, -1))
 		{
-		/*	cell*/G_bufCell->graph.Char.AsciiChar = SPACE;
-			RegressCursor (window, 1);
+			IO->cursor--;
 
-		/*	cell*/G_bufCell->graph.Char.AsciiChar = SPACE;
-			*GETCURSORTEXT(window) = END;
+			RenderEditBox (window, IO->cursor, length);
+			// Redraw only the text that shifted
 		}
 
-		else
+		break;	// Break out of switch statement
+
+	case VK_DELETE:
+		if (EraseText (&IO->text, 1))
 		{
-			if (nextChar)
-			{
-			/*	cell*/G_bufCell->graph.Char.AsciiChar = nextChar;
-				*GETCURSORTEXT(window) = nextChar;
+			RenderEditBox (window, IO->cursor, length);
+			// Redraw only the text that shifted
+		}
+
+		break;	// Break out of switch statement
+
+	case VK_LEFT:
+		MoveEditCursor (window, IO->cursor - 1);
+
+		break;	// Break out of switch statement
+
+	case VK_RIGHT:
+		MoveEditCursor (window, IO->cursor + 1);
+
+		break;	// Break out of switch statement
+
+	case VK_UP:
+		MoveEditCursor (window, IO->cursor - window->width);
+
+		break;	// Break out of switch statement
+
+	case VK_DOWN:
+		MoveEditCursor (window, IO->cursor + window->width);
+
+		break;	// Break out of switch statement
+
+	case VK_HOME:
+		MoveEditCursor (window, 0);
+
+		break;	// Break out of switch statement
+
+	case VK_END:
+		MoveEditCursor (window, length);
+
+		break;	// Break out of switch statement
 
-				AdvanceCursor (window, 1);
-				*GETCURSORTEXT(window) = END;
-			}	
+	default:
+		if (nextChar && length + 1 < window->width * window->height && InsertText (&IO->text, nextChar))
+		{
+			RenderEditBox (window, IO->cursor, length + 1);
+			// Redraw only the text that shifted
+
+			IO->cursor++;
 		}
 	}
 }
@@ -640,18 +817,13 @@ static void SendMenuInformation (ParentWindow * parentWindow, Objects * objects)
 	pReceivers receivers = window->receivers;
 	pReceiverEntry receiverEntry;
 	pMenu menu = window->menu;
-	pKey keys = menu->keys;
-	
-	G_endKey = menu->keys + menu->numKeys;
+	pKey key = GETHOTKEY(menu->table,lastKey);
 
-	for (keys = menu->keys; keys < G_endKey && !updateReceivers; keys++)
+	if (key)
 	{
-		if (lastKey == keys->keycode)
-		{
-			ProcessInput (keys, menu, kMenu, (long) window);
+		ProcessInput (key, menu, kMenu, (long) window);
 
-			updateReceivers = TRUE;
-		}
+		updateReceivers = TRUE;
 	}
 
 	G_endRecEntry = receivers->receivers + receivers->numReceivers;
@@ -998,6 +1170,8 @@ static void UpdateBasicWindow (Window * window, Objects * objects, voidStar data
 			G_bufCell += pitch;
 		}
 
+		DAMAGEVISIBLE(window);
+
 		G_endPattern = window->visuals->patterns + window->visuals->numPatterns;
 
 		for (pattern = window->visuals->patterns; pattern < G_endPattern; pattern++)
@@ -1032,12 +1206,18 @@ static void UpdateEditBoxWindow (Window * window, Objects * objects, voidStar da
 
 	*CursorChar = (*CursorChar == UNDERSCORE) ? SPACE : UNDERSCORE;*/
 	String CursorChar;
+	char under;	// Character the cursor covers
 
 	G_bufCell = GETCURSORCELL(window);
 
 	CursorChar = &G_bufCell->graph.Char.AsciiChar;
 
-	*CursorChar = (*CursorChar == UNDERSCORE) ? SPACE : UNDERSCORE;
+	under = window->IO->cursor < TEXTLENGTH(&window->IO->text) ? GetTextChar (&window->IO->text, window->IO->cursor) : SPACE;
+
+	*CursorChar = (*CursorChar == UNDERSCORE) ? under : UNDERSCORE;
+	// Blink between the cursor and the text beneath it
+
+	DamageSpan (window, window->IO->cursor, 1);
 }
 
 /********************************************************************
@@ -1054,30 +1234,50 @@ static void UpdateMenuWindow (Window * window, Objects * objects, voidStar data)
 
 static void UpdateMessageBox (Window * window, Objects * objects, voidStar data)
 {
+	int position, end;
 	pIO_Descriptor IO = window->IO;
 
-	if (IO->text.position == IO->text.numChars)
+	if (IO->log)	// Ensure that window is not a log viewer
+	{
+		UpdateLogView (window);
+
+		return;
+		// Log viewers show their file, not their text
+	}
+
+	if (IO->text.position >= IO->text.numChars - 1)
+	{
+		return;
+	}
+
+	if (!LayoutMessage (window))
 	{
 		return;
+		// Text could not be laid out
 	}
 
+	end = IO->text.numChars - 1;
+	position = IO->text.position;
+
 	switch (IO->writeMode)
 	{
 	case kWriteAll:
-		while (IO->text.position + 1 != IO->text.numChars)
-		{
-			WriteMessageWord (window, IO);
-		}
+		position = end;
 
 		break;	// Break out of switch statement
 
 	case kWriteWord:
-		WriteMessageWord (window, IO);
+		position += SkipSpaces (IO->text.text, position);
+
+		while (position < end && !isspace (IO->text.text [position]) && IO->text.text [position])
+		{
+			position++;
+		}
 
 		break;	// Break out of switch statement
 
 	case kWriteCharacter:
-		WriteMessageCharacter (window, IO);
+		position++;
 
 		break;	// Break out of switch statement
 
@@ -1085,6 +1285,9 @@ static void UpdateMessageBox (Window * window, Objects * objects, voidStar data)
 		NORET_MESSAGE("Unsupported mode: UpdateMessageBox failed","1");
 		// Return failure
 	}
+
+	RevealMessage (window, min (position, end));
+	// Show the cached layout up to the new position
 }
 
 /********************************************************************
@@ -1123,6 +1326,71 @@ static void RepositionWindows (ParentWindow * parentWindow, Objects * objects)
 	}	
 }
 
+/********************************************************************
+*	DragParentWindow - Move a grabbed ParentWindow structure,		*
+*		repairing only the exposed strips of the screen				*
+********************************************************************/
+
+static void DragParentWindow (ParentWindow * parentWindow, Objects * objects)
+{
+	RECT before, after;	// Screen regions before and after the move
+	RECT strip;			// Exposed region of the screen
+
+	SetRect (&before, parentWindow->location.X, parentWindow->location.Y, parentWindow->location.X + parentWindow->width, parentWindow->location.Y + parentWindow->height);
+
+	RepositionWindows (parentWindow, objects);
+
+	if (parentWindow->location.X == before.left && parentWindow->location.Y == before.top)
+	{
+		return;
+		// Window did not move
+	}
+
+	SetRect (&after, parentWindow->location.X, parentWindow->location.Y, parentWindow->location.X + parentWindow->width, parentWindow->location.Y + parentWindow->height);
+
+	MoveBufferRect (&objects->outputObj.outputBuf, &before, after.left, after.top);
+	// Blit the composed window image to its new location
+
+	if (G_manager)
+	{
+		IndexParentWindows (G_manager);
+		RepairParentWindows (G_manager, objects, &before);
+		// Uncover the stacked parent windows beneath the old location
+	}
+
+	else if (after.top > before.top)
+	{
+		SetRect (&strip, before.left, before.top, before.right, min (after.top, before.bottom));
+		CopyBufferRect (&objects->outputObj.outputBuf, parentWindow->back, &strip);
+		// Restore the rows exposed above the window
+	}
+
+	else if (after.top < before.top)
+	{
+		SetRect (&strip, before.left, max (after.bottom, before.top), before.right, before.bottom);
+		CopyBufferRect (&objects->outputObj.outputBuf, parentWindow->back, &strip);
+		// Restore the rows exposed below the window
+	}
+
+	if (after.left > before.left)
+	{
+		SetRect (&strip, before.left, max (after.top, before.top), min (after.left, before.right), min (after.bottom, before.bottom));
+		CopyBufferRect (&objects->outputObj.outputBuf, parentWindow->back, &strip);
+		// Restore the columns exposed left of the window
+	}
+
+	else if (after.left < before.left)
+	{
+		SetRect (&strip, max (after.right, before.left), max (after.top, before.top), before.right, min (after.bottom, before.bottom));
+		CopyBufferRect (&objects->outputObj.outputBuf, parentWindow->back, &strip);
+		// Restore the columns exposed right of the window
+	}
+
+	UnionRect (&parentWindow->damage, &parentWindow->damage, &before);
+	UnionRect (&parentWindow->damage, &parentWindow->damage, &after);
+	// Present both the old and new locations
+}
+
 /********************************************************************
 *	LoadHotKey - Load a hotkey value from a window cell				*
 ********************************************************************/
@@ -1177,40 +1445,56 @@ void RedrawWindows (ParentWindow * parentWindow, Objects * objects)
 	int i;								// Loop variables
 	int left = parentWindow->location.X;
 	int top = parentWindow->location.Y;
-	int pitch;
-	PBYTE backData;
-	BYTE check;
+	int size;							// Size of a row of chrome
+	PCHAR_INFO chrome;
 	pWindow window;
 
+	if (!parentWindow->chrome && !ComposeChrome (parentWindow))
+	{
+		return;
+		// Chrome could not be composed
+	}
+
 	G_cell = *(objects->outputObj.outputBuf.buffer + top) + left;
-	backData = parentWindow->backData;
+	chrome = parentWindow->chrome;
 
-	pitch = (SCREEN_WIDTH - parentWindow->width);
+	size = parentWindow->width * sizeof (CHAR_INFO);
 
 	for (i = 0; i < parentWindow->height; i++)
 	{
-		for (G_endCell = G_cell + parentWindow->width; G_cell < G_endCell; G_cell++)
+		if (G_owners)
 		{
-			check = G_cell->Char.AsciiChar = *backData++;
+			PBYTE owner = G_owners [top + i] + left;
+			int j;
 
-			if (check)
+			for (j = 0; j < parentWindow->width; j++)
 			{
-				G_cell->Attributes = parentWindow->border;
+				if (owner [j] == G_owner)
+				{
+					G_cell [j] = chrome [j];
+					// Copy only the cells not occluded by other parent windows
+				}
 			}
+		}
 
-			else
-			{
-				G_cell->Attributes = parentWindow->background;
-			}
+		else
+		{
+			memcpy (G_cell, chrome, size);
+			// Copy a row of composed chrome
 		}
 
-		G_cell += pitch;
+		G_cell += SCREEN_WIDTH;
+		chrome += parentWindow->width;
 	}
 
+	DamageScreen (left, top, left + parentWindow->width, top + parentWindow->height);
+	// The chrome was recopied
+
 	G_endWindow = parentWindow->windows + parentWindow->numWindows;
 
 	for (window = parentWindow->windows; window < G_endWindow; window++)
 	{
+		DAMAGEVISIBLE(window);
 		DrawWindow (window, objects);
 	}
 }
@@ -1224,24 +1508,44 @@ static void DrawWindow (Window * window, Objects * objects)
 	int i;				// Loop variables
 	int windowIndex;	// Index into a given window's buffer	
 	int pitch, winPitch;
+	RECT region;		// Damaged part of the visible region
+	PBYTE owner = NULL;	// Owners of the screen cells being drawn
 	
 	// Initialization block
 	{
 		int xCoord, yCoord;	// Screen coordinates of window
+		RECT visible;		// Visible region of the display
 
-		xCoord = G_location->X + window->windowCoord.X;
-		yCoord = G_location->Y + window->windowCoord.Y;
+		SetRect (&visible, window->xOffset, window->yOffset, window->xOffset + window->windowWidth, window->yOffset + window->windowHeight);
 
-		pitch = SCREEN_WIDTH - window->windowWidth;
-		winPitch = window->width - window->windowWidth; 
+		if (!IntersectRect (&region, &visible, &window->damage))
+		{
+			return;
+			// Nothing visible has changed
+		}
+
+		SetRectEmpty (&window->damage);
 
-		windowIndex = window->yOffset * window->width + window->xOffset;
+		xCoord = G_location->X + window->windowCoord.X + region.left - window->xOffset;
+		yCoord = G_location->Y + window->windowCoord.Y + region.top - window->yOffset;
+
+		DamageScreen (xCoord, yCoord, xCoord + region.right - region.left, yCoord + region.bottom - region.top);
+
+		pitch = SCREEN_WIDTH - (region.right - region.left);
+		winPitch = window->width - (region.right - region.left); 
+
+		windowIndex = region.top * window->width + region.left;
 		G_cell = *(objects->outputObj.outputBuf.buffer + yCoord) + xCoord;
 
 		G_bufCell = window->display.buffer + windowIndex;
+
+		if (G_owners)
+		{
+			owner = G_owners [yCoord] + xCoord;
+		}
 	}
 
-	for (i = 0; i < window->windowHeight; i++)
+	for (i = region.top; i < region.bottom; i++)
 	{
 /*		for (G_endCell = G_cell + window->windowWidth; G_cell < G_endCell; windowIndex++, G_cell++)
 		{
@@ -1250,9 +1554,26 @@ static void DrawWindow (Window * window, Objects * objects)
 
 		windowIndex += winPitch;
 		G_cell += pitch;*/
-		for (G_end = G_bufCell + window->windowWidth; G_bufCell < G_end; G_bufCell++)
+		if (owner)
+		{
+			for (G_end = G_bufCell + (region.right - region.left); G_bufCell < G_end; G_bufCell++, G_cell++, owner++)
+			{
+				if (*owner == G_owner)
+				{
+					*G_cell = G_bufCell->graph;
+					// Copy only the cells not occluded by other parent windows
+				}
+			}
+
+			owner += pitch;
+		}
+
+		else
 		{
-			*G_cell = G_bufCell->graph;
+			for (G_end = G_bufCell + (region.right - region.left); G_bufCell < G_end; G_bufCell++, G_cell++)
+			{
+				*G_cell = G_bufCell->graph;
+			}
 		}
 
 		G_cell += pitch;
@@ -1297,111 +1618,179 @@ static void SwitchFocus (ParentWindow * parentWindow)
 }
 
 /********************************************************************
-*	WriteMessageWord - Write a word to a message box				*
+*	LayoutMessage - Word-wrap a message box's text into runs, once	*
+*		per text and window width									*
 ********************************************************************/
 
-static void WriteMessageWord (Window * window, IO_Descriptor * IO)
+static BOOL LayoutMessage (Window * window)
 {
-	int numSpaces;
-	int wrapBound, length;
-	String text, word;
-
-	IO->text.length = 0;
-
-/*	G_cell*/G_bufCell = GETCURSORCELL(window);
-
-	text = IO->text.text + IO->text.position;
-	word = IO->text.word;
-		
-	numSpaces = SkipSpaces (text, 0);
+	int position, cursor, length, column;
+	int end, limit;
+	String text;
+	pIO_Descriptor IO = window->IO;
+	pTextLayout layout = IO->layout;
 
-//	for (G_endCell = G_cell + numSpaces; G_cell < G_endCell; G_cell++)
-	for (G_end = G_bufCell + numSpaces; G_bufCell < G_end; G_bufCell++)
+	if (layout && layout->text == IO->text.text && layout->numChars == IO->text.numChars && layout->width == window->width)
 	{
-	/*	G_cell*/G_bufCell->graph.Char.AsciiChar = SPACE;
-
-		AdvanceCursor (window, 1);
-		IO->text.position++;
-		text++;
+		return TRUE;
+		// Cached layout is still valid
 	}
 
-	while (!isspace (*text) && *text)
+	if (!layout)
 	{
-		*word++ = *text++;
-		IO->text.length++;
-		IO->text.position++;
+		MALLOC(IO->layout,TextLayout);
+
+		if (!IO->layout)
+		{
+			ERROR_MESSAGE("LayoutMessage failed","1");
+			// Return failure
+		}
+		// Verify that IO's layout field points to valid memory
+
+		layout = IO->layout;
 	}
 
-	*word = END;
+	FREE(layout->runs);
 
-	wrapBound = IO->cursor % window->width;
+	CALLOC(layout->runs,IO->text.numChars + window->height + 1,LayoutRun);
+	// Runs break at most once per word and once per row
 
-	if (wrapBound + IO->text.length >= window->width)
+	if (!layout->runs)
 	{
-		length = window->width - wrapBound;
-
-		AdvanceCursor (window, length);
+		ERROR_MESSAGE("LayoutMessage failed","2");
+		// Return failure
 	}
+	// Verify that layout's runs field points to valid memory
 
-	WriteText (&window->display, IO->text.word, IO->cursor);
+	layout->text = IO->text.text;
+	layout->numChars = IO->text.numChars;
+	layout->width = window->width;
+	layout->numRuns = 0;
 
-	AdvanceCursor (window, IO->text.length);
-}
+	end = IO->text.numChars - 1;
+	limit = window->width * window->height;
 
-/********************************************************************
-*	WriteMessageCharacter - Write a character to a message box		*
-********************************************************************/
+	for (position = cursor = 0, text = IO->text.text; position < end && *text; position += length, cursor += length, text += length)
+	{
+		if (isspace (*text))
+		{
+			length = 1;
+		}
 
-static void WriteMessageCharacter (Window * window, IO_Descriptor * IO)
-{
-	int wrapBound, length;
-	String text, check;
+		else
+		{
+			for (length = 0; !isspace (text [length]) && text [length]; length++);
 
-/*	G_cell*/G_bufCell = GETCURSORCELL(window);
+			column = cursor % window->width;
 
-	text = IO->text.text + IO->text.position;
+			if (column && column + length >= window->width)
+			{
+				cursor += window->width - column;
+				// Wrap the word onto the next row
+			}
+		}
 
-	if (isspace (*text))
-	{
-	/*	G_cell*/G_bufCell->graph.Char.AsciiChar = SPACE;
+		if (cursor + length > limit)
+		{
+			break;
+			// Text beyond the display is never shown
+		}
 
-		AdvanceCursor (window, 1);
-		IO->text.position++;
+		AddLayoutRun (layout, position, cursor, length);
 	}
 
-	else
+	return TRUE;
+	// Return success
+}
+
+/********************************************************************
+*	AddLayoutRun - Place characters of a text layout, splitting		*
+*		them into runs at row boundaries							*
+********************************************************************/
+
+static void AddLayoutRun (TextLayout * layout, int start, int cursor, int length)
+{
+	int extent;	// Characters placed on the current row
+	pLayoutRun run;
+
+	while (length)
 	{
-		if (!IO->text.length)
+		extent = min (length, layout->width - cursor % layout->width);
+		run = layout->runs + layout->numRuns - 1;
+
+		if (layout->numRuns && run->start + run->length == start && run->cursor + run->length == cursor && cursor % layout->width)
 		{
-			check = text;
+			run->length += extent;
+			// Extend the previous run along the same row
+		}
 
-			while (!isspace (*check) && *check)
-			{
-				IO->text.length++;
+		else
+		{
+			run++;
 
-				check++;
-			}
+			run->start = start;
+			run->cursor = cursor;
+			run->length = extent;
 
-			wrapBound = IO->cursor % window->width;
+			layout->numRuns++;
+		}
 
-			if (wrapBound + IO->text.length >= window->width)
-			{
-				length = window->width - wrapBound;
-				IO->text.limit += length;
+		start += extent;
+		cursor += extent;
+		length -= extent;
+	}
+}
 
-				AdvanceCursor (window, length);
+/********************************************************************
+*	RevealMessage - Write a message box's laid-out text up to a		*
+*		position													*
+********************************************************************/
 
-			/*	G_cell*/G_bufCell = GETCURSORCELL(window);
-			}
+static void RevealMessage (Window * window, int position)
+{
+	int low, high, middle;
+	int first, last;
+	String text;
+	pIO_Descriptor IO = window->IO;
+	pTextLayout layout = IO->layout;
+	pLayoutRun run;
+
+	for (low = 0, high = layout->numRuns; low < high; )
+	{
+		middle = (low + high) >> 1;
+
+		if (layout->runs [middle].start + layout->runs [middle].length <= IO->text.position)
+		{
+			low = middle + 1;
+		}
+
+		else
+		{
+			high = middle;
 		}
+	}
+	// Find the first run not yet fully revealed
+
+	for (run = layout->runs + low; run < layout->runs + layout->numRuns && run->start < position; run++)
+	{
+		first = max (run->start, IO->text.position);
+		last = min (run->start + run->length, position);
 
-	/*	G_cell*/G_bufCell->graph.Char.AsciiChar = *text;
+		G_bufCell = window->display.buffer + run->cursor + (first - run->start);
+		text = IO->text.text + first;
 
-		AdvanceCursor (window, 1);
-		IO->text.position++;
-		
-		IO->text.length--;
+		for (G_end = G_bufCell + (last - first); G_bufCell < G_end; G_bufCell++, text++)
+		{
+			G_bufCell->graph.Char.AsciiChar = isspace (*text) ? SPACE : *text;
+		}
+		// Blit the newly revealed part of the run
+
+		DamageSpan (window, run->cursor + (first - run->start), last - first);
+
+		IO->cursor = run->cursor + (last - run->start);
 	}
+
+	IO->text.position = position;
 }
 
 /********************************************************************
@@ -1436,6 +1825,7 @@ static void HighlightMenuItem (Window * window, int index)
 
 		G_bufCell += pitch;
 	}
+	DamageWindow (window, menuItem->location.X, menuItem->location.Y, menuItem->location.X + menuItem->width, menuItem->location.Y + menuItem->height);
 }
 
 /********************************************************************
@@ -1470,6 +1860,7 @@ static void RemoveHighlight (Window * window, int index)
 
 		G_bufCell += pitch;
 	}
+	DamageWindow (window, menuItem->location.X, menuItem->location.Y, menuItem->location.X + menuItem->width, menuItem->location.Y + menuItem->height);
 }
 
 /*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
@@ -1489,6 +1880,26 @@ void ScrollWindows (Window * window, HorzScroll horzMode, VertScroll vertMode)
 	assert (window);
 	// Verify that window points to valid memory
 
+	if (window->view)	// Ensure that window is not virtual
+	{
+		long row = window->view->row, column = window->view->column;
+
+		if (FLAGSET(window->state,XSCROLLABLE))
+		{
+			column += (horzMode == kRight) - (horzMode == kLeft);
+		}
+
+		if (FLAGSET(window->state,YSCROLLABLE))
+		{
+			row += (vertMode == kDown) - (vertMode == kUp);
+		}
+
+		ScrollVirtualWindow (window, row, column);
+
+		return;
+		// Virtual windows scroll over their content, not their display
+	}
+
 	switch (horzMode)	// Get the horizontal scroll mode
 	{
 	case kLeft:			// Left case
@@ -1603,16 +2014,18 @@ int ToggleMenuItemLeft (voidStar data, dataType type, long lParam)
 	
 	// Initialization block
 	{
-		int length = strlen (*GETMENUITEMTEXT(menuItem));
+		int length = GetStringLength (*GETMENUITEMTEXT(menuItem));
 		
 		offset = menuItem->location.Y * window->width + menuItem->location.X;
 	
 		ClearText (&window->display, offset, length);
+		DamageSpan (window, offset, length);
 	}
 
 	*entry = (*entry + 1) % menuItem->numItems;
 
-	WriteText (&window->display, *GETMENUITEMTEXT(menuItem), offset);
+	WriteText (&window->display, GetString (*GETMENUITEMTEXT(menuItem)), offset);
+	DamageSpan (window, offset, GetStringLength (*GETMENUITEMTEXT(menuItem)));
 
 	return 0;
 }
@@ -1630,16 +2043,18 @@ int ToggleMenuItemRight (voidStar data, dataType type, long lParam)
 	
 	// Initialization block
 	{
-		int length = strlen (*GETMENUITEMTEXT(menuItem));
+		int length = GetStringLength (*GETMENUITEMTEXT(menuItem));
 		
 		offset = menuItem->location.Y * window->width + menuItem->location.X;
 	
 		ClearText (&window->display, offset, length);
+		DamageSpan (window, offset, length);
 	}
 
 	*entry = (*entry ? *entry : menuItem->numItems) - 1;
 
-	WriteText (&window->display, *GETMENUITEMTEXT(menuItem), offset);
+	WriteText (&window->display, GetString (*GETMENUITEMTEXT(menuItem)), offset);
+	DamageSpan (window, offset, GetStringLength (*GETMENUITEMTEXT(menuItem)));
 
 	return 0;
 }
@@ -1647,99 +2062,1588 @@ int ToggleMenuItemRight (voidStar data, dataType type, long lParam)
 /*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
 /********************************************************************
 *																	*
-*							Interface IO							*
+*							Virtual windows							*
 *																	*
 ********************************************************************/
 /*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
 
 /********************************************************************
-*	LoadVisuals - Load visual data into a basic window				*
+*	VirtualizeWindow - Make a window produce its content on demand	*
+*		from a source callback										*
 ********************************************************************/
 
+BOOL VirtualizeWindow (Window * window, void (* source) (voidStar data, long row, long column, pCell cells, int count), voidStar data, long numRows, long numColumns, int overscan)
+{
+	assert (window && source && overscan >= 0);
+	// Verify that window and source point to valid memory, and that overscan is not negative
+
+	if (!window->view)
+	{
+		MALLOC(window->view,VirtualView);
+
+		if (!window->view)
+		{
+			ERROR_MESSAGE("VirtualizeWindow failed","1");
+			// Return failure
+		}
+		// Verify that window's view field points to valid memory
+	}
+	// Reuse the view if window is already virtual
+
+	DeleteOutputBuffer (&window->display);
+	// Release the full display before caching only part of it
+
+	window->width = window->windowWidth;
+	window->height = window->windowHeight + 2 * overscan;
+	// The display only caches the visible region plus the overscan
+
+	CALLOC(window->display.buffer,window->width * window->height,Cell);
+
+	if (!window->display.buffer)
+	{
+		FREE(window->view);
+
+		ERROR_MESSAGE("VirtualizeWindow failed","2");
+		// Return failure
+	}
+	// Verify that window's display field's buffer field points to valid memory
+
+	window->display.bufSharing = kSingleOwner;
+
+	window->view->source = source;
+	window->view->data = data;
+	window->view->numRows = numRows;
+	window->view->numColumns = numColumns;
+	window->view->overscan = overscan;
+
+	window->xOffset = window->yOffset = 0;
+
+	FillVirtualRows (window, 0, window->height);
+	DAMAGEWINDOW(window);
+
+	return TRUE;
+	// Return success
+}
+
 /********************************************************************
-*	LoadMessage - Load a message into a message box					*
+*	ScrollVirtualWindow - Show a virtual window's content from a	*
+*		given row and column										*
 ********************************************************************/
 
+void ScrollVirtualWindow (Window * window, long row, long column)
+{
+	pVirtualView view;
+
+	assert (window && window->view);
+	// Verify that window and window's view field point to valid memory
+
+	view = window->view;
+
+	row = min (row, view->numRows - window->windowHeight);
+	row = max (row, 0);
+	column = min (column, view->numColumns - window->windowWidth);
+	column = max (column, 0);
+	// Keep the display region within the content
+
+	if (row == view->row && column == view->column)
+	{
+		return;
+		// Nothing to scroll
+	}
+
+	view->row = row;
+
+	if (column != view->column)
+	{
+		view->column = column;
+		view->firstRow = max (row - view->overscan, 0);
+
+		FillVirtualRows (window, 0, window->height);
+		// Cached rows hold the old columns, so produce them all again
+	}
+
+	else if (row < view->firstRow || row + window->windowHeight > view->firstRow + window->height)
+	{
+		ShiftVirtualCache (window, max (row - view->overscan, 0));
+		// Display region left the cache, so recenter it
+	}
+
+	window->yOffset = (int) (row - view->firstRow);
+
+	DAMAGEVISIBLE(window);
+}
+
 /********************************************************************
-*	LoadMenuItems - Load menu items into a menu						*
+*	SetVirtualRows - Change the row count of a virtual window's		*
+*		content														*
 ********************************************************************/
 
+void SetVirtualRows (Window * window, long numRows)
+{
+	long first;	// First content row whose cells changed
+
+	assert (window && window->view);
+	// Verify that window and window's view field point to valid memory
+
+	first = min (numRows, window->view->numRows) - window->view->firstRow;
+
+	window->view->numRows = numRows;
+
+	if (first < window->height)
+	{
+		first = max (first, 0);
+
+		FillVirtualRows (window, (int) first, window->height - (int) first);
+		DamageWindow (window, 0, (int) first, window->width, window->height);
+		// Produce the cached rows that appeared or vanished
+	}
+}
+
 /********************************************************************
-*	SaveMessage - Save the message in the edit box					*
+*	RefreshVirtualWindow - Produce a virtual window's content		*
+*		again														*
 ********************************************************************/
 
-void SaveMessage (Window * window)
+void RefreshVirtualWindow (Window * window)
 {
-	pIO_Descriptor IO;
-	voidStar data;
-	dataType type;
+	assert (window && window->view);
+	// Verify that window and window's view field point to valid memory
 
-	assert (window);
-	// Verify that window points to valid memory
+	FillVirtualRows (window, 0, window->height);
+	DAMAGEWINDOW(window);
+}
 
-	if (!window->dataADT.data.data || window->mode != kEditBox)	// Ensure that window's dataADT field's data field's data field points to something and that window's mode is edit box
+/********************************************************************
+*	ShiftVirtualCache - Move a virtual window's cache to begin at a	*
+*		given content row											*
+********************************************************************/
+
+static void ShiftVirtualCache (Window * window, long firstRow)
+{
+	long delta = firstRow - window->view->firstRow;
+	int keep;							// Count of cached rows still needed
+	int size = window->width * sizeof (Cell);	// Size of a cached row
+
+	window->view->firstRow = firstRow;
+
+	if (delta > 0 && delta < window->height)
 	{
-		return;
+		keep = window->height - (int) delta;
+
+		memmove (window->display.buffer, window->display.buffer + delta * window->width, keep * size);
+		FillVirtualRows (window, keep, (int) delta);
+		// Scrolled down, so keep the lower rows and produce the rest
 	}
 
-	IO = window->IO;
+	else if (delta < 0 && -delta < window->height)
+	{
+		keep = window->height + (int) delta;
 
-	switch (IO->readMode)
+		memmove (window->display.buffer - delta * window->width, window->display.buffer, keep * size);
+		FillVirtualRows (window, 0, (int) -delta);
+		// Scrolled up, so keep the upper rows and produce the rest
+	}
+
+	else
 	{
-	case kReadAll:
-	case kAlphaOnly:
-	case kPrintOnly:
-		// Save block
-		{
-			String string;
+		FillVirtualRows (window, 0, window->height);
+		// Jumped past the cache, so produce every row
+	}
+}
 
-			CALLOC(string,strlen (IO->text.text),char);
+/********************************************************************
+*	FillVirtualRows - Produce rows of a virtual window's cache		*
+********************************************************************/
 
-			strcpy (string, IO->text.text);
+static void FillVirtualRows (Window * window, int cacheRow, int count)
+{
+	long row;	// Content row being produced
+	pVirtualView view = window->view;
 
-			data = string;
-			type = kChar;
-		}
+	G_bufCell = window->display.buffer + cacheRow * window->width;
 
-		break;	// Break out of switch statement
+	for (row = view->firstRow + cacheRow; count--; row++)
+	{
+		pCell cells = G_bufCell;
 
-	case kNumeric:
-		// Save block
+		for (G_end = G_bufCell + window->width; G_bufCell < G_end; G_bufCell++)
 		{
-			intStar number;
+			G_bufCell->graph.Char.AsciiChar = SPACE;
+			G_bufCell->graph.Attributes = window->background;
+		}
+		// Blank the row, in case source writes fewer cells
 
-			MALLOC(number,int);
+		if (row < view->numRows)
+		{
+			view->source (view->data, row, view->column, cells, (int) min (window->width, view->numColumns - view->column));
+			// Let the source write the visible columns of the row
+		}
+	}
+}
 
-			*number = atoi (IO->text.text);
+/*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
+/********************************************************************
+*																	*
+*							Log viewer								*
+*																	*
+********************************************************************/
+/*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
 
-			data = number;
-			type = kChar;
-		}
+/********************************************************************
+*	OpenLogView - Show a memory-mapped log file in a message box	*
+********************************************************************/
 
-		break;	// Break out of switch statement
+BOOL OpenLogView (Window * window, String filename, int overscan)
+{
+	pLogView log;
+
+	assert (window && window->IO && filename);
+	// Verify that window, window's IO field, and filename point to valid memory
+
+	CALLOC(log,1,LogView);
+
+	if (!log)
+	{
+		ERROR_MESSAGE("OpenLogView failed","1");
+		// Return failure
 	}
+	// Verify that log was allocated
 
-	switch (window->dataADT.type)
+	log->fileH = CreateFile (filename, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, NULL, OPEN_EXISTING, 0, NULL);
+
+	if (log->fileH == INVALID_HANDLE_VALUE)
 	{
-	case kList:
-		AppendListNode (window->dataADT.data.list, data, type);
+		FREE(log);
 
-		break;	// Break out of switch statement
+		ERROR_MESSAGE("OpenLogView failed","2");
+		// Return failure
+	}
+	// Share writing, so the log's owner can keep appending
 
-	case kQueue:
-		EnqueueQueueNode (window->dataADT.data.queue, data, type);
+	CALLOC(log->chunks [0],LOG_CHUNK,LONGLONG);
 
-		break;	// Break out of switch statement
+	if (!log->chunks [0] || !MapLogFile (log))
+	{
+		FREE(log->chunks [0]);
+		CloseHandle (log->fileH);
+		FREE(log);
 
-	case kStack:
-		PushStackNode (window->dataADT.data.stack, data, type);
+		ERROR_MESSAGE("OpenLogView failed","3");
+		// Return failure
+	}
+	// The first line always begins at offset 0
 
-		break;	// Break out of switch statement
+	InitializeCriticalSection (&log->lock);
 
-	default:
-		NORET_MESSAGE("Unsupported ADTStyle: SaveMessage failed","1");
+	log->wake = CreateEvent (NULL, FALSE, FALSE, NULL);
+	log->active = TRUE;
+
+	window->IO->log = log;
+
+	if (!log->wake || !VirtualizeWindow (window, LogViewSource, log, 0, LOG_COLUMNS, overscan))
+	{
+		CloseLogView (window);
+
+		ERROR_MESSAGE("OpenLogView failed","4");
+		// Return failure
+	}
+
+	log->thread = CreateThread (NULL, 0, LogIndexThread, log, 0, NULL);
+
+	if (!log->thread)
+	{
+		CloseLogView (window);
+
+		ERROR_MESSAGE("OpenLogView failed","5");
 		// Return failure
 	}
+	// Index in the background, so opening is immediate
+
+	return TRUE;
+	// Return success
+}
+
+/********************************************************************
+*	CloseLogView - Stop showing a log file in a message box			*
+********************************************************************/
+
+void CloseLogView (Window * window)
+{
+	int i;	// Loop variable
+	pLogView log;
+
+	assert (window && window->IO);
+	// Verify that window and window's IO field point to valid memory
+
+	log = window->IO->log;
+
+	if (!log)	// Ensure that window shows a log
+	{
+		return;
+	}
+
+	if (log->thread)	// Ensure that the thread is running
+	{
+		InterlockedExchange (&log->active, FALSE);
+		SetEvent (log->wake);
+		// Ask the thread to stop
+
+		WaitForSingleObject (log->thread, INFINITE);
+		CloseHandle (log->thread);
+	}
+
+	if (log->wake)	// Ensure that log's wake field is a valid handle
+	{
+		CloseHandle (log->wake);
+	}
+
+	DeleteCriticalSection (&log->lock);
+
+	if (log->base)	// Ensure that log's base field points to something
+	{
+		UnmapViewOfFile (log->base);
+		CloseHandle (log->mapH);
+	}
+
+	CloseHandle (log->fileH);
+
+	for (i = 0; i < LOG_CHUNKS && log->chunks [i]; i++)
+	{
+		FREE(log->chunks [i]);
+	}
+
+	FREE(window->IO->log);
+}
+
+/********************************************************************
+*	JumpToLogLine - Scroll a log viewer to a line					*
+********************************************************************/
+
+void JumpToLogLine (Window * window, long line)
+{
+	assert (window && window->view && window->IO && window->IO->log);
+	// Verify that window, window's view field, window's IO field, and window's IO field's log field point to valid memory
+
+	ScrollVirtualWindow (window, line, window->view->column);
+	// The sparse index finds any line after a scan of at most LOG_STRIDE lines
+}
+
+/********************************************************************
+*	UpdateLogView - Follow a log file as it grows					*
+********************************************************************/
+
+static void UpdateLogView (Window * window)
+{
+	BOOL following;		// Indicates whether the last row is shown
+	BOOL grown = FALSE;	// Indicates whether the file grew
+	long numRows;
+	LARGE_INTEGER size;
+	pLogView log = window->IO->log;
+
+	if (GetFileSizeEx (log->fileH, &size) && size.QuadPart > log->size)
+	{
+		grown = TRUE;
+
+		EnterCriticalSection (&log->lock);
+
+		MapLogFile (log);
+
+		LeaveCriticalSection (&log->lock);
+
+		SetEvent (log->wake);
+		// Let the thread index the new bytes
+	}
+
+	numRows = log->numRows;
+
+	if (numRows != window->view->numRows)
+	{
+		following = window->view->row + window->windowHeight >= window->view->numRows;
+
+		SetVirtualRows (window, numRows);
+
+		if (following)
+		{
+			ScrollVirtualWindow (window, numRows, window->view->column);
+			// Tail the log if its end was showing
+		}
+	}
+
+	else if (grown && numRows)
+	{
+		RefreshVirtualWindow (window);
+		// The partial last line may have grown
+	}
+}
+
+/********************************************************************
+*	MapLogFile - Map the current contents of a log file				*
+********************************************************************/
+
+static BOOL MapLogFile (LogView * log)
+{
+	HANDLE mapH;
+	PBYTE base;
+	LARGE_INTEGER size;
+
+	if (!GetFileSizeEx (log->fileH, &size) || !size.QuadPart)
+	{
+		return size.QuadPart == 0;
+		// An empty file cannot be mapped, but is still valid
+	}
+
+	mapH = CreateFileMapping (log->fileH, NULL, PAGE_READONLY, 0, 0, NULL);
+
+	if (!mapH)
+	{
+		return FALSE;
+	}
+
+	base = MapViewOfFile (mapH, FILE_MAP_READ, 0, 0, 0);
+
+	if (!base)
+	{
+		CloseHandle (mapH);
+
+		return FALSE;
+	}
+
+	if (log->base)	// Ensure that log's base field points to something
+	{
+		UnmapViewOfFile (log->base);
+		CloseHandle (log->mapH);
+	}
+
+	log->mapH = mapH;
+	log->base = base;
+	log->size = size.QuadPart;
+
+	return TRUE;
+}
+
+/********************************************************************
+*	FindLogLine - Find the offset of a line in a log file			*
+********************************************************************/
+
+static LONGLONG FindLogLine (LogView * log, long row)
+{
+	long entry = row / LOG_STRIDE;
+	LONGLONG offset;
+	PBYTE next;
+
+	if (row == log->lastRow + 1 && log->lastRow >= 0 && row % LOG_STRIDE)
+	{
+		offset = log->lastLine;
+		row = 1;
+		// Continue from the row found last, as scrolling does
+	}
+
+	else
+	{
+		offset = log->chunks [entry / LOG_CHUNK] [entry % LOG_CHUNK];
+		row %= LOG_STRIDE;
+	}
+
+	for (; row; row--)
+	{
+		next = memchr (log->base + offset, '\n', (size_t) (log->size - offset));
+
+		if (!next)
+		{
+			break;
+			// Row lies past the indexed lines
+		}
+
+		offset = next - log->base + 1;
+	}
+
+	return offset;
+}
+
+/********************************************************************
+*	LogViewSource - Produce the cells of a log line					*
+********************************************************************/
+
+static void LogViewSource (voidStar data, long row, long column, pCell cells, int count)
+{
+	pLogView log = (pLogView) data;
+	LONGLONG offset;
+	PBYTE text, end;
+
+	EnterCriticalSection (&log->lock);
+
+	offset = FindLogLine (log, row);
+
+	log->lastRow = row;
+	log->lastLine = offset;
+
+	text = log->base + offset;
+	end = memchr (text, '\n', (size_t) (log->size - offset));
+
+	if (!end)
+	{
+		end = log->base + log->size;
+		// The last line may be partial
+	}
+
+	for (text += column; text < end && count--; text++, cells++)
+	{
+		cells->graph.Char.AsciiChar = isprint (*text) ? *text : SPACE;
+	}
+	// Write only the visible columns of the line
+
+	LeaveCriticalSection (&log->lock);
+}
+
+/********************************************************************
+*	LogIndexThread - Build the sparse line index of a log file		*
+********************************************************************/
+
+static DWORD WINAPI LogIndexThread (LPVOID data)
+{
+	pLogView log = (pLogView) data;
+	LONGLONG start = 0;	// Offset of the line being indexed
+	LONGLONG end;		// End of the block being indexed
+	LONGLONG * chunk;
+	long entry;
+	PBYTE next;
+
+	while (log->active)
+	{
+		EnterCriticalSection (&log->lock);
+
+		end = min (log->size, log->indexed + LOG_BLOCK);
+
+		while (log->indexed < end)
+		{
+			next = memchr (log->base + log->indexed, '\n', (size_t) (end - log->indexed));
+
+			if (!next)
+			{
+				log->indexed = end;
+
+				break;
+			}
+
+			log->indexed = start = next - log->base + 1;
+			log->lines++;
+
+			if (!(log->lines % LOG_STRIDE))
+			{
+				entry = log->lines / LOG_STRIDE;
+
+				if (entry / LOG_CHUNK >= LOG_CHUNKS)
+				{
+					log->indexed = log->size;
+
+					break;
+					// Index is full, so stop adding lines
+				}
+
+				chunk = log->chunks [entry / LOG_CHUNK];
+
+				if (!chunk)
+				{
+					CALLOC(chunk,LOG_CHUNK,LONGLONG);
+
+					if (!chunk)
+					{
+						log->indexed = log->size;
+
+						break;
+						// Out of memory, so stop adding lines
+					}
+
+					log->chunks [entry / LOG_CHUNK] = chunk;
+				}
+
+				chunk [entry % LOG_CHUNK] = start;
+				// Record every LOG_STRIDE-th line
+			}
+		}
+
+		LeaveCriticalSection (&log->lock);
+
+		InterlockedExchange (&log->numRows, log->lines + (start < log->indexed));
+		// Publish the rows after their index entries
+
+		if (log->indexed == log->size)
+		{
+			WaitForSingleObject (log->wake, LOG_WAIT);
+			// Wait for the file to grow, or to be told to stop
+		}
+	}
+
+	return 0;
+}
+
+/*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
+/********************************************************************
+*																	*
+*							Damage tracking							*
+*																	*
+********************************************************************/
+/*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
+
+/********************************************************************
+*	DamageWindow - Mark a region of a window's display as changed	*
+********************************************************************/
+
+void DamageWindow (Window * window, int left, int top, int right, int bottom)
+{
+	RECT rect;	// Region being damaged
+
+	assert (window);
+	// Verify that window points to valid memory
+
+	SetRect (&rect, left, top, right, bottom);
+
+	UnionRect (&window->damage, &window->damage, &rect);
+	// Grow the damage to cover the region
+}
+
+/********************************************************************
+*	DamageSpan - Mark a run of cells in a window's display as		*
+*		changed														*
+********************************************************************/
+
+static void DamageSpan (Window * window, int index, int extent)
+{
+	int row = index / window->width, column = index % window->width;
+
+	if (extent <= 0)
+	{
+		return;
+		// Nothing to damage
+	}
+
+	if (column + extent <= window->width)
+	{
+		DamageWindow (window, column, row, column + extent, row + 1);
+		// Span lies on a single row
+	}
+
+	else
+	{
+		DamageWindow (window, 0, row, window->width, (index + extent - 1) / window->width + 1);
+		// Span wraps, so damage the full width of its rows
+	}
+}
+
+/********************************************************************
+*	DamageScreen - Mark a region of the screen as changed			*
+********************************************************************/
+
+static void DamageScreen (int left, int top, int right, int bottom)
+{
+	RECT rect;	// Region being damaged
+
+	if (G_damage)
+	{
+		SetRect (&rect, left, top, right, bottom);
+
+		UnionRect (G_damage, G_damage, &rect);
+		// Grow the damage to cover the region
+	}
+}
+
+/*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
+/********************************************************************
+*																	*
+*							Hotkey dispatch							*
+*																	*
+********************************************************************/
+/*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
+
+/********************************************************************
+*	FindHotKey - Find the key bound to a keycode, searching the		*
+*		focus, window and global scopes in turn, from a given one	*
+********************************************************************/
+
+Key * FindHotKey (ParentWindow const * parentWindow, int keycode, HotKeyScope first, HotKeyScope * scope)
+{
+	pWindow window;
+	pKey key = NULL;
+	HotKeyScope found;
+
+	assert (parentWindow);
+	// Verify that parentWindow points to valid memory
+
+	window = GETFOCUS(parentWindow);
+
+	for (found = first; found < kHotKeyScopesCount && !key; found++)
+	{
+		switch (found)
+		{
+		case kFocusScope:
+			key = window->mode == kMenu && window->menu ? GETHOTKEY(window->menu->table,keycode) : NULL;
+			break;	// Break out of switch statement
+
+		case kWindowScope:
+			key = GETHOTKEY(parentWindow->hotKeys,keycode);
+			break;	// Break out of switch statement
+
+		case kGlobalScope:
+			key = GETHOTKEY(parentWindow->globalKeys,keycode);
+			break;	// Break out of switch statement
+		}
+	}
+
+	if (key && scope)
+	{
+		*scope = found - 1;
+	}
+
+	return key;
+}
+
+/********************************************************************
+*	SetGlobalHotKeys - Share a dispatch table with a parent window	*
+********************************************************************/
+
+void SetGlobalHotKeys (ParentWindow * parentWindow, HotKeyTable * table)
+{
+	assert (parentWindow);
+	// Verify that parentWindow points to valid memory
+
+	parentWindow->globalKeys = table;
+}
+
+/********************************************************************
+*	FocusCommand - Switch focus when the focus key is pressed		*
+********************************************************************/
+
+static int FocusCommand (voidStar data, dataType type, long lParam)
+{
+	SwitchFocus ((pParentWindow) data);
+
+	return TRUE;
+}
+
+/********************************************************************
+*	CloseCommand - Deactivate when the close key is pressed			*
+********************************************************************/
+
+static int CloseCommand (voidStar data, dataType type, long lParam)
+{
+	DeactivateWindows ((pParentWindow) data);
+
+	return TRUE;
+}
+
+/********************************************************************
+*	ConfirmCommand - Save messages when the confirm key is pressed	*
+********************************************************************/
+
+static int ConfirmCommand (voidStar data, dataType type, long lParam)
+{
+	pParentWindow parentWindow = (pParentWindow) data;
+	pWindow window;
+
+	for (window = parentWindow->windows, G_endWindow = window + parentWindow->numWindows; window < G_endWindow; window++)
+	{
+		if (HasFocus (window) || FLAGSET(window->state,SAVEWITHOUTFOCUS))
+		{
+			SaveMessage (window);
+		}
+	}
+
+	return TRUE;
+}
+
+/*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
+/********************************************************************
+*																	*
+*							Window management						*
+*																	*
+********************************************************************/
+/*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
+
+/********************************************************************
+*	InitWindowManager - Initialize a WindowManager structure		*
+********************************************************************/
+
+void InitWindowManager (WindowManager * manager, ScreenBuffer * back)
+{
+	assert (manager);
+	// Verify that manager points to valid memory
+
+	ZeroMemory (manager, sizeof (WindowManager));
+
+	memset (manager->owners, NO_OWNER, sizeof (manager->owners));
+	// No cell is covered yet
+
+	manager->top = -1;
+	manager->back = back;
+}
+
+/********************************************************************
+*	AddParentWindow - Stack a parent window on top of the others	*
+********************************************************************/
+
+BOOL AddParentWindow (WindowManager * manager, ParentWindow * parentWindow)
+{
+	assert (manager && parentWindow);
+	// Verify that manager and parentWindow point to valid memory
+
+	if (manager->numParents == MAX_PARENTWINDOWS || FindParentWindow (manager, parentWindow) != -1)
+	{
+		ERROR_MESSAGE("AddParentWindow failed","1");
+		// Return failure
+	}
+
+	manager->parents [manager->numParents++] = parentWindow;
+	manager->dirty = TRUE;
+
+	return TRUE;
+	// Return success
+}
+
+/********************************************************************
+*	RemoveParentWindow - Remove a parent window from the stack		*
+********************************************************************/
+
+void RemoveParentWindow (WindowManager * manager, ParentWindow * parentWindow)
+{
+	int index;	// Stack index of parentWindow
+
+	assert (manager && parentWindow);
+	// Verify that manager and parentWindow point to valid memory
+
+	index = FindParentWindow (manager, parentWindow);
+
+	if (index == -1)
+	{
+		NORET_MESSAGE("RemoveParentWindow failed","1");
+		// Return failure
+	}
+
+	memmove (manager->parents + index, manager->parents + index + 1, (--manager->numParents - index) * sizeof (pParentWindow));
+	// Close the gap left in the stack
+
+	manager->dirty = TRUE;
+}
+
+/********************************************************************
+*	RaiseParentWindow - Move a parent window to the top of the		*
+*		stack														*
+********************************************************************/
+
+void RaiseParentWindow (WindowManager * manager, ParentWindow * parentWindow)
+{
+	int index;	// Stack index of parentWindow
+
+	assert (manager && parentWindow);
+	// Verify that manager and parentWindow point to valid memory
+
+	index = FindParentWindow (manager, parentWindow);
+
+	if (index == -1)
+	{
+		NORET_MESSAGE("RaiseParentWindow failed","1");
+		// Return failure
+	}
+
+	if (index == manager->numParents - 1)
+	{
+		return;
+		// Already on top
+	}
+
+	memmove (manager->parents + index, manager->parents + index + 1, (manager->numParents - index - 1) * sizeof (pParentWindow));
+	manager->parents [manager->numParents - 1] = parentWindow;
+	// Shift the windows above down and place parentWindow on top
+
+	manager->dirty = TRUE;
+}
+
+/********************************************************************
+*	HitTestParentWindow - Find the topmost parent window covering a	*
+*		screen cell													*
+********************************************************************/
+
+pParentWindow HitTestParentWindow (WindowManager const * manager, int x, int y)
+{
+	BYTE owner;	// Index of parent window owning the cell
+
+	assert (manager);
+	// Verify that manager points to valid memory
+
+	if (x < 0 || x >= SCREEN_WIDTH || y < 0 || y >= SCREEN_HEIGHT)
+	{
+		return NULL;
+		// Cell lies off the screen
+	}
+
+	owner = manager->owners [y] [x];
+
+	return owner == NO_OWNER ? NULL : manager->parents [owner];
+}
+
+/********************************************************************
+*	UpdateWindowManager - Route input to the topmost parent window	*
+*		and redraw the visible parts of the stack					*
+********************************************************************/
+
+BOOL UpdateWindowManager (WindowManager * manager, Objects * objects, voidStar data)
+{
+	pParentWindow top, hit;
+	RECT rect;	// Screen region of a raised parent window
+
+	assert (manager && objects);
+	// Verify that manager and objects point to valid memory
+
+	if (manager->dirty)
+	{
+		IndexParentWindows (manager);
+		RedrawParentWindows (manager, objects);
+	}
+
+	if (manager->top == -1)
+	{
+		return FALSE;
+		// No parent window remains active
+	}
+
+	top = manager->parents [manager->top];
+
+	G_location = &top->location;
+	G_damage = &top->damage;
+	G_manager = manager;
+	// Only the topmost parent window receives input and draws directly
+
+	Update (top, objects, data);
+
+	G_manager = NULL;
+	// Drags have already repaired the cells they exposed
+
+	if (!WindowsActive (top))
+	{
+		manager->dirty = TRUE;
+		// Closing the top window changes what the others expose
+	}
+
+	else if (LeftMouseButtonIsDown (&objects->inputObj) && !FLAGSET(top->state,GRABBED))
+	{
+		hit = HitTestParentWindow (manager, GetMouseXPos (&objects->inputObj), GetMouseYPos (&objects->inputObj));
+
+		if (hit && hit != top)
+		{
+			RaiseParentWindow (manager, hit);
+			// Clicking a lower window brings it to the top
+
+			SetRect (&rect, hit->location.X, hit->location.Y, hit->location.X + hit->width, hit->location.Y + hit->height);
+
+			IndexParentWindows (manager);
+			RepairParentWindows (manager, objects, &rect);
+			UpdateScreenRect (&objects->outputObj, &rect);
+			// Only the raised window's cells change owner
+		}
+	}
+
+	if (manager->dirty)
+	{
+		IndexParentWindows (manager);
+		RedrawParentWindows (manager, objects);
+	}
+
+	return manager->top != -1;
+}
+
+/********************************************************************
+*	FindParentWindow - Find the stack index of a parent window		*
+********************************************************************/
+
+static int FindParentWindow (WindowManager const * manager, ParentWindow const * parentWindow)
+{
+	int i;	// Loop variable
+
+	for (i = 0; i < manager->numParents; i++)
+	{
+		if (manager->parents [i] == parentWindow)
+		{
+			return i;
+			// Return index of parentWindow
+		}
+	}
+
+	return -1;
+	// Return failure
+}
+
+/********************************************************************
+*	IndexParentWindows - Assign each screen cell to the topmost		*
+*		parent window covering it									*
+********************************************************************/
+
+static void IndexParentWindows (WindowManager * manager)
+{
+	int i, x, y;	// Loop variables
+	int left, top, right, bottom;
+	int remaining = SCREEN_WIDTH * SCREEN_HEIGHT;
+	pParentWindow parentWindow;
+
+	memset (manager->owners, NO_OWNER, sizeof (manager->owners));
+	ZeroMemory (manager->visibleCells, sizeof (manager->visibleCells));
+
+	manager->top = -1;
+
+	for (i = manager->numParents - 1; i >= 0 && remaining; i--)
+	{
+		parentWindow = manager->parents [i];
+
+		if (!WindowsActive (parentWindow))
+		{
+			continue;
+			// Inactive parent windows cover nothing
+		}
+
+		if (manager->top == -1)
+		{
+			manager->top = i;
+		}
+
+		left = max (parentWindow->location.X, 0);
+		top = max (parentWindow->location.Y, 0);
+		right = min (parentWindow->location.X + parentWindow->width, SCREEN_WIDTH);
+		bottom = min (parentWindow->location.Y + parentWindow->height, SCREEN_HEIGHT);
+
+		for (y = top; y < bottom; y++)
+		{
+			for (x = left; x < right; x++)
+			{
+				if (manager->owners [y] [x] == NO_OWNER)
+				{
+					manager->owners [y] [x] = (BYTE) i;
+					manager->visibleCells [i]++;
+
+					remaining--;
+				}
+			}
+		}
+	}
+	// Claim cells from the top down, stopping once the screen is covered
+
+	manager->dirty = FALSE;
+}
+
+/********************************************************************
+*	RedrawParentWindows - Draw the visible parts of the stacked		*
+*		parent windows												*
+********************************************************************/
+
+static void RedrawParentWindows (WindowManager * manager, Objects * objects)
+{
+	int i;	// Loop variable
+
+	if (manager->back)
+	{
+		CopyBuffer (&objects->outputObj.outputBuf, manager->back);
+		// Restore the surface the stack is drawn against
+	}
+
+	G_owners = manager->owners;
+	G_damage = NULL;
+
+	for (i = 0; i < manager->numParents; i++)
+	{
+		if (manager->visibleCells [i])
+		{
+			G_owner = (BYTE) i;
+			G_location = &manager->parents [i]->location;
+
+			RedrawWindows (manager->parents [i], objects);
+			// Hidden windows and occluded cells are skipped
+		}
+	}
+
+	G_owners = NULL;
+	G_location = NULL;
+
+	UpdateScreen (&objects->outputObj);
+}
+
+/********************************************************************
+*	RepairParentWindows - Redraw the stacked parent windows within	*
+*		a region of the screen										*
+********************************************************************/
+
+static void RepairParentWindows (WindowManager * manager, Objects * objects, RECT const * rect)
+{
+	BYTE clip [SCREEN_HEIGHT] [SCREEN_WIDTH];	// Owner table limited to the region
+	RECT region;								// Region clipped to the screen
+	RECT bounds;								// Screen region of a parent window
+	PCOORD location = G_location;
+	PRECT damage = G_damage;
+	pWindow endWindow = G_endWindow;
+	int i, y;									// Loop variables
+
+	SetRect (&region, max (rect->left, 0), max (rect->top, 0), min (rect->right, SCREEN_WIDTH), min (rect->bottom, SCREEN_HEIGHT));
+
+	if (region.right <= region.left || region.bottom <= region.top)
+	{
+		return;	// Return if region is empty
+	}
+
+	if (manager->back)
+	{
+		CopyBufferRect (&objects->outputObj.outputBuf, manager->back, &region);
+		// Restore the surface the stack is drawn against
+	}
+
+	memset (clip, NO_OWNER, sizeof (clip));
+
+	for (y = region.top; y < region.bottom; y++)
+	{
+		memcpy (clip [y] + region.left, manager->owners [y] + region.left, region.right - region.left);
+	}
+	// Cells outside the region keep what is already on the screen
+
+	G_owners = clip;
+	G_damage = NULL;
+
+	for (i = 0; i < manager->numParents; i++)
+	{
+		SetRect (&bounds, manager->parents [i]->location.X, manager->parents [i]->location.Y, manager->parents [i]->location.X + manager->parents [i]->width, manager->parents [i]->location.Y + manager->parents [i]->height);
+
+		if (manager->visibleCells [i] && IntersectRect (&bounds, &bounds, &region))
+		{
+			G_owner = (BYTE) i;
+			G_location = &manager->parents [i]->location;
+
+			RedrawWindows (manager->parents [i], objects);
+			// Only cells this parent window owns within the region are drawn
+		}
+	}
+
+	G_owners = NULL;
+	G_location = location;
+	G_damage = damage;
+	G_endWindow = endWindow;
+	// Leave the dragged parent window's state as it was
+}
+
+/*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
+/********************************************************************
+*																	*
+*							Interface IO							*
+*																	*
+********************************************************************/
+/*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
+
+/********************************************************************
+*	LoadVisuals - Load visual data into a basic window				*
+********************************************************************/
+
+/********************************************************************
+*	LoadMessage - Load a message into a message box					*
+********************************************************************/
+
+void LoadMessage (Window * window, StringID id)
+{
+	pIO_Descriptor IO;
+
+	assert (window && window->IO && window->mode == kMessageBox);
+	// Verify that window points to valid memory and is a message box
+
+	IO = window->IO;
+
+	if (!IO->text.source)	// Check whether IO's text is privately owned
+	{
+		FREE(IO->text.text);
+		// Free memory pointed to by IO's text field's text field
+	}
+
+	IO->text.text = GetString (id);
+	IO->text.numChars = IO->text.limit = GetStringLength (id) + 1;
+	IO->text.source = id;
+	// Show the pooled string in place, rather than a copy of it
+
+	IO->text.position = 0;	// Reveal the message from its start
+
+	if (window->display.buffer)	// Ensure that window's display has been allocated
+	{
+		ClearText (&window->display, 0, window->width * window->height);
+
+		DAMAGEWINDOW(window);
+	}
+}
+
+/********************************************************************
+*	LoadMenuItems - Load menu items into a menu						*
+********************************************************************/
+
+BOOL LoadMenuItems (MenuItem * menuItem, String const * labels, int numItems)
+{
+	int index;
+
+	assert (menuItem && labels && numItems > 0);
+	// Verify that menuItem and labels point to valid memory
+
+	FREE(menuItem->text);
+	FREE(menuItem->lParams);
+	// Free memory pointed to by menuItem's text and lParams fields
+
+	CALLOC(menuItem->text,numItems,StringID);
+	CALLOC(menuItem->lParams,numItems,long);
+
+	if (!menuItem->text || !menuItem->lParams)
+	{
+		ERROR_MESSAGE("LoadMenuItems failed","1");
+		// Return failure
+	}
+	// Verify that menuItem's text and lParams fields point to valid memory
+
+	for (index = 0; index < numItems; index++)
+	{
+		menuItem->text [index] = InternString (labels [index]);
+
+		if (!menuItem->text [index])
+		{
+			ERROR_MESSAGE("LoadMenuItems failed","2");
+			// Return failure
+		}
+		// Labels shared between menus are stored once
+	}
+
+	menuItem->numItems = numItems;
+	menuItem->entry = 0;
+
+	return TRUE;
+	// Return success
+}
+
+/********************************************************************
+*	FindMenuItemEntry - Find the entry of a menu item showing a		*
+*		string														*
+********************************************************************/
+
+int FindMenuItemEntry (MenuItem const * menuItem, StringID id)
+{
+	int index;
+
+	assert (menuItem);
+	// Verify that menuItem points to valid memory
+
+	for (index = 0; index < menuItem->numItems; index++)
+	{
+		if (menuItem->text [index] == id)
+		{
+			return index;
+			// Interned strings are equal exactly when their IDs are
+		}
+	}
+
+	return -1;
+	// Return failure
+}
+
+/********************************************************************
+*	LoadDefaultText - Load default text into an edit box			*
+********************************************************************/
+
+void LoadDefaultText (Window * window, StringID id)
+{
+	int length, previous;
+	pIO_Descriptor IO;
+
+	assert (window && window->IO && window->IO->text.text && window->mode == kEditBox);
+	// Verify that window points to valid memory and is an edit box
+
+	IO = window->IO;
+
+	previous = IO->text.gapEnd ? TEXTLENGTH(&IO->text) : IO->text.numChars;
+
+	length = min (GetStringLength (id), IO->text.numChars - 1);
+
+	memcpy (IO->text.text, GetString (id), length);
+	// Edit boxes change their text, so they take a private copy
+
+	IO->text.text [length] = END;
+	IO->text.gapStart = IO->text.gapEnd = 0;
+
+	OpenGap (&IO->text);
+
+	IO->cursor = length;	// Place the cursor after the default text
+
+	RenderEditBox (window, 0, max (previous, length) + 1);
+}
+
+/********************************************************************
+*	SaveMessage - Save the message in the edit box					*
+********************************************************************/
+
+void SaveMessage (Window * window)
+{
+	pIO_Descriptor IO;
+	voidStar data;
+	dataType type;
+
+	assert (window);
+	// Verify that window points to valid memory
+
+	if (!window->dataADT.data.data || window->mode != kEditBox)	// Ensure that window's dataADT field's data field's data field points to something and that window's mode is edit box
+	{
+		return;
+	}
+
+	IO = window->IO;
+
+	FlattenText (&IO->text);
+
+	switch (IO->readMode)
+	{
+	case kReadAll:
+	case kAlphaOnly:
+	case kPrintOnly:
+		// Save block
+		{
+			String string;
+
+			CALLOC(string,strlen (IO->text.text) + 1,char);
+
+			strcpy (string, IO->text.text);
+
+			data = string;
+			type = kChar;
+		}
+
+		break;	// Break out of switch statement
+
+	case kNumeric:
+		// Save block
+		{
+			intStar number;
+
+			MALLOC(number,int);
+
+			*number = atoi (IO->text.text);
+
+			data = number;
+			type = kChar;
+		}
+
+		break;	// Break out of switch statement
+	}
+
+	switch (window->dataADT.type)
+	{
+	case kList:
+		AppendListNode (window->dataADT.data.list, data, type);
+
+		break;	// Break out of switch statement
+
+	case kQueue:
+		EnqueueQueueNode (window->dataADT.data.queue, data, type);
+
+		break;	// Break out of switch statement
+
+	case kStack:
+		PushStackNode (window->dataADT.data.stack, data, type);
+
+		break;	// Break out of switch statement
+
+	default:
+		NORET_MESSAGE("Unsupported ADTStyle: SaveMessage failed","1");
+		// Return failure
+	}
+}
+
+/*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
+/********************************************************************
+*																	*
+*							Text editing							*
+*																	*
+********************************************************************/
+/*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
+
+/********************************************************************
+*	OpenGap - Open the gap of a text buffer after its text			*
+********************************************************************/
+
+void OpenGap (TextBuffer * text)
+{
+	String end;
+
+	assert (text && text->text);
+	// Verify that text and text's text field point to valid memory
+
+	end = memchr (text->text, END, text->numChars);
+
+	text->gapStart = end ? end - text->text : text->numChars;
+	text->gapEnd = text->numChars;
+	// Text already lies at the front, so the rest is free
+}
+
+/********************************************************************
+*	MoveGap - Move the gap of a text buffer to a position			*
+********************************************************************/
+
+void MoveGap (TextBuffer * text, int position)
+{
+	int gap;
+
+	assert (text);
+	// Verify that text points to valid memory
+
+	if (!text->gapEnd)
+	{
+		OpenGap (text);
+	}
+
+	gap = GAPSIZE(text);
+
+	position = max (min (position, TEXTLENGTH(text)), 0);
+
+	if (position < text->gapStart)
+	{
+		memmove (text->text + position + gap, text->text + position, text->gapStart - position);
+		// Shift the characters between position and the gap past it
+	}
+
+	else
+	{
+		memmove (text->text + text->gapStart, text->text + text->gapEnd, position - text->gapStart);
+		// Shift the characters between the gap and position before it
+	}
+
+	text->gapStart = position;
+	text->gapEnd = position + gap;
+}
+
+/********************************************************************
+*	InsertText - Insert a character at the gap of a text buffer		*
+********************************************************************/
+
+BOOL InsertText (TextBuffer * text, char nextChar)
+{
+	assert (text);
+	// Verify that text points to valid memory
+
+	if (!text->gapEnd)
+	{
+		OpenGap (text);
+	}
+
+	if (GAPSIZE(text) <= 1 || TEXTLENGTH(text) + 1 >= text->limit)
+	{
+		return FALSE;
+		// Keep room for a terminator, and respect the limit
+	}
+
+	text->text [text->gapStart++] = nextChar;
+
+	return TRUE;
+}
+
+/********************************************************************
+*	EraseText - Erase characters before (if amount is negative) or	*
+*		after the gap of a text buffer								*
+********************************************************************/
+
+int EraseText (TextBuffer * text, int amount)
+{
+	assert (text);
+	// Verify that text points to valid memory
+
+	if (!text->gapEnd)
+	{
+		OpenGap (text);
+	}
+
+	if (amount < 0)
+	{
+		amount = min (-amount, text->gapStart);
+
+		text->gapStart -= amount;
+	}
+
+	else
+	{
+		amount = min (amount, text->numChars - text->gapEnd);
+
+		text->gapEnd += amount;
+	}
+
+	return amount;
+	// Return count of characters erased
+}
+
+/********************************************************************
+*	GetTextChar - Get a character of a text buffer					*
+********************************************************************/
+
+char GetTextChar (TextBuffer const * text, int index)
+{
+	assert (text);
+	// Verify that text points to valid memory
+
+	return text->text [index < text->gapStart ? index : index + GAPSIZE(text)];
+}
+
+/********************************************************************
+*	FlattenText - Make a text buffer's text a contiguous string		*
+********************************************************************/
+
+String FlattenText (TextBuffer * text)
+{
+	assert (text);
+	// Verify that text points to valid memory
+
+	MoveGap (text, TEXTLENGTH(text));
+
+	if (GAPSIZE(text))
+	{
+		text->text [text->gapStart] = END;
+	}
+
+	return text->text;
+}
+
+/********************************************************************
+*	MoveEditCursor - Move an edit box's cursor to a position		*
+********************************************************************/
+
+static void MoveEditCursor (Window * window, int position)
+{
+	pIO_Descriptor IO = window->IO;
+
+	position = max (min (position, TEXTLENGTH(&IO->text)), 0);
+
+	if (position == IO->cursor)
+	{
+		return;
+	}
+
+	RenderEditBox (window, IO->cursor, IO->cursor + 1);
+	// Clear the cursor mark from its old cell
+
+	MoveGap (&IO->text, position);
+
+	IO->cursor = position;
+}
+
+/********************************************************************
+*	RenderEditBox - Copy a range of an edit box's text into its		*
+*		display														*
+********************************************************************/
+
+static void RenderEditBox (Window * window, int from, int to)
+{
+	int index, length;
+	pTextBuffer text = &window->IO->text;
+
+	length = TEXTLENGTH(text);
+	to = min (to, window->width * window->height);
+
+	G_bufCell = window->display.buffer + from;
+
+	for (index = from; index < to; index++, G_bufCell++)
+	{
+		G_bufCell->graph.Char.AsciiChar = index < length ? GetTextChar (text, index) : SPACE;
+	}
+
+	DamageSpan (window, from, to - from);
 }
 
 /*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
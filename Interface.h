@@ -42,14 +42,24 @@
 
 #define GETCURSORCELL(window)					\
 	((window)->display.buffer + (window)->IO->cursor)
-#define GETCURSORTEXT(window)					\
-	((window)->IO->text.text + (window)->IO->cursor)
 // Used to retrieve information denoted by the cursor
 
 #define GETMENUITEM(menus)						\
 	((menus)->menu + (menus)->itemChosen)
 // Used to retrieve the chosen menu item
 
+#define DAMAGEWINDOW(window)					\
+	DamageWindow (window, 0, 0, (window)->width, (window)->height)
+#define DAMAGEVISIBLE(window)					\
+	DamageWindow (window, (window)->xOffset, (window)->yOffset, (window)->xOffset + (window)->windowWidth, (window)->yOffset + (window)->windowHeight)
+// Used to mark a window's whole display, or its visible part, as damaged
+
+#define GAPSIZE(text)							\
+	((text)->gapEnd - (text)->gapStart)
+#define TEXTLENGTH(text)						\
+	((text)->numChars - GAPSIZE(text))
+// Used to measure a gap-buffered text
+
 #define GETMENUITEMTEXT(menuItem)				\
 	((menuItem)->text + (menuItem)->entry)
 #define GETMENUITEMLPARAM(menuItem)				\
@@ -83,6 +93,15 @@
 // Denotes that a ParentWindow structure has been grabbed
 #define FIXED				0x4
 // Denotes that a Window structure is immovable
+#define EVENTDRIVEN			0x8
+// Denotes that a ParentWindow structure waits for input or its next
+// animation deadline, and presents only when something changed
+
+#define LOG_BLOCK			(1 << 20)
+// Bytes of a log file indexed per hold of its lock
+#define LOG_WAIT			250
+// Milliseconds the log indexing thread waits for the file to grow
+// before checking whether it should stop
 
 #define TOPEDGE				0x0
 // A portion of a window that is occupied by the top border
@@ -130,18 +149,6 @@
 ********************************************************************/
 /*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
 
-/********************************************************************
-*	AdvanceCursor - Advance a Window structure's read/write cursor	*
-********************************************************************/
-
-static void AdvanceCursor (pWindow window, int amount);
-
-/********************************************************************
-*	RegressCursor - Regress a Window structure's read/write cursor	*
-********************************************************************/
-
-static void RegressCursor (pWindow window, int amount);
-
 /********************************************************************
 *	AssignFocus - Assign focus to a Window structure				*
 ********************************************************************/
@@ -198,6 +205,13 @@ void MakeParentWindow (pParentWindow parentWindow, int x, int y, int focus);
 
 static void InitParentWindow (pParentWindow parentWindow);
 
+/********************************************************************
+*	ComposeChrome - Compose the border and background cells of a	*
+*		parent window, to be called again after restyling it		*
+********************************************************************/
+
+BOOL ComposeChrome (pParentWindow parentWindow);
+
 /********************************************************************
 *	InitMenu - Initialize a menu associated with a Window object	*
 ********************************************************************/
@@ -218,6 +232,18 @@ static void InitMenu (pWindow window);
 
 static void GrabWindow (pParentWindow parentWindow, pObjects objects);
 
+/********************************************************************
+*	WaitForUpdate - Block until input or the animation deadline		*
+********************************************************************/
+
+static BOOL WaitForUpdate (pParentWindow parentWindow, pObjects objects);
+
+/********************************************************************
+*	WindowsAnimated - Indicates that windows change without input	*
+********************************************************************/
+
+static BOOL WindowsAnimated (ParentWindow const * parentWindow);
+
 /********************************************************************
 *	Update - Update a ParentWindow structure						*
 ********************************************************************/
@@ -236,6 +262,13 @@ static void UpdateWindowContents (pWindow window, pObjects objects, voidStar dat
 
 static void RepositionWindows (pParentWindow parentWindow, pObjects objects);
 
+/********************************************************************
+*	DragParentWindow - Move a grabbed ParentWindow structure,		*
+*		repairing only the exposed strips of the screen				*
+********************************************************************/
+
+static void DragParentWindow (pParentWindow parentWindow, pObjects objects);
+
 /********************************************************************
 *	SendInformation - Primary wrapper for updating the focus		*
 ********************************************************************/
@@ -357,16 +390,25 @@ static void HighlightMenuItem (pWindow window, int index);
 static void RemoveHighlight (pWindow window, int index);
 
 /********************************************************************
-*	WriteMessageWord - Write a word to a message box				*
+*	LayoutMessage - Word-wrap a message box's text into runs, once	*
+*		per text and window width									*
+********************************************************************/
+
+static BOOL LayoutMessage (pWindow window);
+
+/********************************************************************
+*	AddLayoutRun - Place characters of a text layout, splitting		*
+*		them into runs at row boundaries							*
 ********************************************************************/
 
-static void WriteMessageWord (pWindow window, pIO_Descriptor IO);
+static void AddLayoutRun (pTextLayout layout, int start, int cursor, int length);
 
 /********************************************************************
-*	WriteMessageCharacter - Write a character to a message box		*
+*	RevealMessage - Write a message box's laid-out text up to a		*
+*		position													*
 ********************************************************************/
 
-static void WriteMessageCharacter (pWindow window, pIO_Descriptor IO);
+static void RevealMessage (pWindow window, int position);
 
 /*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
 /********************************************************************
@@ -406,6 +448,251 @@ int ToggleMenuItemLeft (voidStar data, dataType type, long lParam);
 
 int ToggleMenuItemRight (voidStar data, dataType type, long lParam);
 
+/*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
+/********************************************************************
+*																	*
+*							Virtual windows							*
+*																	*
+********************************************************************/
+/*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
+
+/********************************************************************
+*	VirtualizeWindow - Make a window produce its content on demand	*
+*		from a source callback										*
+********************************************************************/
+
+BOOL VirtualizeWindow (pWindow window, void (* source) (voidStar data, long row, long column, pCell cells, int count), voidStar data, long numRows, long numColumns, int overscan);
+
+/********************************************************************
+*	ScrollVirtualWindow - Show a virtual window's content from a	*
+*		given row and column										*
+********************************************************************/
+
+void ScrollVirtualWindow (pWindow window, long row, long column);
+
+/********************************************************************
+*	SetVirtualRows - Change the row count of a virtual window's		*
+*		content														*
+********************************************************************/
+
+void SetVirtualRows (pWindow window, long numRows);
+
+/********************************************************************
+*	RefreshVirtualWindow - Produce a virtual window's content		*
+*		again														*
+********************************************************************/
+
+void RefreshVirtualWindow (pWindow window);
+
+/********************************************************************
+*	ShiftVirtualCache - Move a virtual window's cache to begin at a	*
+*		given content row											*
+********************************************************************/
+
+static void ShiftVirtualCache (pWindow window, long firstRow);
+
+/********************************************************************
+*	FillVirtualRows - Produce rows of a virtual window's cache		*
+********************************************************************/
+
+static void FillVirtualRows (pWindow window, int cacheRow, int count);
+
+/*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
+/********************************************************************
+*																	*
+*							Log viewer								*
+*																	*
+********************************************************************/
+/*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
+
+/********************************************************************
+*	OpenLogView - Show a memory-mapped log file in a message box	*
+********************************************************************/
+
+BOOL OpenLogView (pWindow window, String filename, int overscan);
+
+/********************************************************************
+*	CloseLogView - Stop showing a log file in a message box			*
+********************************************************************/
+
+void CloseLogView (pWindow window);
+
+/********************************************************************
+*	JumpToLogLine - Scroll a log viewer to a line					*
+********************************************************************/
+
+void JumpToLogLine (pWindow window, long line);
+
+/********************************************************************
+*	UpdateLogView - Follow a log file as it grows					*
+********************************************************************/
+
+static void UpdateLogView (pWindow window);
+
+/********************************************************************
+*	MapLogFile - Map the current contents of a log file				*
+********************************************************************/
+
+static BOOL MapLogFile (pLogView log);
+
+/********************************************************************
+*	FindLogLine - Find the offset of a line in a log file			*
+********************************************************************/
+
+static LONGLONG FindLogLine (pLogView log, long row);
+
+/********************************************************************
+*	LogViewSource - Produce the cells of a log line					*
+********************************************************************/
+
+static void LogViewSource (voidStar data, long row, long column, pCell cells, int count);
+
+/********************************************************************
+*	LogIndexThread - Build the sparse line index of a log file		*
+********************************************************************/
+
+static DWORD WINAPI LogIndexThread (LPVOID data);
+
+/*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
+/********************************************************************
+*																	*
+*							Damage tracking							*
+*																	*
+********************************************************************/
+/*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
+
+/********************************************************************
+*	DamageWindow - Mark a region of a window's display as changed	*
+********************************************************************/
+
+void DamageWindow (pWindow window, int left, int top, int right, int bottom);
+
+/********************************************************************
+*	DamageSpan - Mark a run of cells in a window's display as		*
+*		changed														*
+********************************************************************/
+
+static void DamageSpan (pWindow window, int index, int extent);
+
+/********************************************************************
+*	DamageScreen - Mark a region of the screen as changed			*
+********************************************************************/
+
+static void DamageScreen (int left, int top, int right, int bottom);
+
+/*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
+/********************************************************************
+*																	*
+*							Hotkey dispatch							*
+*																	*
+********************************************************************/
+/*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
+
+/********************************************************************
+*	FindHotKey - Find the key bound to a keycode, searching the		*
+*		focus, window and global scopes in turn, from a given one	*
+********************************************************************/
+
+pKey FindHotKey (ParentWindow const * parentWindow, int keycode, HotKeyScope first, HotKeyScope * scope);
+
+/********************************************************************
+*	SetGlobalHotKeys - Share a dispatch table with a parent window	*
+********************************************************************/
+
+void SetGlobalHotKeys (pParentWindow parentWindow, pHotKeyTable table);
+
+/********************************************************************
+*	FocusCommand - Switch focus when the focus key is pressed		*
+********************************************************************/
+
+static int FocusCommand (voidStar data, dataType type, long lParam);
+
+/********************************************************************
+*	CloseCommand - Deactivate when the close key is pressed			*
+********************************************************************/
+
+static int CloseCommand (voidStar data, dataType type, long lParam);
+
+/********************************************************************
+*	ConfirmCommand - Save messages when the confirm key is pressed	*
+********************************************************************/
+
+static int ConfirmCommand (voidStar data, dataType type, long lParam);
+
+/*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
+/********************************************************************
+*																	*
+*							Window management						*
+*																	*
+********************************************************************/
+/*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
+
+/********************************************************************
+*	InitWindowManager - Initialize a WindowManager structure		*
+********************************************************************/
+
+void InitWindowManager (pWindowManager manager, pScreenBuffer back);
+
+/********************************************************************
+*	AddParentWindow - Stack a parent window on top of the others	*
+********************************************************************/
+
+BOOL AddParentWindow (pWindowManager manager, pParentWindow parentWindow);
+
+/********************************************************************
+*	RemoveParentWindow - Remove a parent window from the stack		*
+********************************************************************/
+
+void RemoveParentWindow (pWindowManager manager, pParentWindow parentWindow);
+
+/********************************************************************
+*	RaiseParentWindow - Move a parent window to the top of the		*
+*		stack														*
+********************************************************************/
+
+void RaiseParentWindow (pWindowManager manager, pParentWindow parentWindow);
+
+/********************************************************************
+*	HitTestParentWindow - Find the topmost parent window covering a	*
+*		screen cell													*
+********************************************************************/
+
+pParentWindow HitTestParentWindow (WindowManager const * manager, int x, int y);
+
+/********************************************************************
+*	UpdateWindowManager - Route input to the topmost parent window	*
+*		and redraw the visible parts of the stack					*
+********************************************************************/
+
+BOOL UpdateWindowManager (pWindowManager manager, pObjects objects, voidStar data);
+
+/********************************************************************
+*	FindParentWindow - Find the stack index of a parent window		*
+********************************************************************/
+
+static int FindParentWindow (WindowManager const * manager, ParentWindow const * parentWindow);
+
+/********************************************************************
+*	IndexParentWindows - Assign each screen cell to the topmost		*
+*		parent window covering it									*
+********************************************************************/
+
+static void IndexParentWindows (pWindowManager manager);
+
+/********************************************************************
+*	RedrawParentWindows - Draw the visible parts of the stacked		*
+*		parent windows												*
+********************************************************************/
+
+static void RedrawParentWindows (pWindowManager manager, pObjects objects);
+
+/********************************************************************
+*	RepairParentWindows - Redraw the stacked parent windows within	*
+*		a region of the screen										*
+********************************************************************/
+
+static void RepairParentWindows (pWindowManager manager, pObjects objects, RECT const * rect);
+
 /*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
 /********************************************************************
 *																	*
@@ -422,16 +709,91 @@ int ToggleMenuItemRight (voidStar data, dataType type, long lParam);
 *	LoadMessage - Load a message into a message box					*
 ********************************************************************/
 
+void LoadMessage (pWindow window, StringID id);
+
 /********************************************************************
 *	LoadMenuItems - Load menu items into a menu						*
 ********************************************************************/
 
+BOOL LoadMenuItems (pMenuItem menuItem, String const * labels, int numItems);
+
+/********************************************************************
+*	FindMenuItemEntry - Find the entry of a menu item showing a		*
+*		string														*
+********************************************************************/
+
+int FindMenuItemEntry (MenuItem const * menuItem, StringID id);
+
+/********************************************************************
+*	LoadDefaultText - Load default text into an edit box			*
+********************************************************************/
+
+void LoadDefaultText (pWindow window, StringID id);
+
 /********************************************************************
 *	SaveMessage - Save the message in the edit box					*
 ********************************************************************/
 
 void SaveMessage (pWindow window);
 
+/*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
+/********************************************************************
+*																	*
+*							Text editing							*
+*																	*
+********************************************************************/
+/*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
+
+/********************************************************************
+*	OpenGap - Open the gap of a text buffer after its text			*
+********************************************************************/
+
+void OpenGap (pTextBuffer text);
+
+/********************************************************************
+*	MoveGap - Move the gap of a text buffer to a position			*
+********************************************************************/
+
+void MoveGap (pTextBuffer text, int position);
+
+/********************************************************************
+*	InsertText - Insert a character at the gap of a text buffer		*
+********************************************************************/
+
+BOOL InsertText (pTextBuffer text, char nextChar);
+
+/********************************************************************
+*	EraseText - Erase characters before (if amount is negative) or	*
+*		after the gap of a text buffer								*
+********************************************************************/
+
+int EraseText (pTextBuffer text, int amount);
+
+/********************************************************************
+*	GetTextChar - Get a character of a text buffer					*
+********************************************************************/
+
+char GetTextChar (TextBuffer const * text, int index);
+
+/********************************************************************
+*	FlattenText - Make a text buffer's text a contiguous string		*
+********************************************************************/
+
+String FlattenText (pTextBuffer text);
+
+/********************************************************************
+*	MoveEditCursor - Move an edit box's cursor to a position		*
+********************************************************************/
+
+static void MoveEditCursor (pWindow window, int position);
+
+/********************************************************************
+*	RenderEditBox - Copy a range of an edit box's text into its		*
+*		display														*
+********************************************************************/
+
+static void RenderEditBox (pWindow window, int from, int to);
+
 /*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
 /********************************************************************
 *																	*
@@ -18,6 +18,7 @@
 /*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
 
 #include "Mathematics.h"
+#include "World.h"
 
 /*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
 /********************************************************************
@@ -233,7 +234,7 @@ void WriteText (OutputBuffer * outputBuf, String text, int index)
 
 	while (*text)
 	{
-		G_bufCell->graph.Char.AsciiChar = *text++;
+		(G_bufCell++)->graph.Char.AsciiChar = *text++;
 	}
 }
 
@@ -273,6 +274,69 @@ void CopyBuffer (ScreenBuffer * dest, ScreenBuffer const * source)
 	// Copy data from source to dest
 }
 
+/********************************************************************
+*	CopyBufferRect - Copy a region of one screen buffer into		*
+*		another														*
+********************************************************************/
+
+void CopyBufferRect (ScreenBuffer * dest, ScreenBuffer const * source, RECT const * rect)
+{
+	int i;		// Loop variable
+	int size;	// Size of a row of the region
+
+	assert (dest && source && rect);
+	// Verify that dest, source, and rect point to valid memory
+
+	if (rect->right <= rect->left || rect->bottom <= rect->top)
+	{
+		return;	// Return if region is empty
+	}
+
+	size = (rect->right - rect->left) * sizeof (CHAR_INFO);
+
+	for (i = rect->top; i < rect->bottom; i++)
+	{
+		memcpy (dest->buffer [i] + rect->left, source->buffer [i] + rect->left, size);
+		// Copy a row of the region from source to dest
+	}
+}
+
+/********************************************************************
+*	MoveBufferRect - Move a region of a screen buffer to a new		*
+*		location													*
+********************************************************************/
+
+void MoveBufferRect (ScreenBuffer * buffer, RECT const * rect, int x, int y)
+{
+	int i;		// Loop variable
+	int size;	// Size of a row of the region
+	int height;	// Number of rows in the region
+
+	assert (buffer && rect);
+	// Verify that buffer and rect point to valid memory
+
+	size = (rect->right - rect->left) * sizeof (CHAR_INFO);
+	height = rect->bottom - rect->top;
+
+	if (y > rect->top)
+	{
+		for (i = height - 1; i >= 0; i--)
+		{
+			memmove (buffer->buffer [y + i] + x, buffer->buffer [rect->top + i] + rect->left, size);
+			// Move rows from the bottom up so that none are overwritten before being read
+		}
+	}
+
+	else
+	{
+		for (i = 0; i < height; i++)
+		{
+			memmove (buffer->buffer [y + i] + x, buffer->buffer [rect->top + i] + rect->left, size);
+			// Move rows from the top down so that none are overwritten before being read
+		}
+	}
+}
+
 /********************************************************************
 *	UpdateScreen - Update the contents of the screen buffer			*
 ********************************************************************/
@@ -293,6 +357,40 @@ void UpdateScreen (Output * outputObj)
 	// Update the screen buffer
 }
 
+/********************************************************************
+*	UpdateScreenRect - Update a region of the screen buffer			*
+********************************************************************/
+
+void UpdateScreenRect (Output * outputObj, RECT const * rect)
+{
+	static COORD dimensions = {SCREEN_WIDTH, SCREEN_HEIGHT};// Constant value used as dimensions to update screen
+	COORD bufCoord;											// Offset of region within buffer
+	SMALL_RECT region;										// Region of screen to update
+
+	assert (outputObj && rect);
+	// Verify that outputObj and rect point to valid memory
+
+	if (rect->right <= rect->left || rect->bottom <= rect->top)
+	{
+		return;	// Return if region is empty
+	}
+
+	bufCoord.X = (SHORT) rect->left;
+	bufCoord.Y = (SHORT) rect->top;
+
+	region.Left = (SHORT) (outputObj->outputBuf.outputRect.Left + rect->left);
+	region.Top = (SHORT) (outputObj->outputBuf.outputRect.Top + rect->top);
+	region.Right = (SHORT) (outputObj->outputBuf.outputRect.Left + rect->right - 1);
+	region.Bottom = (SHORT) (outputObj->outputBuf.outputRect.Top + rect->bottom - 1);
+
+	if (!WriteConsoleOutput (outputObj->outputH, *outputObj->outputBuf.buffer, dimensions, bufCoord, &region))
+	{
+		NORET_MESSAGE("UpdateScreenRect failed","1");
+		// Return failure
+	}
+	// Update the region of the screen buffer
+}
+
 /********************************************************************
 *																	*
 *							Map Display Routines					*
@@ -443,6 +541,81 @@ void CopyMapDataToBuffer (ScreenBuffer * buffer, Map const * map)
 	}
 }
 
+/********************************************************************
+*	CopyVisibleMapToBuffer - Copy contents from offset of map to a	*
+*		buffer, blanking cells hidden from view						*
+********************************************************************/
+
+void CopyVisibleMapToBuffer (ScreenBuffer * buffer, Map const * map, Sight * sight)
+{
+	int i, j;		// Loop variables
+	int pitch;		// Pitch used to increment index
+	int x, y;		// Map location of cell
+	int left, right;// Columns of screen row lying within view range
+
+	assert (buffer && map && sight);
+	// Verify that buffer, map, and sight point to valid memory
+
+	// Initialization block
+	{
+		int index = map->yOffset * map->width + map->xOffset;
+
+		pitch = map->width - SCREEN_WIDTH;
+
+		G_dest = *buffer->buffer;
+
+		G_mapCell = map->world.buffer + index;
+
+		left = sight->viewer.X - sight->radius - map->xOffset;
+		right = sight->viewer.X + sight->radius - map->xOffset;
+		// Clamp view range to the screen
+
+		if (left < 0)
+		{
+			left = 0;
+		}
+
+		if (right >= SCREEN_WIDTH)
+		{
+			right = SCREEN_WIDTH - 1;
+		}
+	}
+
+	for (i = 0; i < SCREEN_HEIGHT; i++)
+	{
+		y = map->yOffset + i;
+
+		if (abs (y - sight->viewer.Y) > sight->radius || left > right)
+		{
+			ZeroMemory (G_dest, SCREEN_WIDTH * sizeof (CHAR_INFO));
+			// Blank rows lying wholly out of range
+
+			G_dest += SCREEN_WIDTH;
+			G_mapCell += map->width;
+
+			continue;
+		}
+
+		for (j = 0; j < SCREEN_WIDTH; j++, G_dest++, G_mapCell++)
+		{
+			x = map->xOffset + j;
+
+			if (j < left || j > right || !*SIGHTCELL(sight,x,y))
+			{
+				ZeroMemory (G_dest, sizeof (CHAR_INFO));
+				// Skip cells hidden from view
+			}
+
+			else if (!FLAGSET(G_mapCell->flags,NONVISIBLE))
+			{
+				*G_dest = G_mapCell->graph;
+			}
+		}
+
+		G_mapCell += pitch;
+	}
+}
+
 /********************************************************************
 *	ScrollMap - Scroll the contents of the given map				*
 ********************************************************************/
@@ -154,12 +154,32 @@ void ClearScreen (pOutput outputObj);
 
 void CopyBuffer (pScreenBuffer dest, ScreenBuffer const * source);
 
+/********************************************************************
+*	CopyBufferRect - Copy a region of one screen buffer into		*
+*		another														*
+********************************************************************/
+
+void CopyBufferRect (pScreenBuffer dest, ScreenBuffer const * source, RECT const * rect);
+
+/********************************************************************
+*	MoveBufferRect - Move a region of a screen buffer to a new		*
+*		location													*
+********************************************************************/
+
+void MoveBufferRect (pScreenBuffer buffer, RECT const * rect, int x, int y);
+
 /********************************************************************
 *	UpdateScreen - Update the contents of the screen buffer			*
 ********************************************************************/
 
 void UpdateScreen (pOutput output);
 
+/********************************************************************
+*	UpdateScreenRect - Update a region of the screen buffer			*
+********************************************************************/
+
+void UpdateScreenRect (pOutput output, RECT const * rect);
+
 /********************************************************************
 *																	*
 *							Map Display Routines					*
@@ -184,6 +204,13 @@ void CopyMapFlagsToBuffer (pScreenBuffer buffer, Map const * map);
 
 void CopyMapDataToBuffer (pScreenBuffer buffer, Map const * map);
 
+/********************************************************************
+*	CopyVisibleMapToBuffer - Copy contents from offset of map to a	*
+*		buffer, blanking cells hidden from view						*
+********************************************************************/
+
+void CopyVisibleMapToBuffer (pScreenBuffer buffer, Map const * map, pSight sight);
+
 /********************************************************************
 *	ScrollMap - Scroll the contents of the given map				*
 ********************************************************************/
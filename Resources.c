@@ -54,6 +54,9 @@ static pPointSet G_endSet;
 static pTriangulation G_endTriangulation;
 // Used to quicken Triangulation loops
 
+static StringPool G_strings;
+// Pool of interned strings, shared by every window
+
 /*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
 /********************************************************************
 *																	*
@@ -130,6 +133,250 @@ void ShareOutputBuffer (OutputBuffer * outputBuf, OutputBuffer const * source)
 	outputBuf->buffer = source->buffer;
 }
 
+/*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
+/********************************************************************
+*																	*
+*							String interning						*
+*																	*
+********************************************************************/
+/*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
+
+/********************************************************************
+*	InternString - Add a string to the string pool, or find it		*
+********************************************************************/
+
+StringID InternString (String string)
+{
+	int length;			// Length of string
+	DWORD bucket;		// Hash chain string belongs to
+	StringID id;		// ID of a pooled string
+	pStringEntry entry;	// Entry of a pooled string
+
+	assert (string);
+	// Verify that string points to valid memory
+
+	length = strlen (string);
+	bucket = HashString (string, length) & STRING_BUCKETMASK;
+
+	G_strings.numRequests++;
+	G_strings.requestBytes += length + 1;
+	// Tally the copy a caller would otherwise have made
+
+	for (id = G_strings.buckets [bucket]; id != NO_STRING; id = entry->next)
+	{
+		entry = G_strings.entries + id - 1;
+
+		if (entry->length == length && !memcmp (entry->string, string, length))
+		{
+			return id;
+			// Return the ID string was already interned under
+		}
+	}
+
+	if (G_strings.numStrings == G_strings.maxStrings && !GrowStringEntries ())
+	{
+		ERROR_MESSAGE("InternString failed","1");
+		// Return failure
+	}
+
+	if (!G_strings.blocks || G_strings.blocks->size - G_strings.blocks->used <= length)
+	{
+		if (!AddStringBlock (max (length + 1, STRING_BLOCK)))
+		{
+			ERROR_MESSAGE("InternString failed","2");
+			// Return failure
+		}
+	}
+	// Blocks never move, so pooled strings keep their addresses
+
+	entry = G_strings.entries + G_strings.numStrings;
+
+	entry->string = G_strings.blocks->chars + G_strings.blocks->used;
+	entry->length = length;
+	entry->next = G_strings.buckets [bucket];
+
+	memcpy (entry->string, string, length + 1);
+	// Copy string and its terminator into the pool
+
+	G_strings.blocks->used += length + 1;
+
+	G_strings.buckets [bucket] = ++G_strings.numStrings;
+	// IDs count from 1, leaving 0 as NO_STRING
+
+	return G_strings.numStrings;
+	// Return the new ID
+}
+
+/********************************************************************
+*	GetString - Get the characters of an interned string			*
+********************************************************************/
+
+String GetString (StringID id)
+{
+	assert (id > NO_STRING && id <= G_strings.numStrings);
+	// Verify that id names an interned string
+
+	return G_strings.entries [id - 1].string;
+	// Return the string's characters
+}
+
+/********************************************************************
+*	GetStringLength - Get the length of an interned string			*
+********************************************************************/
+
+int GetStringLength (StringID id)
+{
+	assert (id > NO_STRING && id <= G_strings.numStrings);
+	// Verify that id names an interned string
+
+	return G_strings.entries [id - 1].length;
+	// Return the string's length
+}
+
+/********************************************************************
+*	GetStringPoolReport - Measure the memory the string pool saves	*
+********************************************************************/
+
+void GetStringPoolReport (StringPoolReport * report)
+{
+	pStringBlock block;
+
+	assert (report);
+	// Verify that report points to valid memory
+
+	ZeroMemory (report, sizeof (StringPoolReport));
+
+	report->numStrings = G_strings.numStrings;
+	report->numRequests = G_strings.numRequests;
+	report->requestBytes = G_strings.requestBytes;
+
+	report->overheadBytes = G_strings.maxStrings * sizeof (StringEntry) + sizeof (G_strings.buckets);
+
+	for (block = G_strings.blocks; block; block = block->next)
+	{
+		report->storedBytes += block->used;
+		report->overheadBytes += block->size - block->used + sizeof (StringBlock);
+	}
+
+	report->savedBytes = report->requestBytes - report->storedBytes - report->overheadBytes;
+	// Private copies would each have held their own characters
+}
+
+/********************************************************************
+*	ClearStringPool - Release every interned string					*
+********************************************************************/
+
+void ClearStringPool (void)
+{
+	pStringBlock block;
+
+	while (G_strings.blocks)
+	{
+		block = G_strings.blocks;
+
+		G_strings.blocks = block->next;
+
+		FREE(block->chars);
+		// Free memory pointed to by block's chars field
+
+		FREE(block);
+		// Free memory pointed to by block
+	}
+
+	FREE(G_strings.entries);
+	// Free memory pointed to by G_strings's entries field
+
+	ZeroMemory (&G_strings, sizeof (StringPool));
+	// Every ID is now stale
+}
+
+/********************************************************************
+*	HashString - Hash the characters of a string					*
+********************************************************************/
+
+static DWORD HashString (String string, int length)
+{
+	DWORD hash = 2166136261;	// FNV-1a offset basis
+
+	while (length--)
+	{
+		hash = (hash ^ (BYTE) *string++) * 16777619;
+		// Fold in each character
+	}
+
+	return hash;
+}
+
+/********************************************************************
+*	AddStringBlock - Add a block of storage to the string pool		*
+********************************************************************/
+
+static BOOL AddStringBlock (int size)
+{
+	pStringBlock block;
+
+	MALLOC(block,StringBlock);
+
+	if (!block)
+	{
+		ERROR_MESSAGE("AddStringBlock failed","1");
+		// Return failure
+	}
+	// Verify that block points to valid memory
+
+	CALLOC(block->chars,size,char);
+
+	if (!block->chars)
+	{
+		FREE(block);
+		// Free memory pointed to by block
+
+		ERROR_MESSAGE("AddStringBlock failed","2");
+		// Return failure
+	}
+	// Verify that block's chars field points to valid memory
+
+	block->size = size;
+	block->next = G_strings.blocks;
+
+	G_strings.blocks = block;	// New strings go into the new block
+
+	return TRUE;
+	// Return success
+}
+
+/********************************************************************
+*	GrowStringEntries - Double the string pool's entries			*
+********************************************************************/
+
+static BOOL GrowStringEntries (void)
+{
+	int maxStrings;
+	pStringEntry entries;
+
+	maxStrings = G_strings.maxStrings ? G_strings.maxStrings << 1 : STRING_BUCKETS;
+
+	CALLOC(entries,maxStrings,StringEntry);
+
+	if (!entries)
+	{
+		ERROR_MESSAGE("GrowStringEntries failed","1");
+		// Return failure
+	}
+	// Verify that entries points to valid memory
+
+	memcpy (entries, G_strings.entries, G_strings.numStrings * sizeof (StringEntry));
+
+	FREE(G_strings.entries);
+	// Free memory pointed to by G_strings's entries field
+
+	G_strings.entries = entries;
+	G_strings.maxStrings = maxStrings;
+
+	return TRUE;
+	// Return success
+}
+
 /*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
 /********************************************************************
 *																	*
@@ -202,6 +449,13 @@ BOOL ConsoleInit (Objects * objects, DWORD flags, BOOL showCursor)
 	}
 	// Set the console screen buffer size
 
+	if (!StartInputThread (&objects->inputObj))
+	{
+		ERROR_MESSAGE("ConsoleInit failed","8");
+		// Return failure
+	}
+	// Drain console input on its own thread
+
 	return TRUE;
 	// Return success
 }
@@ -415,6 +669,9 @@ void DeleteMenus (Menu * menu)
 
 	FREE(menu->menu);
 	// Free memory pointed to by menu's menu field
+
+	FREE(menu->table);
+	// Free memory pointed to by menu's table field
 }
 
 /********************************************************************
@@ -430,10 +687,33 @@ void DeleteWindow (Window * window)
 
 	DeleteOutputBuffer (&window->display);
 
+	FREE(window->view);
+	// Free memory pointed to by window's view field
+
 	if (window->IO)	// Ensure that window's IO field points to something
 	{
-		FREE(window->IO->text.text);
-		// Free memory pointed to by window's IO field's text field's text field
+		if (window->IO->text.source)	// Check whether window's text is interned
+		{
+			window->IO->text.text = NULL;	// Nullify window's IO field's text field's text field; the pool owns it
+		}
+
+		else
+		{
+			FREE(window->IO->text.text);
+			// Free memory pointed to by window's IO field's text field's text field
+		}
+
+		CloseLogView (window);
+		// Stop indexing and unmap the log, if window is a log viewer
+
+		if (window->IO->layout)	// Ensure that window's IO field's layout field points to something
+		{
+			FREE(window->IO->layout->runs);
+			// Free memory pointed to by window's IO field's layout field's runs field
+
+			FREE(window->IO->layout);
+			// Free memory pointed to by window's IO field's layout field
+		}
 
 		FREE(window->IO);
 		// Free memory pointed to by window's IO field
@@ -518,12 +798,80 @@ void DeleteWindow (Window * window)
 void DeleteParentWindow (ParentWindow * parentWindow)
 {
 	pWindow window;
+	pMenuItem menuItem;
 
 	if (!parentWindow)	// Ensure that parentWindow points to something
 	{
 		return;	// Return if parentWindow is NULL
 	}
 
+	if (parentWindow->blob)	// Check whether parentWindow was loaded from a blob
+	{
+		parentWindow->back = NULL;
+		parentWindow->separators = NULL;
+		parentWindow->backData = NULL;
+		// Nullify the fields pointing into parentWindow's blob
+
+		for (window = parentWindow->windows, G_endWindow = window + parentWindow->numWindows; window < G_endWindow; window++)
+		{
+			if (INBLOB(parentWindow,window->display.buffer))
+			{
+				window->display.buffer = NULL;	// Nullify window's display field's buffer field
+			}
+			// A display replaced since loading, as by a virtual window, is freed below
+
+			if (INBLOB(parentWindow,window->menu))
+			{
+				for (menuItem = window->menu->menu, G_endItem = menuItem + window->menu->numItems; menuItem < G_endItem; menuItem++)
+				{
+					if (!INBLOB(parentWindow,menuItem->text))
+					{
+						FREE(menuItem->text);
+						// Free memory pointed to by menuItem's text field; its labels were pooled on load
+					}
+
+					if (!INBLOB(parentWindow,menuItem->lParams))
+					{
+						FREE(menuItem->lParams);
+						// Free memory pointed to by menuItem's lParams field
+					}
+				}
+
+				FREE(window->menu->table);
+				// Free memory pointed to by window's menu field's table field
+
+				window->menu = NULL;	// Nullify window's menu field; its items and keys lie in the blob
+			}
+
+			if (INBLOB(parentWindow,window->receivers))
+			{
+				window->receivers = NULL;	// Nullify window's receivers field
+			}
+
+			if (INBLOB(parentWindow,window->visuals))
+			{
+				window->visuals = NULL;	// Nullify window's visuals field; its images lie in the blob
+			}
+
+			if (window->IO)	// Ensure that window's IO field points to something
+			{
+				CloseLogView (window);
+				// Stop indexing and unmap the log, if window is a log viewer
+
+				if (window->IO->layout)	// Ensure that window's IO field's layout field points to something
+				{
+					FREE(window->IO->layout->runs);
+					// Free memory pointed to by window's IO field's layout field's runs field
+
+					FREE(window->IO->layout);
+					// Free memory pointed to by window's IO field's layout field
+				}
+
+				window->IO = NULL;	// Nullify window's IO field; its text lies in the blob
+			}
+		}
+	}
+
 	if (parentWindow->back)	// Ensure that parentWindow's back field points to something
 	{
 		switch (parentWindow->bufferSharing)	// Get exclusive mode
@@ -562,11 +910,27 @@ void DeleteParentWindow (ParentWindow * parentWindow)
 		// Remove the Window structure at the given index
 	}
 
+	if (parentWindow->blob)	// Check whether parentWindow was loaded from a blob
+	{
+		parentWindow->windows = NULL;	// Nullify parentWindow's windows field
+
+		FREE(parentWindow->blob);
+		// Free memory pointed to by parentWindow's blob field, and all it held
+
+		parentWindow->blobSize = 0;
+	}
+
 	FREE(parentWindow->windows);
 	// Free memory pointed to by parentWindow's windows field
 
 	FREE(parentWindow->backData);
 	// Free memory pointed to by parentWindow's backData field
+
+	FREE(parentWindow->chrome);
+	// Free memory pointed to by parentWindow's chrome field
+
+	FREE(parentWindow->hotKeys);
+	// Free memory pointed to by parentWindow's hotKeys field; globalKeys is shared
 }
 
 /********************************************************************
@@ -641,6 +1005,9 @@ BOOL DeinitializeObjects (Objects * objects)
 	}
 	// Clean up resources
 
+	ClearStringPool ();
+	// Release the interned strings
+
 	return TRUE;
 	// Return success
 }
\ No newline at end of file
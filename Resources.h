@@ -58,6 +58,62 @@ void ShareStack (pStack * stack, pObjects objects);
 
 void ShareOutputBuffer (pOutputBuffer outputBuf, OutputBuffer const * source);
 
+/*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
+/********************************************************************
+*																	*
+*							String interning						*
+*																	*
+********************************************************************/
+/*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
+
+/********************************************************************
+*	InternString - Add a string to the string pool, or find it		*
+********************************************************************/
+
+StringID InternString (String string);
+
+/********************************************************************
+*	GetString - Get the characters of an interned string			*
+********************************************************************/
+
+String GetString (StringID id);
+
+/********************************************************************
+*	GetStringLength - Get the length of an interned string			*
+********************************************************************/
+
+int GetStringLength (StringID id);
+
+/********************************************************************
+*	GetStringPoolReport - Measure the memory the string pool saves	*
+********************************************************************/
+
+void GetStringPoolReport (pStringPoolReport report);
+
+/********************************************************************
+*	ClearStringPool - Release every interned string					*
+********************************************************************/
+
+void ClearStringPool (void);
+
+/********************************************************************
+*	HashString - Hash the characters of a string					*
+********************************************************************/
+
+static DWORD HashString (String string, int length);
+
+/********************************************************************
+*	AddStringBlock - Add a block of storage to the string pool		*
+********************************************************************/
+
+static BOOL AddStringBlock (int size);
+
+/********************************************************************
+*	GrowStringEntries - Double the string pool's entries			*
+********************************************************************/
+
+static BOOL GrowStringEntries (void);
+
 /*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
 /********************************************************************
 *																	*
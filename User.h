@@ -25,6 +25,7 @@
 #include "Output.h"
 #include "Resources.h"
 #include "Scene.h"
+#include "World.h"
 
 /********************************************************************
 *																	*
@@ -78,6 +79,7 @@ typedef struct _Triangles {
 ********************************************************************/
 
 void Game (void);
+void Simulate (long ticks, long hashInterval);
 
 /********************************************************************
 *																	*
@@ -109,9 +111,14 @@ void DisplayCompression (PCHAR_INFO outputBuf, pScreenBuffer buffer, voidStar da
 
 void DisplayBorders (pImage image, pOutput outputObj);
 
+void StartJournal (pInput inputObj);
+
 void Rotate (void);
 void ThreeD (void);
 void WindowTest (void);
+void WindowManagerTest (void);
+void LogViewTest (void);
+void BlobLoadTest (void);
 
 void compareLow (double test, double * value);
 void PrepareForRedraw (pOutput outputObj, intStar redraw);
@@ -119,4 +126,19 @@ void PrepareForRedraw (pOutput outputObj, intStar redraw);
 int liesOutside (Vector2 test, Vector2 check, double tolerance);
 int comp (void const * dataA, void const * dataB);
 
+/********************************************************************
+*																	*
+*							Benchmarks								*
+*																	*
+********************************************************************/
+
+void PathBenchmark (void);
+void StringPoolBenchmark (void);
+void NodePoolBenchmark (void);
+void QueueBenchmark (void);
+void ListBenchmark (void);
+void VectorBenchmark (void);
+void MessageQueueStress (void);
+void MessageQueueBenchmark (void);
+
 #endif
\ No newline at end of file
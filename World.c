@@ -0,0 +1,1681 @@
+/********************************************************************
+*																	*
+*							World.c									*
+*																	*
+*	Author:		Steven Johnson										*
+*	Purpose:	Contains implementation of world tool				*
+*																	*
+********************************************************************/
+
+#include "World.h"
+
+/*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
+/********************************************************************
+*																	*
+*							External includes						*
+*																	*
+********************************************************************/
+/*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
+
+#include "Output.h"
+
+/*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
+/********************************************************************
+*																	*
+*							Globals									*
+*																	*
+********************************************************************/
+/*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
+
+static int G_xSteps [4] = {1, 0, -1, 0};
+static int G_ySteps [4] = {0, 1, 0, -1};
+// Used to step toward each side of a cell, indexed as EASTSIDE,
+// SOUTHSIDE, WESTSIDE, and NORTHSIDE
+
+static int G_octants [8] [4] = {
+	{1, 0, 0, 1}, {0, 1, 1, 0}, {0, -1, 1, 0}, {-1, 0, 0, 1},
+	{-1, 0, 0, -1}, {0, -1, -1, 0}, {0, 1, -1, 0}, {1, 0, 0, -1}
+};
+// Used to transform a shadowcast row and column into each octant
+
+static BYTE G_regionFlags [REGIONKINDS] = {TRIGGER, DANGER, EXIT};
+// Used to look up the flag forming each kind of region
+
+/*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
+/********************************************************************
+*																	*
+*							Construction							*
+*																	*
+********************************************************************/
+/*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
+
+/********************************************************************
+*	MakePathGraph - Build an abstract path graph over a map			*
+*	Input:	Path graph to build; map to build graph over			*
+*	Output:	Success													*
+********************************************************************/
+
+BOOL MakePathGraph (PathGraph * graph, Map * map)
+{
+	pPathCluster cluster;	// Cluster being laid out
+	int numClusters;		// Count of clusters over map
+	int i;					// Loop counter
+
+	assert (graph && map);
+	// Verify that graph and map point to valid memory
+
+	ZeroMemory (graph, sizeof (PathGraph));
+
+	graph->map = map;	// Attach the map
+
+	graph->xClusters = (map->width + CLUSTER_SIZE - 1) / CLUSTER_SIZE;
+	graph->yClusters = (map->height + CLUSTER_SIZE - 1) / CLUSTER_SIZE;
+	// Cover the map with clusters, allowing partial ones at its edges
+
+	numClusters = graph->xClusters * graph->yClusters;
+
+	graph->numSlots = numClusters * CLUSTER_NODES + 2;
+	// Reserve a slot for every possible node, plus start and goal
+
+	CALLOC(graph->clusters,numClusters,PathCluster);
+	CALLOC(graph->east,numClusters,PathBorder);
+	CALLOC(graph->south,numClusters,PathBorder);
+
+	CALLOC(graph->visited,graph->numSlots,DWORD);
+	CALLOC(graph->closed,graph->numSlots,BYTE);
+	CALLOC(graph->costs,graph->numSlots,int);
+	CALLOC(graph->scores,graph->numSlots,int);
+	CALLOC(graph->parents,graph->numSlots,int);
+	CALLOC(graph->heap,graph->numSlots,int);
+	CALLOC(graph->heapIndex,graph->numSlots,int);
+	CALLOC(graph->route,graph->numSlots,int);
+
+	if (!graph->clusters || !graph->east || !graph->south || !graph->visited || !graph->closed
+		|| !graph->costs || !graph->scores || !graph->parents || !graph->heap || !graph->heapIndex || !graph->route)
+	{
+		DestroyPathGraph (graph);
+
+		ERROR_MESSAGE("MakePathGraph failed","1");
+		// Return failure
+	}
+	// Verify that graph's arrays point to valid memory
+
+	for (i = 0; i < numClusters; i++)
+	{
+		cluster = graph->clusters + i;
+
+		cluster->bounds.left = (i % graph->xClusters) * CLUSTER_SIZE;
+		cluster->bounds.top = (i / graph->xClusters) * CLUSTER_SIZE;
+		cluster->bounds.right = cluster->bounds.left + CLUSTER_SIZE;
+		cluster->bounds.bottom = cluster->bounds.top + CLUSTER_SIZE;
+
+		if (cluster->bounds.right > map->width)
+		{
+			cluster->bounds.right = map->width;
+		}
+
+		if (cluster->bounds.bottom > map->height)
+		{
+			cluster->bounds.bottom = map->height;
+		}
+		// Bound cluster, clipping it against the map's edges
+
+		cluster->dirty = TRUE;	// Flag cluster for building
+	}
+
+	graph->numDirty = numClusters;
+
+	graph->lastGoal.X = NOPATH;	// No goal costs are held yet
+
+	return RefreshPathGraph (graph);
+	// Build every cluster
+}
+
+/********************************************************************
+*	MakeSight - Prepare a field of view over a map					*
+*	Input:	Field of view to prepare; map to view; view radius		*
+*	Output:	Success													*
+********************************************************************/
+
+BOOL MakeSight (Sight * sight, Map * map, int radius)
+{
+	assert (sight && map && radius > 0);
+	// Verify that sight and map point to valid memory
+
+	ZeroMemory (sight, sizeof (Sight));
+
+	sight->map = map;	// Attach the map
+
+	sight->radius = radius;
+	sight->span = (radius << 1) + 1;
+
+	CALLOC(sight->visible,sight->span * sight->span,BYTE);
+
+	if (!sight->visible)
+	{
+		ERROR_MESSAGE("MakeSight failed","1");
+		// Return failure
+	}
+	// Verify that sight's visible field points to valid memory
+
+	sight->dirty = TRUE;	// Force a cast on first update
+
+	return TRUE;
+	// Return success
+}
+
+/********************************************************************
+*	MakeRegionIndex - Group a map's flagged cells into regions		*
+*	Input:	Region index to build; map to index						*
+*	Output:	Success													*
+********************************************************************/
+
+BOOL MakeRegionIndex (RegionIndex * index, Map * map)
+{
+	pRegion region;		// Region holding cell
+	intStar queue;		// Queue used in flood fills
+	int area;			// Count of map cells
+	int kind;			// Kind of region being labeled
+	int label;			// Label of cell
+	int cell, x, y;		// Cell being checked; its location
+
+	assert (index && map);
+	// Verify that index and map point to valid memory
+
+	ZeroMemory (index, sizeof (RegionIndex));
+
+	index->map = map;	// Attach the map
+
+	area = map->width * map->height;
+
+	CALLOC(index->labels,area * REGIONKINDS,int);
+	CALLOC(queue,area,int);
+
+	if (!index->labels || !queue)
+	{
+		FREE(index->labels);
+		FREE(queue);
+
+		ERROR_MESSAGE("MakeRegionIndex failed","1");
+		// Return failure
+	}
+	// Verify that index's labels field and queue point to valid memory
+
+	for (kind = 0; kind < REGIONKINDS; kind++)
+	{
+		for (cell = 0; cell < area; cell++)
+		{
+			if (FLAGSET((map->world.buffer + cell)->flags,G_regionFlags [kind]) && !*(index->labels + kind * area + cell))
+			{
+				FloodRegion (index, kind, cell, index->numRegions++, queue);
+				// Label an unlabeled region
+			}
+		}
+	}
+
+	FREE(queue);
+
+	if (!index->numRegions)
+	{
+		return TRUE;	// Return success if map has no regions
+	}
+
+	CALLOC(index->regions,index->numRegions,Region);
+
+	if (!index->regions)
+	{
+		ERROR_MESSAGE("MakeRegionIndex failed","2");
+		// Return failure
+	}
+	// Verify that index's regions field points to valid memory
+
+	for (kind = 0; kind < REGIONKINDS; kind++)
+	{
+		for (y = 0; y < map->height; y++)
+		{
+			for (x = 0; x < map->width; x++)
+			{
+				if (!(label = *GETLABEL(index,kind,x,y)))
+				{
+					continue;	// Skip unflagged cells
+				}
+
+				region = index->regions + label - 1;
+
+				if (!region->numCells)
+				{
+					region->flag = G_regionFlags [kind];
+					region->data = GETMAPCELL(map,x,y)->data;
+
+					region->bounds.left = region->bounds.right = x;
+					region->bounds.top = region->bounds.bottom = y;
+				}
+				// Open region at its first cell
+
+				if (x < region->bounds.left)
+				{
+					region->bounds.left = x;
+				}
+
+				if (x >= region->bounds.right)
+				{
+					region->bounds.right = x + 1;
+				}
+
+				region->bounds.bottom = y + 1;
+				// Grow bounds; rows are walked in order, so only the bottom grows vertically
+
+				region->numCells++;
+			}
+		}
+	}
+
+	return TRUE;
+	// Return success
+}
+
+/********************************************************************
+*	FloodRegion - Label the cells connected to a flagged cell		*
+*	Input:	Region index; kind of flag; cell to begin at; region	*
+*			ID; queue with room for every map cell					*
+********************************************************************/
+
+static void FloodRegion (RegionIndex * index, int kind, int cell, int id, int * queue)
+{
+	pMap map = index->map;							// Map being labeled
+	intStar labels = index->labels + kind * map->width * map->height;	// Labels for this kind of flag
+	int head = 0, tail = 0;							// Ends of queue
+	int x, y;										// Location of neighbor
+	int side;										// Side of cell being checked
+
+	*(labels + cell) = id + 1;
+	*(queue + tail++) = cell;
+
+	while (head < tail)
+	{
+		cell = *(queue + head++);
+
+		for (side = EASTSIDE; side <= NORTHSIDE; side++)
+		{
+			x = cell % map->width + G_xSteps [side];
+			y = cell / map->width + G_ySteps [side];
+
+			if (x < 0 || y < 0 || x >= map->width || y >= map->height)
+			{
+				continue;	// Stay within the map
+			}
+
+			if (*(labels + y * map->width + x) || !FLAGSET(GETMAPCELL(map,x,y)->flags,G_regionFlags [kind]))
+			{
+				continue;	// Skip labeled and unflagged cells
+			}
+
+			*(labels + y * map->width + x) = id + 1;
+			*(queue + tail++) = y * map->width + x;
+		}
+	}
+}
+
+/*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
+/********************************************************************
+*																	*
+*							Path graph maintenance					*
+*																	*
+********************************************************************/
+/*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
+
+/********************************************************************
+*	MarkPathCell - Note that a map cell's SOLID flag has changed	*
+*	Input:	Path graph; location of changed cell					*
+*	Output:	Cluster holding cell is rebuilt before next search		*
+********************************************************************/
+
+void MarkPathCell (PathGraph * graph, int x, int y)
+{
+	pPathCluster cluster;	// Cluster holding cell
+
+	assert (graph);
+	// Verify that graph points to valid memory
+
+	if (x < 0 || y < 0 || x >= graph->map->width || y >= graph->map->height)
+	{
+		return;	// Return if cell lies off the map
+	}
+
+	cluster = GETCLUSTER(graph,x,y);
+
+	if (!cluster->dirty)
+	{
+		cluster->dirty = TRUE;	// Flag cluster for rebuilding
+
+		graph->numDirty++;
+	}
+
+	graph->lastGoal.X = NOPATH;	// Held goal costs may be stale
+}
+
+/********************************************************************
+*	RefreshPathGraph - Rebuild clusters whose cells have changed	*
+*	Input:	Path graph to refresh									*
+*	Output:	Success													*
+********************************************************************/
+
+BOOL RefreshPathGraph (PathGraph * graph)
+{
+	pPathCluster cluster;	// Cluster being checked
+	int numClusters;		// Count of clusters over map
+	int xCluster, yCluster;	// Position of cluster among clusters
+	int i;					// Loop counter
+
+	assert (graph);
+	// Verify that graph points to valid memory
+
+	if (!graph->numDirty)
+	{
+		return TRUE;	// Return success if nothing has changed
+	}
+
+	numClusters = graph->xClusters * graph->yClusters;
+
+	for (i = 0; i < numClusters; i++)
+	{
+		cluster = graph->clusters + i;
+
+		if (!cluster->dirty)
+		{
+			continue;	// Skip unchanged clusters
+		}
+
+		xCluster = i % graph->xClusters;
+		yCluster = i / graph->xClusters;
+
+		BuildBorder (graph, i, EASTSIDE);
+		BuildBorder (graph, i, SOUTHSIDE);
+		// Rebuild the borders owned by the cluster
+
+		cluster->stale = TRUE;
+
+		if (xCluster > 0)
+		{
+			BuildBorder (graph, i - 1, EASTSIDE);
+			// Rebuild the border shared with the western neighbor
+
+			(cluster - 1)->stale = TRUE;
+		}
+
+		if (yCluster > 0)
+		{
+			BuildBorder (graph, i - graph->xClusters, SOUTHSIDE);
+			// Rebuild the border shared with the northern neighbor
+
+			(cluster - graph->xClusters)->stale = TRUE;
+		}
+
+		if (xCluster + 1 < graph->xClusters)
+		{
+			(cluster + 1)->stale = TRUE;
+		}
+
+		if (yCluster + 1 < graph->yClusters)
+		{
+			(cluster + graph->xClusters)->stale = TRUE;
+		}
+		// Neighbors' nodes move along with the shared borders
+
+		cluster->dirty = FALSE;
+	}
+
+	for (i = 0; i < numClusters; i++)
+	{
+		cluster = graph->clusters + i;
+
+		if (cluster->stale)
+		{
+			if (!GatherNodes (graph, i))
+			{
+				ERROR_MESSAGE("RefreshPathGraph failed","1");
+				// Return failure
+			}
+
+			cluster->stale = FALSE;
+		}
+	}
+
+	graph->numDirty = 0;
+
+	graph->lastGoal.X = NOPATH;	// Held goal costs may be stale
+
+	return TRUE;
+	// Return success
+}
+
+/********************************************************************
+*	BuildBorder - Place entrances along one border of a cluster		*
+*	Input:	Path graph; index of cluster; side of border			*
+********************************************************************/
+
+static void BuildBorder (PathGraph * graph, int cluster, int side)
+{
+	pPathCluster owner = graph->clusters + cluster;	// Cluster owning border
+	pPathBorder border;								// Border being built
+	int length;										// Length of border
+	int run = 0, begin = 0;							// Length and offset of current run of open cells
+	int x, y;										// Location of cell along border
+	int i;											// Loop counter
+	BOOL open;										// Indicates that cells on both sides are open
+
+	if (side == EASTSIDE)
+	{
+		border = graph->east + cluster;
+
+		border->numEntrances = 0;
+
+		if (cluster % graph->xClusters + 1 == graph->xClusters)
+		{
+			return;	// Return if border lies along map's edge
+		}
+
+		x = owner->bounds.right - 1;
+
+		length = owner->bounds.bottom - owner->bounds.top;
+	}
+
+	else
+	{
+		border = graph->south + cluster;
+
+		border->numEntrances = 0;
+
+		if (cluster / graph->xClusters + 1 == graph->yClusters)
+		{
+			return;	// Return if border lies along map's edge
+		}
+
+		y = owner->bounds.bottom - 1;
+
+		length = owner->bounds.right - owner->bounds.left;
+	}
+
+	for (i = 0; i <= length; i++)
+	{
+		open = FALSE;
+
+		if (i < length)
+		{
+			if (side == EASTSIDE)
+			{
+				y = owner->bounds.top + i;
+
+				open = PASSABLE(graph->map,x,y) && PASSABLE(graph->map,x + 1,y);
+			}
+
+			else
+			{
+				x = owner->bounds.left + i;
+
+				open = PASSABLE(graph->map,x,y) && PASSABLE(graph->map,x,y + 1);
+			}
+		}
+		// Check the cells on either side of the border
+
+		if (open)
+		{
+			if (!run)
+			{
+				begin = i;	// Begin a new run
+			}
+
+			run++;
+		}
+
+		else if (run)
+		{
+			if (run < WIDEENTRANCE)
+			{
+				(border->entrances + border->numEntrances++)->offset = begin + run / 2;
+				// Place a single entrance mid-run
+			}
+
+			else
+			{
+				(border->entrances + border->numEntrances++)->offset = begin;
+				(border->entrances + border->numEntrances++)->offset = begin + run - 1;
+				// Place an entrance at each end of a wide run
+			}
+
+			run = 0;
+		}
+	}
+}
+
+/********************************************************************
+*	GatherNodes - Collect a cluster's nodes and travel costs		*
+*	Input:	Path graph; index of cluster							*
+*	Output:	Success													*
+********************************************************************/
+
+static BOOL GatherNodes (PathGraph * graph, int cluster)
+{
+	pPathCluster owner = graph->clusters + cluster;	// Cluster being gathered
+	pPathBorder border;								// Border being walked
+	pPathEntrance entrance;							// Entrance along border
+	PCOORD node;									// Node being placed
+	int xCluster = cluster % graph->xClusters;		// Horizontal position of cluster
+	int yCluster = cluster / graph->xClusters;		// Vertical position of cluster
+	int side;										// Side of cluster being walked
+	int numNodes;									// Count of nodes
+	int i, j;										// Loop counters
+
+	owner->numNodes = 0;
+
+	for (side = EASTSIDE; side <= NORTHSIDE; side++)
+	{
+		switch (side)	// Get the border along this side
+		{
+		case EASTSIDE:	// East side case
+			border = xCluster + 1 < graph->xClusters ? graph->east + cluster : NULL;
+
+			break;	// Break out of switch statement
+
+		case SOUTHSIDE:	// South side case
+			border = yCluster + 1 < graph->yClusters ? graph->south + cluster : NULL;
+
+			break;	// Break out of switch statement
+
+		case WESTSIDE:	// West side case
+			border = xCluster ? graph->east + cluster - 1 : NULL;
+
+			break;	// Break out of switch statement
+
+		case NORTHSIDE:	// North side case
+			border = yCluster ? graph->south + cluster - graph->xClusters : NULL;
+
+			break;	// Break out of switch statement
+		}
+
+		if (!border)
+		{
+			continue;	// Skip sides along the map's edge
+		}
+
+		for (i = 0; i < border->numEntrances; i++)
+		{
+			entrance = border->entrances + i;
+			node = owner->nodes + owner->numNodes;
+
+			switch (side)	// Place node on this side of the entrance
+			{
+			case EASTSIDE:	// East side case
+				node->X = (SHORT) (owner->bounds.right - 1);
+				node->Y = (SHORT) (owner->bounds.top + entrance->offset);
+
+				entrance->nodeA = owner->numNodes;
+
+				break;	// Break out of switch statement
+
+			case SOUTHSIDE:	// South side case
+				node->X = (SHORT) (owner->bounds.left + entrance->offset);
+				node->Y = (SHORT) (owner->bounds.bottom - 1);
+
+				entrance->nodeA = owner->numNodes;
+
+				break;	// Break out of switch statement
+
+			case WESTSIDE:	// West side case
+				node->X = (SHORT) owner->bounds.left;
+				node->Y = (SHORT) (owner->bounds.top + entrance->offset);
+
+				entrance->nodeB = owner->numNodes;
+
+				break;	// Break out of switch statement
+
+			case NORTHSIDE:	// North side case
+				node->X = (SHORT) (owner->bounds.left + entrance->offset);
+				node->Y = (SHORT) owner->bounds.top;
+
+				entrance->nodeB = owner->numNodes;
+
+				break;	// Break out of switch statement
+			}
+
+			*(owner->sides + owner->numNodes) = (BYTE) side;
+			*(owner->entries + owner->numNodes) = (BYTE) i;
+
+			owner->numNodes++;
+		}
+	}
+
+	numNodes = owner->numNodes;
+
+	FREE(owner->costs);
+	// Release the previous cost matrix
+
+	if (!numNodes)
+	{
+		return TRUE;	// Return success if cluster is sealed off
+	}
+
+	CALLOC(owner->costs,numNodes * numNodes,int);
+
+	if (!owner->costs)
+	{
+		ERROR_MESSAGE("GatherNodes failed","1");
+		// Return failure
+	}
+	// Verify that owner's costs field points to valid memory
+
+	for (i = 0; i < numNodes; i++)
+	{
+		SearchCluster (graph, owner, *(owner->nodes + i));
+
+		for (j = i; j < numNodes; j++)
+		{
+			*(owner->costs + i * numNodes + j) = *(owner->costs + j * numNodes + i) = LocalDistance (graph, owner, *(owner->nodes + j));
+			// Costs are symmetric, so fill both halves of the matrix
+		}
+	}
+
+	return TRUE;
+	// Return success
+}
+
+/********************************************************************
+*	SearchCluster - Breadth-first search within a cluster			*
+*	Input:	Path graph; cluster to search; cell to search from		*
+*	Output:	Local distances and predecessors are filled in			*
+********************************************************************/
+
+static void SearchCluster (PathGraph * graph, PathCluster * cluster, COORD from)
+{
+	int width = cluster->bounds.right - cluster->bounds.left;	// Width of cluster
+	int height = cluster->bounds.bottom - cluster->bounds.top;	// Height of cluster
+	int head = 0, tail = 0;										// Ends of search queue
+	int cell, next;												// Cell being expanded; neighbor of cell
+	int x, y;													// Location of neighbor within cluster
+	int side;													// Side of cell being checked
+
+	if (!++graph->localStamp)
+	{
+		ZeroMemory (graph->localSeen, sizeof (graph->localSeen));
+
+		graph->localStamp = 1;
+	}
+	// Begin a new generation, clearing marks only when the stamp wraps
+
+	cell = (from.Y - cluster->bounds.top) * CLUSTER_SIZE + (from.X - cluster->bounds.left);
+
+	graph->localSeen [cell] = graph->localStamp;
+	graph->localDist [cell] = 0;
+	graph->localParent [cell] = NOPATH;
+	graph->localQueue [tail++] = cell;
+
+	while (head < tail)
+	{
+		cell = graph->localQueue [head++];
+
+		for (side = EASTSIDE; side <= NORTHSIDE; side++)
+		{
+			x = cell % CLUSTER_SIZE + G_xSteps [side];
+			y = cell / CLUSTER_SIZE + G_ySteps [side];
+
+			if (x < 0 || y < 0 || x >= width || y >= height)
+			{
+				continue;	// Stay within the cluster
+			}
+
+			next = y * CLUSTER_SIZE + x;
+
+			if (graph->localSeen [next] == graph->localStamp || !PASSABLE(graph->map,cluster->bounds.left + x,cluster->bounds.top + y))
+			{
+				continue;	// Skip visited and solid cells
+			}
+
+			graph->localSeen [next] = graph->localStamp;
+			graph->localDist [next] = graph->localDist [cell] + 1;
+			graph->localParent [next] = cell;
+			graph->localQueue [tail++] = next;
+		}
+	}
+}
+
+/********************************************************************
+*	LocalDistance - Distance to a cell found by SearchCluster		*
+*	Input:	Path graph; cluster that was searched; cell to check	*
+*	Output:	Distance, or NOPATH if cell was not reached				*
+********************************************************************/
+
+static int LocalDistance (PathGraph * graph, PathCluster * cluster, COORD to)
+{
+	int cell = (to.Y - cluster->bounds.top) * CLUSTER_SIZE + (to.X - cluster->bounds.left);
+	// Index of cell within cluster
+
+	return graph->localSeen [cell] == graph->localStamp ? graph->localDist [cell] : NOPATH;
+}
+
+/*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
+/********************************************************************
+*																	*
+*							Path queries							*
+*																	*
+********************************************************************/
+/*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
+
+/********************************************************************
+*	FindPath - Find a path between two map cells					*
+*	Input:	Path graph; cells to begin and end at; buffer to fill	*
+*			with steps; capacity of buffer							*
+*	Output:	Count of steps in path, or NOPATH if none exists		*
+********************************************************************/
+
+int FindPath (PathGraph * graph, COORD start, COORD goal, COORD * path, int maxLength)
+{
+	pMap map;		// Map being searched
+	int numRoute;	// Count of abstract nodes along route
+
+	assert (graph);
+	// Verify that graph points to valid memory
+
+	map = graph->map;
+
+	if (start.X < 0 || start.Y < 0 || start.X >= map->width || start.Y >= map->height
+		|| goal.X < 0 || goal.Y < 0 || goal.X >= map->width || goal.Y >= map->height)
+	{
+		return NOPATH;	// Return if either cell lies off the map
+	}
+
+	if (!PASSABLE(map,start.X,start.Y) || !PASSABLE(map,goal.X,goal.Y))
+	{
+		return NOPATH;	// Return if either cell is solid
+	}
+
+	if (!RefreshPathGraph (graph))
+	{
+		return NOPATH;	// Return failure
+	}
+
+	if (start.X == goal.X && start.Y == goal.Y)
+	{
+		return 0;	// Return an empty path
+	}
+
+	numRoute = SearchGraph (graph, start, goal);
+
+	if (numRoute == NOPATH)
+	{
+		return NOPATH;	// Return if goal cannot be reached
+	}
+
+	return RefineRoute (graph, numRoute, start, goal, path, maxLength);
+}
+
+/********************************************************************
+*	FindPaths - Answer a batch of path queries						*
+*	Input:	Path graph; array of queries; count of queries			*
+*	Output:	Count of queries for which a path was found				*
+********************************************************************/
+
+int FindPaths (PathGraph * graph, PathQuery * queries, int numQueries)
+{
+	pPathQuery * order;	// Queries, grouped by goal
+	pPathQuery query;	// Query being answered
+	int numFound = 0;	// Count of paths found
+	int i;				// Loop counter
+
+	assert (graph && queries);
+	// Verify that graph and queries point to valid memory
+
+	if (!RefreshPathGraph (graph))
+	{
+		return 0;	// Return failure
+	}
+	// Rebuild once for the whole batch
+
+	CALLOC(order,numQueries,pPathQuery);
+
+	if (order)	// Ensure that order points to something
+	{
+		for (i = 0; i < numQueries; i++)
+		{
+			*(order + i) = queries + i;
+		}
+
+		qsort (order, numQueries, sizeof (pPathQuery), CompareGoals);
+	}
+	// Answer queries sharing a goal back to back, so its held costs are reused
+
+	for (i = 0; i < numQueries; i++)
+	{
+		query = order ? *(order + i) : queries + i;
+
+		query->length = FindPath (graph, query->start, query->goal, query->path, query->maxLength);
+
+		if (query->length != NOPATH)
+		{
+			numFound++;
+		}
+	}
+
+	FREE(order);
+
+	return numFound;
+}
+
+/********************************************************************
+*	CompareGoals - Order path queries by goal, for qsort			*
+*	Input:	Addresses of two query pointers							*
+*	Output:	Negative, zero, or positive, as in strcmp				*
+********************************************************************/
+
+static int CompareGoals (void const * dataA, void const * dataB)
+{
+	PathQuery const * queryA = *(pPathQuery const *) dataA;
+	PathQuery const * queryB = *(pPathQuery const *) dataB;
+
+	if (queryA->goal.Y != queryB->goal.Y)
+	{
+		return queryA->goal.Y - queryB->goal.Y;
+	}
+
+	return queryA->goal.X - queryB->goal.X;
+}
+
+/********************************************************************
+*	SearchGraph - A* search over abstract nodes						*
+*	Input:	Path graph; cells to begin and end at					*
+*	Output:	Count of nodes along route, or NOPATH if none exists	*
+********************************************************************/
+
+static int SearchGraph (PathGraph * graph, COORD start, COORD goal)
+{
+	pPathCluster startCluster = GETCLUSTER(graph,start.X,start.Y);	// Cluster holding start
+	pPathCluster goalCluster = GETCLUSTER(graph,goal.X,goal.Y);		// Cluster holding goal
+	pPathCluster cluster;											// Cluster of node being expanded
+	int startSlot = graph->numSlots - 2;							// Slot of start node
+	int goalSlot = graph->numSlots - 1;								// Slot of goal node
+	int direct = NOPATH;											// Cost of a route kept within one cluster
+	int node, base, local;											// Node being expanded; its cluster's first slot; its index in cluster
+	int cost;														// Cost to node being expanded
+	int numRoute;													// Count of nodes along route
+	int i;															// Loop counter
+
+	SearchCluster (graph, startCluster, start);
+
+	for (i = 0; i < startCluster->numNodes; i++)
+	{
+		graph->startCosts [i] = LocalDistance (graph, startCluster, *(startCluster->nodes + i));
+	}
+	// Link start to its cluster's nodes
+
+	if (startCluster == goalCluster)
+	{
+		direct = LocalDistance (graph, startCluster, goal);
+	}
+	// Link start directly to goal if they share a cluster
+
+	if (goal.X != graph->lastGoal.X || goal.Y != graph->lastGoal.Y)
+	{
+		SearchCluster (graph, goalCluster, goal);
+
+		for (i = 0; i < goalCluster->numNodes; i++)
+		{
+			graph->goalCosts [i] = LocalDistance (graph, goalCluster, *(goalCluster->nodes + i));
+		}
+
+		graph->lastGoal = goal;
+	}
+	// Link goal's cluster's nodes to goal, unless they are already held
+
+	if (!++graph->stamp)
+	{
+		ZeroMemory (graph->visited, graph->numSlots * sizeof (DWORD));
+
+		graph->stamp = 1;
+	}
+	// Begin a new generation, clearing marks only when the stamp wraps
+
+	graph->heapSize = 0;
+
+	RelaxNode (graph, startSlot, NOPATH, 0, start, goal);
+
+	while (graph->heapSize)
+	{
+		node = *graph->heap;
+
+		if (--graph->heapSize)
+		{
+			*graph->heap = *(graph->heap + graph->heapSize);
+			*(graph->heapIndex + *graph->heap) = 0;
+
+			SiftDown (graph, 0);
+		}
+		// Pop the most promising node
+
+		*(graph->closed + node) = TRUE;
+
+		if (node == goalSlot)
+		{
+			break;	// Break out of loop
+		}
+
+		cost = *(graph->costs + node);
+
+		if (node == startSlot)
+		{
+			base = (startCluster - graph->clusters) * CLUSTER_NODES;
+
+			for (i = 0; i < startCluster->numNodes; i++)
+			{
+				if (graph->startCosts [i] != NOPATH)
+				{
+					RelaxNode (graph, base + i, node, graph->startCosts [i], *(startCluster->nodes + i), goal);
+				}
+			}
+
+			if (direct != NOPATH)
+			{
+				RelaxNode (graph, goalSlot, node, direct, goal, goal);
+			}
+
+			continue;	// Continue with next node
+		}
+
+		base = node - node % CLUSTER_NODES;
+		local = node % CLUSTER_NODES;
+
+		cluster = graph->clusters + node / CLUSTER_NODES;
+
+		for (i = 0; i < cluster->numNodes; i++)
+		{
+			if (i != local && *(cluster->costs + local * cluster->numNodes + i) != NOPATH)
+			{
+				RelaxNode (graph, base + i, node, cost + *(cluster->costs + local * cluster->numNodes + i), *(cluster->nodes + i), goal);
+			}
+		}
+		// Cross the cluster to its other nodes
+
+		i = PartnerNode (graph, node);
+
+		RelaxNode (graph, i, node, cost + 1, NodeLocation (graph, i, start, goal), goal);
+		// Step across the border
+
+		if (cluster == goalCluster && graph->goalCosts [local] != NOPATH)
+		{
+			RelaxNode (graph, goalSlot, node, cost + graph->goalCosts [local], goal, goal);
+		}
+		// Step onto the goal
+	}
+
+	if (*(graph->visited + goalSlot) != graph->stamp || !*(graph->closed + goalSlot))
+	{
+		return NOPATH;	// Return if goal was never reached
+	}
+
+	for (numRoute = 0, node = goalSlot; node != NOPATH; node = *(graph->parents + node))
+	{
+		numRoute++;
+	}
+
+	for (i = numRoute - 1, node = goalSlot; node != NOPATH; node = *(graph->parents + node))
+	{
+		*(graph->route + i--) = node;
+	}
+	// Lay out route from start to goal
+
+	return numRoute;
+}
+
+/********************************************************************
+*	RefineRoute - Expand a route of abstract nodes into cells		*
+*	Input:	Path graph; count of route nodes; cells to begin and	*
+*			end at; buffer to fill; capacity of buffer				*
+*	Output:	Count of steps in path									*
+********************************************************************/
+
+static int RefineRoute (PathGraph * graph, int numRoute, COORD start, COORD goal, COORD * path, int maxLength)
+{
+	pPathCluster cluster;	// Cluster holding a leg of the route
+	COORD from, to, step;	// Ends of a leg of the route; step along leg
+	int length = 0;			// Count of steps in path
+	int cell, last;			// Cell along leg; last cell of leg
+	int i;					// Loop counter
+
+	for (i = 1; i < numRoute; i++)
+	{
+		from = NodeLocation (graph, *(graph->route + i - 1), start, goal);
+		to = NodeLocation (graph, *(graph->route + i), start, goal);
+
+		if (from.X == to.X && from.Y == to.Y)
+		{
+			continue;	// Skip nodes sharing a cell
+		}
+
+		cluster = GETCLUSTER(graph,from.X,from.Y);
+
+		if (cluster != GETCLUSTER(graph,to.X,to.Y))
+		{
+			if (path && length < maxLength)
+			{
+				*(path + length) = to;
+			}
+
+			length++;
+
+			continue;	// Step across the border
+		}
+
+		SearchCluster (graph, cluster, to);
+		// Search back from the leg's end, so that predecessors lead forward
+
+		cell = (from.Y - cluster->bounds.top) * CLUSTER_SIZE + (from.X - cluster->bounds.left);
+		last = (to.Y - cluster->bounds.top) * CLUSTER_SIZE + (to.X - cluster->bounds.left);
+
+		while (cell != last)
+		{
+			cell = graph->localParent [cell];
+
+			step.X = (SHORT) (cluster->bounds.left + cell % CLUSTER_SIZE);
+			step.Y = (SHORT) (cluster->bounds.top + cell / CLUSTER_SIZE);
+
+			if (path && length < maxLength)
+			{
+				*(path + length) = step;
+			}
+
+			length++;
+		}
+		// Walk the leg within the cluster
+	}
+
+	return length;
+}
+
+/********************************************************************
+*	NodeLocation - Get the cell of an abstract node					*
+*	Input:	Path graph; node index; cells to begin and end at		*
+*	Output:	Cell of node											*
+********************************************************************/
+
+static COORD NodeLocation (PathGraph * graph, int node, COORD start, COORD goal)
+{
+	if (node == graph->numSlots - 2)
+	{
+		return start;	// Return start's cell
+	}
+
+	if (node == graph->numSlots - 1)
+	{
+		return goal;	// Return goal's cell
+	}
+
+	return *((graph->clusters + node / CLUSTER_NODES)->nodes + node % CLUSTER_NODES);
+}
+
+/********************************************************************
+*	PartnerNode - Get the node across the border from a node		*
+*	Input:	Path graph; node index									*
+*	Output:	Index of partner node									*
+********************************************************************/
+
+static int PartnerNode (PathGraph * graph, int node)
+{
+	int cluster = node / CLUSTER_NODES;									// Index of node's cluster
+	int local = node % CLUSTER_NODES;									// Index of node within cluster
+	int entry = *((graph->clusters + cluster)->entries + local);		// Entrance index along border
+	int partner;														// Partner's cluster
+
+	switch (*((graph->clusters + cluster)->sides + local))	// Get the side node lies on
+	{
+	case EASTSIDE:	// East side case
+		partner = cluster + 1;
+
+		return partner * CLUSTER_NODES + ((graph->east + cluster)->entrances + entry)->nodeB;
+
+	case SOUTHSIDE:	// South side case
+		partner = cluster + graph->xClusters;
+
+		return partner * CLUSTER_NODES + ((graph->south + cluster)->entrances + entry)->nodeB;
+
+	case WESTSIDE:	// West side case
+		partner = cluster - 1;
+
+		return partner * CLUSTER_NODES + ((graph->east + partner)->entrances + entry)->nodeA;
+
+	default:		// North side case
+		partner = cluster - graph->xClusters;
+
+		return partner * CLUSTER_NODES + ((graph->south + partner)->entrances + entry)->nodeA;
+	}
+}
+
+/********************************************************************
+*	RelaxNode - Offer a cheaper route to a node						*
+*	Input:	Path graph; node to reach; node reached from; cost of	*
+*			route; cell of node; goal cell							*
+********************************************************************/
+
+static void RelaxNode (PathGraph * graph, int node, int from, int cost, COORD location, COORD goal)
+{
+	int estimate = abs (goal.X - location.X) + abs (goal.Y - location.Y);
+	// Manhattan distance, which never overestimates on a four-way grid
+
+	if (*(graph->visited + node) != graph->stamp)
+	{
+		*(graph->visited + node) = graph->stamp;
+		*(graph->closed + node) = FALSE;
+
+		*(graph->costs + node) = cost;
+		*(graph->scores + node) = cost + estimate;
+		*(graph->parents + node) = from;
+
+		*(graph->heapIndex + node) = graph->heapSize;
+		*(graph->heap + graph->heapSize++) = node;
+
+		SiftUp (graph, graph->heapSize - 1);
+		// Open a node seen for the first time
+
+		return;
+	}
+
+	if (*(graph->closed + node) || cost >= *(graph->costs + node))
+	{
+		return;	// Return if route is no improvement
+	}
+
+	*(graph->costs + node) = cost;
+	*(graph->scores + node) = cost + estimate;
+	*(graph->parents + node) = from;
+
+	SiftUp (graph, *(graph->heapIndex + node));
+	// Promote the cheapened node
+}
+
+/********************************************************************
+*	SiftUp - Move an open list entry toward the front				*
+*	Input:	Path graph; position of entry							*
+********************************************************************/
+
+static void SiftUp (PathGraph * graph, int position)
+{
+	int node = *(graph->heap + position);	// Node being moved
+	int parent;								// Position of parent entry
+
+	while (position)
+	{
+		parent = (position - 1) >> 1;
+
+		if (*(graph->scores + *(graph->heap + parent)) <= *(graph->scores + node))
+		{
+			break;	// Break out of loop
+		}
+
+		*(graph->heap + position) = *(graph->heap + parent);
+		*(graph->heapIndex + *(graph->heap + position)) = position;
+
+		position = parent;
+	}
+
+	*(graph->heap + position) = node;
+	*(graph->heapIndex + node) = position;
+}
+
+/********************************************************************
+*	SiftDown - Move an open list entry toward the back				*
+*	Input:	Path graph; position of entry							*
+********************************************************************/
+
+static void SiftDown (PathGraph * graph, int position)
+{
+	int node = *(graph->heap + position);	// Node being moved
+	int child;								// Position of lesser child entry
+
+	while ((child = (position << 1) + 1) < graph->heapSize)
+	{
+		if (child + 1 < graph->heapSize && *(graph->scores + *(graph->heap + child + 1)) < *(graph->scores + *(graph->heap + child)))
+		{
+			child++;	// Pick the lesser child
+		}
+
+		if (*(graph->scores + node) <= *(graph->scores + *(graph->heap + child)))
+		{
+			break;	// Break out of loop
+		}
+
+		*(graph->heap + position) = *(graph->heap + child);
+		*(graph->heapIndex + *(graph->heap + position)) = position;
+
+		position = child;
+	}
+
+	*(graph->heap + position) = node;
+	*(graph->heapIndex + node) = position;
+}
+
+/*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
+/********************************************************************
+*																	*
+*							Visibility								*
+*																	*
+********************************************************************/
+/*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
+
+/********************************************************************
+*	MarkSightCell - Note that a map cell's blocking flags changed	*
+*	Input:	Field of view; location of changed cell					*
+*	Output:	View is recast on next update if cell was in range		*
+********************************************************************/
+
+void MarkSightCell (Sight * sight, int x, int y)
+{
+	assert (sight);
+	// Verify that sight points to valid memory
+
+	if (abs (x - sight->viewer.X) <= sight->radius && abs (y - sight->viewer.Y) <= sight->radius)
+	{
+		sight->dirty = TRUE;	// Flag view for recasting
+	}
+	// Blockers out of range cannot change what is seen
+}
+
+/********************************************************************
+*	UpdateSight - Recast a field of view if it is out of date		*
+*	Input:	Field of view; cell to view from						*
+*	Output:	Indicates whether view was recast						*
+********************************************************************/
+
+BOOL UpdateSight (Sight * sight, COORD viewer)
+{
+	int octant;	// Octant being cast
+
+	assert (sight);
+	// Verify that sight points to valid memory
+
+	if (!sight->dirty && viewer.X == sight->viewer.X && viewer.Y == sight->viewer.Y)
+	{
+		return FALSE;	// Return if cached view still holds
+	}
+
+	sight->viewer = viewer;
+
+	ZeroMemory (sight->visible, sight->span * sight->span);
+
+	if (viewer.X >= 0 && viewer.Y >= 0 && viewer.X < sight->map->width && viewer.Y < sight->map->height)
+	{
+		*SIGHTCELL(sight,viewer.X,viewer.Y) = TRUE;
+		// The viewer always sees its own cell
+
+		for (octant = 0; octant < 8; octant++)
+		{
+			CastLight (sight, 1, 1.0f, 0.0f, octant);
+		}
+	}
+
+	sight->dirty = FALSE;
+
+	return TRUE;
+}
+
+/********************************************************************
+*	CellVisible - Determine whether a map cell can be seen			*
+*	Input:	Field of view; location of cell							*
+*	Output:	Visibility of cell										*
+********************************************************************/
+
+BOOL CellVisible (Sight * sight, int x, int y)
+{
+	assert (sight);
+	// Verify that sight points to valid memory
+
+	if (abs (x - sight->viewer.X) > sight->radius || abs (y - sight->viewer.Y) > sight->radius)
+	{
+		return FALSE;	// Return if cell lies out of range
+	}
+
+	return *SIGHTCELL(sight,x,y);
+}
+
+/********************************************************************
+*	LineOfSight - Determine whether two map cells see each other	*
+*	Input:	Map; cells at either end of line						*
+*	Output:	Indicates that no blocker lies between the cells		*
+********************************************************************/
+
+BOOL LineOfSight (Map * map, COORD from, COORD to)
+{
+	int dx = abs (to.X - from.X), dy = abs (to.Y - from.Y);	// Extent of line
+	int xStep = from.X < to.X ? 1 : -1;						// Horizontal direction of line
+	int yStep = from.Y < to.Y ? 1 : -1;						// Vertical direction of line
+	int error = dx - dy;									// Bresenham error term
+	int twice;												// Error term doubled, taken before stepping
+	int x = from.X, y = from.Y;								// Cell along line
+
+	assert (map);
+	// Verify that map points to valid memory
+
+	while (x != to.X || y != to.Y)
+	{
+		twice = error << 1;
+
+		if (twice > -dy)
+		{
+			error -= dy;
+			x += xStep;
+		}
+
+		if (twice < dx)
+		{
+			error += dx;
+			y += yStep;
+		}
+		// Step along the line
+
+		if ((x != to.X || y != to.Y) && BLOCKSSIGHT(map,x,y))
+		{
+			return FALSE;	// Return if a blocker lies between the ends
+		}
+	}
+
+	return TRUE;
+}
+
+/********************************************************************
+*	CastLight - Recursively shadowcast one octant of a view			*
+*	Input:	Field of view; row to begin at; slopes bounding the		*
+*			lit region; octant to cast through						*
+********************************************************************/
+
+static void CastLight (Sight * sight, int row, float start, float end, int octant)
+{
+	intStar transform = G_octants [octant];					// Octant's row and column transform
+	int radiusSquared = sight->radius * sight->radius;		// Square of view radius
+	int dx, dy;												// Column and row within octant
+	int x, y;												// Map location of cell
+	float leftSlope, rightSlope;							// Slopes bounding cell
+	float newStart = 0.0f;									// Start slope beyond a run of blockers
+	BOOL blocked = FALSE;									// Indicates that a run of blockers is being scanned
+	BOOL opaque;											// Indicates that cell blocks view
+
+	if (start < end)
+	{
+		return;	// Return if region has closed off
+	}
+
+	for (dy = -row; -dy <= sight->radius && !blocked; dy--)
+	{
+		for (dx = dy - 1; dx < 0; )
+		{
+			dx++;
+
+			x = sight->viewer.X + dx * *transform + dy * *(transform + 1);
+			y = sight->viewer.Y + dx * *(transform + 2) + dy * *(transform + 3);
+
+			leftSlope = (dx - 0.5f) / (dy + 0.5f);
+			rightSlope = (dx + 0.5f) / (dy - 0.5f);
+
+			if (start < rightSlope)
+			{
+				continue;	// Cell lies before the lit region
+			}
+
+			if (end > leftSlope)
+			{
+				break;	// Cell lies beyond the lit region
+			}
+
+			opaque = x < 0 || y < 0 || x >= sight->map->width || y >= sight->map->height || BLOCKSSIGHT(sight->map,x,y);
+			// Treat the world beyond the map as opaque
+
+			if (x >= 0 && y >= 0 && x < sight->map->width && y < sight->map->height && dx * dx + dy * dy <= radiusSquared)
+			{
+				*SIGHTCELL(sight,x,y) = TRUE;
+			}
+			// Light cells within the view radius
+
+			if (blocked)
+			{
+				if (opaque)
+				{
+					newStart = rightSlope;	// Carry on through the run of blockers
+
+					continue;
+				}
+
+				blocked = FALSE;
+				start = newStart;
+				// Leave the run of blockers
+			}
+
+			else if (opaque && -dy < sight->radius)
+			{
+				blocked = TRUE;
+
+				CastLight (sight, 1 - dy, start, leftSlope, octant);
+				// Light the region before the blocker
+
+				newStart = rightSlope;
+			}
+		}
+	}
+}
+
+/*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
+/********************************************************************
+*																	*
+*							Region triggers							*
+*																	*
+********************************************************************/
+/*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
+
+/********************************************************************
+*	SetRegionHandler - Set the function called on region events		*
+*	Input:	Region index; function to call							*
+********************************************************************/
+
+void SetRegionHandler (RegionIndex * index, int (* handler) (pRegionActor, pRegion, RegionEvent))
+{
+	assert (index);
+	// Verify that index points to valid memory
+
+	index->handler = handler;	// Assign the handler
+}
+
+/********************************************************************
+*	FindActorRegions - Find the regions an area overlaps			*
+*	Input:	Region index; cells covered, right and bottom excluded;	*
+*			buffer to receive region IDs; capacity of buffer		*
+*	Output:	Count of regions overlapped								*
+********************************************************************/
+
+int FindActorRegions (RegionIndex * index, RECT const * bounds, int * regions, int maxRegions)
+{
+	int left, top, right, bottom;	// Bounds clipped against map
+	int numRegions = 0;				// Count of regions found
+	int kind;						// Kind of region being checked
+	int label;						// Label of cell
+	int x, y;						// Location of cell
+
+	assert (index && bounds && regions);
+	// Verify that index, bounds, and regions point to valid memory
+
+	left = bounds->left < 0 ? 0 : bounds->left;
+	top = bounds->top < 0 ? 0 : bounds->top;
+	right = bounds->right > index->map->width ? index->map->width : bounds->right;
+	bottom = bounds->bottom > index->map->height ? index->map->height : bounds->bottom;
+	// Clip bounds against the map
+
+	for (kind = 0; kind < REGIONKINDS; kind++)
+	{
+		for (y = top; y < bottom; y++)
+		{
+			for (x = left; x < right; x++)
+			{
+				label = *GETLABEL(index,kind,x,y);
+
+				if (label && numRegions < maxRegions && !HasRegion (regions, numRegions, label - 1))
+				{
+					*(regions + numRegions++) = label - 1;
+				}
+			}
+		}
+	}
+	// Cost follows the area covered, not the size of the map
+
+	return numRegions;
+}
+
+/********************************************************************
+*	UpdateRegionActors - Fire enter and exit events for actors		*
+*	Input:	Region index; array of actors, with bounds already		*
+*			moved; count of actors									*
+*	Output:	Count of events fired									*
+********************************************************************/
+
+int UpdateRegionActors (RegionIndex * index, RegionActor * actors, int numActors)
+{
+	pRegionActor actor;					// Actor being updated
+	int current [ACTOR_REGIONS];		// Regions now overlapped
+	int numCurrent;						// Count of regions now overlapped
+	int numEvents = 0;					// Count of events fired
+	int i, j;							// Loop counters
+
+	assert (index && actors);
+	// Verify that index and actors point to valid memory
+
+	for (i = 0; i < numActors; i++)
+	{
+		actor = actors + i;
+
+		numCurrent = FindActorRegions (index, &actor->bounds, current, ACTOR_REGIONS);
+
+		for (j = 0; j < actor->numRegions; j++)
+		{
+			if (!HasRegion (current, numCurrent, actor->regions [j]))
+			{
+				if (index->handler)
+				{
+					index->handler (actor, index->regions + actor->regions [j], kRegionExit);
+				}
+
+				numEvents++;
+			}
+		}
+		// Report regions left behind
+
+		for (j = 0; j < numCurrent; j++)
+		{
+			if (!HasRegion (actor->regions, actor->numRegions, current [j]))
+			{
+				if (index->handler)
+				{
+					index->handler (actor, index->regions + current [j], kRegionEnter);
+				}
+
+				numEvents++;
+			}
+		}
+		// Report regions newly entered
+
+		memcpy (actor->regions, current, numCurrent * sizeof (int));
+
+		actor->numRegions = numCurrent;
+	}
+
+	return numEvents;
+}
+
+/********************************************************************
+*	HasRegion - Determine whether a region ID is in a list			*
+*	Input:	List of region IDs; count of IDs; ID to find			*
+*	Output:	Presence of ID											*
+********************************************************************/
+
+static BOOL HasRegion (int const * regions, int numRegions, int id)
+{
+	int i;	// Loop counter
+
+	for (i = 0; i < numRegions; i++)
+	{
+		if (*(regions + i) == id)
+		{
+			return TRUE;	// Return if ID is found
+		}
+	}
+
+	return FALSE;
+}
+
+/*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
+/********************************************************************
+*																	*
+*							Destruction								*
+*																	*
+********************************************************************/
+/*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
+
+/********************************************************************
+*	DestroyPathGraph - Release a path graph's memory				*
+*	Input:	Path graph to destroy									*
+********************************************************************/
+
+void DestroyPathGraph (PathGraph * graph)
+{
+	int i;	// Loop counter
+
+	if (!graph)	// Ensure that graph points to something
+	{
+		return;	// Return if graph is NULL
+	}
+
+	if (graph->clusters)
+	{
+		for (i = 0; i < graph->xClusters * graph->yClusters; i++)
+		{
+			FREE((graph->clusters + i)->costs);
+			// Free each cluster's cost matrix
+		}
+
+		FREE(graph->clusters);
+	}
+
+	FREE(graph->east);
+	FREE(graph->south);
+
+	FREE(graph->visited);
+	FREE(graph->closed);
+	FREE(graph->costs);
+	FREE(graph->scores);
+	FREE(graph->parents);
+	FREE(graph->heap);
+	FREE(graph->heapIndex);
+	FREE(graph->route);
+}
+
+/********************************************************************
+*	DestroySight - Release a field of view's memory					*
+*	Input:	Field of view to destroy								*
+********************************************************************/
+
+void DestroySight (Sight * sight)
+{
+	if (!sight)	// Ensure that sight points to something
+	{
+		return;	// Return if sight is NULL
+	}
+
+	FREE(sight->visible);
+}
+
+/********************************************************************
+*	DestroyRegionIndex - Release a region index's memory			*
+*	Input:	Region index to destroy									*
+********************************************************************/
+
+void DestroyRegionIndex (RegionIndex * index)
+{
+	if (!index)	// Ensure that index points to something
+	{
+		return;	// Return if index is NULL
+	}
+
+	FREE(index->regions);
+	FREE(index->labels);
+}
@@ -0,0 +1,376 @@
+/********************************************************************
+*																	*
+*							World.h									*
+*																	*
+*	Author:		Steven Johnson										*
+*	Purpose:	Contains information relevant to world management	*
+*																	*
+********************************************************************/
+
+#ifndef WORLD_H
+#define WORLD_H
+
+#include "Common.h"
+
+/*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
+/********************************************************************
+*																	*
+*							Macros									*
+*																	*
+********************************************************************/
+/*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
+
+#define GETMAPCELL(map,x,y)						\
+	((map)->world.buffer + (y) * (map)->width + (x))
+// Used to retrieve the cell at a given map location
+
+#define PASSABLE(map,x,y)						\
+	!FLAGSET(GETMAPCELL(map,x,y)->flags,SOLID)
+// Used to determine whether a map location may be walked upon
+
+#define GETCLUSTER(graph,x,y)					\
+	((graph)->clusters + ((y) / CLUSTER_SIZE) * (graph)->xClusters + (x) / CLUSTER_SIZE)
+// Used to retrieve the path cluster holding a given map location
+
+#define BLOCKSSIGHT(map,x,y)					\
+	FLAGSET(GETMAPCELL(map,x,y)->flags,OBSCURE | SOLID)
+// Used to determine whether a map location blocks the view
+
+#define SIGHTCELL(sight,x,y)					\
+	((sight)->visible + ((y) - (sight)->viewer.Y + (sight)->radius) * (sight)->span \
+					  + ((x) - (sight)->viewer.X + (sight)->radius))
+// Used to retrieve the visibility of a map location near the viewer
+
+#define GETLABEL(index,kind,x,y)				\
+	((index)->labels + ((kind) * (index)->map->height + (y)) * (index)->map->width + (x))
+// Used to retrieve the region label of a map location for one flag
+
+/*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
+/********************************************************************
+*																	*
+*							Defines									*
+*																	*
+********************************************************************/
+/*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
+
+#define EASTSIDE			0x0
+// A node that lies on the east border of a path cluster
+#define SOUTHSIDE			0x1
+// A node that lies on the south border of a path cluster
+#define WESTSIDE			0x2
+// A node that lies on the west border of a path cluster
+#define NORTHSIDE			0x3
+// A node that lies on the north border of a path cluster
+
+#define WIDEENTRANCE		6
+// Length at which a run of open border cells gets an entrance at
+// each end, rather than one in the middle
+
+#define NOPATH				-1
+// Cost or length denoting that no path exists
+
+#define REGIONKINDS			3
+// Count of flags that form trigger regions: TRIGGER, DANGER, and EXIT
+
+/*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
+/********************************************************************
+*																	*
+*							Construction							*
+*																	*
+********************************************************************/
+/*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
+
+/********************************************************************
+*	MakePathGraph - Build an abstract path graph over a map			*
+*	Input:	Path graph to build; map to build graph over			*
+*	Output:	Success													*
+********************************************************************/
+
+BOOL MakePathGraph (pPathGraph graph, pMap map);
+
+/********************************************************************
+*	MakeSight - Prepare a field of view over a map					*
+*	Input:	Field of view to prepare; map to view; view radius		*
+*	Output:	Success													*
+********************************************************************/
+
+BOOL MakeSight (pSight sight, pMap map, int radius);
+
+/********************************************************************
+*	MakeRegionIndex - Group a map's flagged cells into regions		*
+*	Input:	Region index to build; map to index						*
+*	Output:	Success													*
+********************************************************************/
+
+BOOL MakeRegionIndex (pRegionIndex index, pMap map);
+
+/********************************************************************
+*	FloodRegion - Label the cells connected to a flagged cell		*
+*	Input:	Region index; kind of flag; cell to begin at; region	*
+*			ID; queue with room for every map cell					*
+********************************************************************/
+
+static void FloodRegion (pRegionIndex index, int kind, int cell, int id, intStar queue);
+
+/*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
+/********************************************************************
+*																	*
+*							Path graph maintenance					*
+*																	*
+********************************************************************/
+/*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
+
+/********************************************************************
+*	MarkPathCell - Note that a map cell's SOLID flag has changed	*
+*	Input:	Path graph; location of changed cell					*
+*	Output:	Cluster holding cell is rebuilt before next search		*
+********************************************************************/
+
+void MarkPathCell (pPathGraph graph, int x, int y);
+
+/********************************************************************
+*	RefreshPathGraph - Rebuild clusters whose cells have changed	*
+*	Input:	Path graph to refresh									*
+*	Output:	Success													*
+********************************************************************/
+
+BOOL RefreshPathGraph (pPathGraph graph);
+
+/********************************************************************
+*	BuildBorder - Place entrances along one border of a cluster		*
+*	Input:	Path graph; index of cluster; side of border			*
+********************************************************************/
+
+static void BuildBorder (pPathGraph graph, int cluster, int side);
+
+/********************************************************************
+*	GatherNodes - Collect a cluster's nodes and travel costs		*
+*	Input:	Path graph; index of cluster							*
+*	Output:	Success													*
+********************************************************************/
+
+static BOOL GatherNodes (pPathGraph graph, int cluster);
+
+/********************************************************************
+*	SearchCluster - Breadth-first search within a cluster			*
+*	Input:	Path graph; cluster to search; cell to search from		*
+*	Output:	Local distances and predecessors are filled in			*
+********************************************************************/
+
+static void SearchCluster (pPathGraph graph, pPathCluster cluster, COORD from);
+
+/********************************************************************
+*	LocalDistance - Distance to a cell found by SearchCluster		*
+*	Input:	Path graph; cluster that was searched; cell to check	*
+*	Output:	Distance, or NOPATH if cell was not reached				*
+********************************************************************/
+
+static int LocalDistance (pPathGraph graph, pPathCluster cluster, COORD to);
+
+/*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
+/********************************************************************
+*																	*
+*							Path queries							*
+*																	*
+********************************************************************/
+/*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
+
+/********************************************************************
+*	FindPath - Find a path between two map cells					*
+*	Input:	Path graph; cells to begin and end at; buffer to fill	*
+*			with steps; capacity of buffer							*
+*	Output:	Count of steps in path, or NOPATH if none exists		*
+********************************************************************/
+
+int FindPath (pPathGraph graph, COORD start, COORD goal, PCOORD path, int maxLength);
+
+/********************************************************************
+*	FindPaths - Answer a batch of path queries						*
+*	Input:	Path graph; array of queries; count of queries			*
+*	Output:	Count of queries for which a path was found				*
+********************************************************************/
+
+int FindPaths (pPathGraph graph, pPathQuery queries, int numQueries);
+
+/********************************************************************
+*	CompareGoals - Order path queries by goal, for qsort			*
+*	Input:	Addresses of two query pointers							*
+*	Output:	Negative, zero, or positive, as in strcmp				*
+********************************************************************/
+
+static int CompareGoals (void const * dataA, void const * dataB);
+
+/********************************************************************
+*	SearchGraph - A* search over abstract nodes						*
+*	Input:	Path graph; cells to begin and end at					*
+*	Output:	Count of nodes along route, or NOPATH if none exists	*
+********************************************************************/
+
+static int SearchGraph (pPathGraph graph, COORD start, COORD goal);
+
+/********************************************************************
+*	RefineRoute - Expand a route of abstract nodes into cells		*
+*	Input:	Path graph; count of route nodes; cells to begin and	*
+*			end at; buffer to fill; capacity of buffer				*
+*	Output:	Count of steps in path									*
+********************************************************************/
+
+static int RefineRoute (pPathGraph graph, int numRoute, COORD start, COORD goal, PCOORD path, int maxLength);
+
+/********************************************************************
+*	NodeLocation - Get the cell of an abstract node					*
+*	Input:	Path graph; node index; cells to begin and end at		*
+*	Output:	Cell of node											*
+********************************************************************/
+
+static COORD NodeLocation (pPathGraph graph, int node, COORD start, COORD goal);
+
+/********************************************************************
+*	PartnerNode - Get the node across the border from a node		*
+*	Input:	Path graph; node index									*
+*	Output:	Index of partner node									*
+********************************************************************/
+
+static int PartnerNode (pPathGraph graph, int node);
+
+/********************************************************************
+*	RelaxNode - Offer a cheaper route to a node						*
+*	Input:	Path graph; node to reach; node reached from; cost of	*
+*			route; cell of node; goal cell							*
+********************************************************************/
+
+static void RelaxNode (pPathGraph graph, int node, int from, int cost, COORD location, COORD goal);
+
+/********************************************************************
+*	SiftUp - Move an open list entry toward the front				*
+*	Input:	Path graph; position of entry							*
+********************************************************************/
+
+static void SiftUp (pPathGraph graph, int position);
+
+/********************************************************************
+*	SiftDown - Move an open list entry toward the back				*
+*	Input:	Path graph; position of entry							*
+********************************************************************/
+
+static void SiftDown (pPathGraph graph, int position);
+
+/*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
+/********************************************************************
+*																	*
+*							Visibility								*
+*																	*
+********************************************************************/
+/*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
+
+/********************************************************************
+*	MarkSightCell - Note that a map cell's blocking flags changed	*
+*	Input:	Field of view; location of changed cell					*
+*	Output:	View is recast on next update if cell was in range		*
+********************************************************************/
+
+void MarkSightCell (pSight sight, int x, int y);
+
+/********************************************************************
+*	UpdateSight - Recast a field of view if it is out of date		*
+*	Input:	Field of view; cell to view from						*
+*	Output:	Indicates whether view was recast						*
+********************************************************************/
+
+BOOL UpdateSight (pSight sight, COORD viewer);
+
+/********************************************************************
+*	CellVisible - Determine whether a map cell can be seen			*
+*	Input:	Field of view; location of cell							*
+*	Output:	Visibility of cell										*
+********************************************************************/
+
+BOOL CellVisible (pSight sight, int x, int y);
+
+/********************************************************************
+*	LineOfSight - Determine whether two map cells see each other	*
+*	Input:	Map; cells at either end of line						*
+*	Output:	Indicates that no blocker lies between the cells		*
+********************************************************************/
+
+BOOL LineOfSight (pMap map, COORD from, COORD to);
+
+/********************************************************************
+*	CastLight - Recursively shadowcast one octant of a view			*
+*	Input:	Field of view; row to begin at; slopes bounding the		*
+*			lit region; octant to cast through						*
+********************************************************************/
+
+static void CastLight (pSight sight, int row, float start, float end, int octant);
+
+/*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
+/********************************************************************
+*																	*
+*							Region triggers							*
+*																	*
+********************************************************************/
+/*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
+
+/********************************************************************
+*	SetRegionHandler - Set the function called on region events		*
+*	Input:	Region index; function to call							*
+********************************************************************/
+
+void SetRegionHandler (pRegionIndex index, int (* handler) (pRegionActor, pRegion, RegionEvent));
+
+/********************************************************************
+*	FindActorRegions - Find the regions an area overlaps			*
+*	Input:	Region index; cells covered, right and bottom excluded;	*
+*			buffer to receive region IDs; capacity of buffer		*
+*	Output:	Count of regions overlapped								*
+********************************************************************/
+
+int FindActorRegions (pRegionIndex index, RECT const * bounds, intStar regions, int maxRegions);
+
+/********************************************************************
+*	UpdateRegionActors - Fire enter and exit events for actors		*
+*	Input:	Region index; array of actors, with bounds already		*
+*			moved; count of actors									*
+*	Output:	Count of events fired									*
+********************************************************************/
+
+int UpdateRegionActors (pRegionIndex index, pRegionActor actors, int numActors);
+
+/********************************************************************
+*	HasRegion - Determine whether a region ID is in a list			*
+*	Input:	List of region IDs; count of IDs; ID to find			*
+*	Output:	Presence of ID											*
+********************************************************************/
+
+static BOOL HasRegion (int const * regions, int numRegions, int id);
+
+/*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
+/********************************************************************
+*																	*
+*							Destruction								*
+*																	*
+********************************************************************/
+/*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
+
+/********************************************************************
+*	DestroyPathGraph - Release a path graph's memory				*
+*	Input:	Path graph to destroy									*
+********************************************************************/
+
+void DestroyPathGraph (pPathGraph graph);
+
+/********************************************************************
+*	DestroySight - Release a field of view's memory					*
+*	Input:	Field of view to destroy								*
+********************************************************************/
+
+void DestroySight (pSight sight);
+
+/********************************************************************
+*	DestroyRegionIndex - Release a region index's memory			*
+*	Input:	Region index to destroy									*
+********************************************************************/
+
+void DestroyRegionIndex (pRegionIndex index);
+
+#endif
\ No newline at end of file
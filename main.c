@@ -15,6 +15,9 @@
 
 #include "User.h"
 
+static String G_journalMode = NULL;
+static String G_journalName = NULL;
+
 /********************************************************************
 *																	*
 *							Main									*
@@ -30,6 +33,13 @@ void main (int argc, char ** argv)
 	
 	mode = atoi (*argv);
 
+	if (argc > 2)
+	{
+		G_journalMode = *(argv + 1);
+		G_journalName = *(argv + 2);
+	}
+	// Optional "record <file>" or "replay <file>" for interactive modes
+
 	switch (mode)	// Get the user mode
 	{
 	case /*kGame*/0:		// Game case
@@ -53,6 +63,72 @@ void main (int argc, char ** argv)
 	case 4:
 		WindowTest ();
 		break;
+
+	case 5:
+		PathBenchmark ();
+		break;
+
+	case 6:
+		Simulate (argc > 1 ? atol (*(argv + 1)) : 1000000, argc > 2 ? atol (*(argv + 2)) : 100000);
+		break;
+
+	case 7:
+		StringPoolBenchmark ();
+		break;
+
+	case 8:
+		NodePoolBenchmark ();
+		break;
+
+	case 9:
+		ListBenchmark ();
+		break;
+
+	case 10:
+		VectorBenchmark ();
+		break;
+
+	case 11:
+		QueueBenchmark ();
+		break;
+
+	case 12:
+		MessageQueueStress ();
+		break;
+
+	case 13:
+		MessageQueueBenchmark ();
+		break;
+
+	case 14:
+		WindowManagerTest ();
+		break;
+
+	case 15:
+		LogViewTest ();
+		break;
+
+	case 16:
+		BlobLoadTest ();
+		break;
+	}
+}
+
+void StartJournal (Input * inputObj)
+{
+	if (!G_journalMode)
+	{
+		return;
+	}
+
+	if (!strcmp (G_journalMode, "record"))
+	{
+		RecordInput (inputObj, G_journalName);
+	}
+
+	else if (!strcmp (G_journalMode, "replay"))
+	{
+		ReplayInput (inputObj, G_journalName);
 	}
 }
 
@@ -601,18 +677,21 @@ void WindowTest (void)
 	FREE(animation);
 	*/
 	String buf = "There is only one way to escape Jochochyo";
+	String labels [] = { "M1", "M1+", "M2" };
 	pParentWindow parentWindow;
 	pWindow window;
 	Objects objects;
 	pCell cell, end;
 	Image image;
-	int i, loop = TRUE;
+	int loop = TRUE;
 	int dimensions;
 
 	ZeroMemory (&objects, sizeof (Objects));
 	ZeroMemory (&image, sizeof (Image));
 
 	ConsoleInit (&objects, ENABLE_PROCESSED_INPUT | ENABLE_MOUSE_INPUT, TRUE);
+	StartJournal (&objects.inputObj);
+	SetMouseCoalescing (&objects.inputObj, TRUE);
 
 	ReloadImage (&objects.fileObj, &image, "Dragon5.img");
 
@@ -779,15 +858,6 @@ void WindowTest (void)
 
 	window->IO->writeMode = kWriteCharacter;
 
-	window->IO->text.limit = window->IO->text.numChars = strlen (buf) + 1;
-
-	CALLOC(window->IO->text.text,window->IO->text.numChars,char);
-
-	for (i = 0; i < window->IO->text.numChars; i++)
-	{
-		*(window->IO->text.text + i) = *(buf + i);
-	}
-
 	dimensions = window->width * window->height;
 	AllocateBuffer (&window->display, dimensions);
 
@@ -796,6 +866,8 @@ void WindowTest (void)
 		cell->graph.Attributes = window->background;
 	}
 
+	LoadMessage (window, InternString (buf));
+
 	SETFLAG(window->state,ACTIVEWITHOUTFOCUS);
 
 	window++;
@@ -835,24 +907,14 @@ void WindowTest (void)
 
 	CALLOC(window->menu->menu,window->menu->numItems,MenuItem);
 
-	window->menu->menu->numItems = 2;
-	CALLOC(window->menu->menu->text,window->menu->menu->numItems,String);
-	CALLOC(window->menu->menu->lParams,window->menu->menu->numItems,long);
-	CALLOC(*window->menu->menu->text,strlen ("M1") + 1,char);
-	strcpy (*window->menu->menu->text, "M1");
-	CALLOC(*(window->menu->menu->text + 1),strlen ("M1+") + 1,char);
-	strcpy (*(window->menu->menu->text + 1), "M1+");
+	LoadMenuItems (window->menu->menu, labels, 2);
 	window->menu->menu->location.X = 3;
 	window->menu->menu->location.Y = 3;
 	window->menu->menu->width = 5;
 	window->menu->menu->height = 1;
 	window->menu->menu->highlight = BACKGROUND_BLUE | BACKGROUND_GREEN | BACKGROUND_RED | FOREGROUND_BLUE | FOREGROUND_GREEN | FOREGROUND_RED | FOREGROUND_INTENSITY;
 
-	(window->menu->menu + 1)->numItems = 1;
-	CALLOC((window->menu->menu + 1)->text,(window->menu->menu + 1)->numItems,String);
-	CALLOC((window->menu->menu + 1)->lParams,(window->menu->menu + 1)->numItems,long);
-	CALLOC(*(window->menu->menu + 1)->text,strlen ("M2") + 1,char);
-	strcpy (*(window->menu->menu + 1)->text, "M2");
+	LoadMenuItems (window->menu->menu + 1, labels + 2, 1);
 	(window->menu->menu + 1)->location.X = 4;
 	(window->menu->menu + 1)->location.Y = 7;
 	(window->menu->menu + 1)->width = 3;
@@ -871,6 +933,8 @@ void WindowTest (void)
 
 	MakeParentWindow (parentWindow, 0, 0, 2);
 
+	SETFLAG(parentWindow->state,EVENTDRIVEN);
+
 	while (loop)
 	{
 		ActivateWindows (parentWindow);
@@ -904,4 +968,629 @@ stuck:
 	FREE(parentWindow);
 	DeinitializeObjects (&objects);
 	
-} 
\ No newline at end of file
+} 
+
+static pParentWindow MakeStackedWindow (ScreenBuffer * back, String label, int x, int y, int width, int height, WORD background)
+{
+	pParentWindow parentWindow;
+	pWindow window;
+	pCell cell, end;
+	int dimensions;
+
+	MALLOC(parentWindow,ParentWindow);
+
+	parentWindow->bufferSharing = kShared;
+	parentWindow->back = back;
+
+	parentWindow->delay = 50;
+
+	parentWindow->width = width;
+	parentWindow->height = height;
+
+	CALLOC(parentWindow->backData,parentWindow->width * parentWindow->height,BYTE);
+
+	parentWindow->background = background;
+	parentWindow->border = FOREGROUND_BLUE | FOREGROUND_GREEN | FOREGROUND_RED;
+
+	parentWindow->closeKey = VK_ESCAPE;
+
+	parentWindow->numWindows = 1;
+
+	CALLOC(parentWindow->windows,parentWindow->numWindows,Window);
+
+	window = parentWindow->windows;
+
+	window->background = background;
+	window->width = window->windowWidth = width - 4;
+	window->height = window->windowHeight = height - 4;
+	window->windowCoord.X = 2;
+	window->windowCoord.Y = 2;
+	window->mode = kMessageBox;
+
+	MALLOC(window->IO,IO_Descriptor);
+
+	window->IO->writeMode = kWriteCharacter;
+
+	dimensions = window->width * window->height;
+	AllocateBuffer (&window->display, dimensions);
+
+	for (cell = window->display.buffer, end = cell + dimensions; cell < end; cell++)
+	{
+		cell->graph.Attributes = window->background;
+	}
+
+	LoadMessage (window, InternString (label));
+
+	MakeParentWindow (parentWindow, x, y, 0);
+
+	ActivateWindows (parentWindow);
+
+	return parentWindow;
+}
+
+static int CloseStackedWindow (voidStar data, dataType type, long lParam)
+{
+	DeactivateWindows ((pParentWindow) data);
+
+	return TRUE;
+}
+
+void WindowManagerTest ()
+{
+	static String labels [] = { "Bottom: click to raise", "Middle: drag by the border", "Top: Esc or End closes" };
+	static Key keys [] = { {VK_END, CloseStackedWindow} };
+	pParentWindow parentWindows [3];
+	pHotKeyTable globalKeys;
+	WindowManager manager;
+	Objects objects;
+	Image image;
+	pScreenBuffer back;
+	int i;
+
+	ZeroMemory (&objects, sizeof (Objects));
+	ZeroMemory (&image, sizeof (Image));
+
+	ConsoleInit (&objects, ENABLE_PROCESSED_INPUT | ENABLE_MOUSE_INPUT, TRUE);
+	StartJournal (&objects.inputObj);
+	SetMouseCoalescing (&objects.inputObj, TRUE);
+
+	ReloadImage (&objects.fileObj, &image, "Dragon5.img");
+
+	MALLOC(back,ScreenBuffer);
+
+	DisplayImageToScreen (&image, &objects.outputObj.outputBuf, NULL);
+
+	CopyBuffer (back, &objects.outputObj.outputBuf);
+
+	DeleteImage (&image);
+
+	InitWindowManager (&manager, back);
+
+	globalKeys = MakeHotKeyTable (keys, sizeof (keys) / sizeof (Key));
+	// End is bound once, for every stacked window
+
+	parentWindows [0] = MakeStackedWindow (back, labels [0], 5, 5, 30, 7, BACKGROUND_BLUE | BACKGROUND_INTENSITY);
+	parentWindows [1] = MakeStackedWindow (back, labels [1], 20, 9, 30, 7, BACKGROUND_GREEN);
+	parentWindows [2] = MakeStackedWindow (back, labels [2], 35, 13, 30, 7, BACKGROUND_RED);
+
+	for (i = 0; i < 3; i++)
+	{
+		SetGlobalHotKeys (parentWindows [i], globalKeys);
+		AddParentWindow (&manager, parentWindows [i]);
+	}
+
+	RaiseParentWindow (&manager, parentWindows [1]);
+	// Stack is now bottom, top, middle
+
+	UpdateWindowManager (&manager, &objects, NULL);
+
+	assert (HitTestParentWindow (&manager, 25, 14) == parentWindows [1]);
+	assert (HitTestParentWindow (&manager, 40, 18) == parentWindows [2]);
+	assert (HitTestParentWindow (&manager, 6, 6) == parentWindows [0]);
+	assert (!HitTestParentWindow (&manager, 70, 40));
+	// Cells only one window covers belong to it
+
+	assert (HitTestParentWindow (&manager, 40, 14) == parentWindows [1]);
+	assert (HitTestParentWindow (&manager, 25, 10) == parentWindows [1]);
+	// Cells shared by two windows belong to the higher one
+
+	RaiseParentWindow (&manager, parentWindows [0]);
+	// Stack is now top, middle, bottom
+
+	UpdateWindowManager (&manager, &objects, NULL);
+
+	assert (HitTestParentWindow (&manager, 25, 10) == parentWindows [0]);
+	assert (HitTestParentWindow (&manager, 40, 14) == parentWindows [1]);
+	// Raising a window hands it the cells it shares
+
+	while (UpdateWindowManager (&manager, &objects, NULL))
+	{
+		// Drag the top window, click lower ones to raise them, Esc to close
+	}
+
+	for (i = 0; i < 3; i++)
+	{
+		RemoveParentWindow (&manager, parentWindows [i]);
+
+		DeleteParentWindow (parentWindows [i]);
+		FREE(parentWindows [i]);
+	}
+
+	FREE(globalKeys);
+	FREE(back);
+	DeinitializeObjects (&objects);
+}
+
+static BOOL LogRowShows (Window const * window, long line)
+{
+	char expected [16];
+	pCell cell = window->display.buffer + window->yOffset * window->width;
+	int i;
+
+	sprintf (expected, "%09ld", line);
+
+	for (i = 0; i < 9; i++)
+	{
+		if ((cell + i)->graph.Char.AsciiChar != expected [i])
+		{
+			return FALSE;
+		}
+	}
+
+	return TRUE;
+}
+
+void LogViewTest ()
+{
+	static String names [] = { "start", "middle", "end" };
+	long numLines = 3000000, numAppended = 200;
+	long lines [3], top [3];
+	double jumpTimes [3], writeTime, indexTime, tailTime, closeTime;
+	BOOL shown [3], following;
+	pParentWindow parentWindow;
+	pWindow window;
+	pLogView log;
+	Objects objects;
+	pScreenBuffer back;
+	FILE * fp;
+	clock_t begin;
+	long i, away;
+	int j;
+
+	begin = clock ();
+
+	fp = fopen ("LogTest.log", "w");
+
+	if (!fp)
+	{
+		NORET_MESSAGE("LogViewTest failed","1");
+	}
+
+	for (i = 0; i < numLines; i++)
+	{
+		fprintf (fp, "%09ld Line of the log viewer test\n", i);
+	}
+
+	fclose (fp);
+
+	writeTime = (double) (clock () - begin) / CLOCKS_PER_SEC;
+
+	ZeroMemory (&objects, sizeof (Objects));
+
+	ConsoleInit (&objects, ENABLE_PROCESSED_INPUT | ENABLE_MOUSE_INPUT, TRUE);
+	StartJournal (&objects.inputObj);
+
+	MALLOC(back,ScreenBuffer);
+
+	CopyBuffer (back, &objects.outputObj.outputBuf);
+
+	parentWindow = MakeStackedWindow (back, "LogTest.log", 0, 0, SCREEN_WIDTH, SCREEN_HEIGHT, BACKGROUND_BLUE);
+	parentWindow->delay = 10;
+	window = parentWindow->windows;
+
+	begin = clock ();
+
+	if (!OpenLogView (window, "LogTest.log", window->windowHeight))
+	{
+		DeleteParentWindow (parentWindow);
+		FREE(parentWindow);
+		FREE(back);
+		DeinitializeObjects (&objects);
+
+		NORET_MESSAGE("LogViewTest failed","2");
+	}
+
+	log = window->IO->log;
+
+	while (log->numRows < numLines && (clock () - begin) / CLOCKS_PER_SEC < 60)
+	{
+		Sleep (10);
+	}
+	// The indexer runs in the background; opening returned at once
+
+	indexTime = (double) (clock () - begin) / CLOCKS_PER_SEC;
+
+	RedrawWindows (parentWindow, &objects);
+	Update (parentWindow, &objects, NULL);
+	// Take up the indexed rows
+
+	lines [0] = 0;
+	lines [1] = numLines / 2;
+	lines [2] = numLines - 1;
+
+	for (j = 0; j < 3; j++)
+	{
+		away = j ? lines [j] - 1000 : lines [j] + 1000;
+
+		begin = clock ();
+
+		for (i = 0; i < 1000; i++)
+		{
+			JumpToLogLine (window, away);
+			JumpToLogLine (window, lines [j]);
+		}
+
+		jumpTimes [j] = (double) (clock () - begin) / CLOCKS_PER_SEC / 2000;
+		// Each jump leaves the cache, so rows are found and produced afresh
+
+		top [j] = min (lines [j], numLines - window->windowHeight);
+		shown [j] = window->view->row == top [j] && LogRowShows (window, top [j]);
+	}
+
+	JumpToLogLine (window, numLines);
+	// Show the end, so the view follows the file
+
+	begin = clock ();
+
+	for (i = 0; i < numAppended && WindowsActive (parentWindow); i++)
+	{
+		fp = fopen ("LogTest.log", "a");
+
+		if (fp)
+		{
+			fprintf (fp, "%09ld Line appended while following\n", numLines + i);
+			fclose (fp);
+		}
+
+		Update (parentWindow, &objects, NULL);
+	}
+
+	while (window->view->numRows < numLines + numAppended && (clock () - begin) / CLOCKS_PER_SEC < 10 && WindowsActive (parentWindow))
+	{
+		Update (parentWindow, &objects, NULL);
+	}
+	// Let the indexer catch up with the last appends
+
+	tailTime = (double) (clock () - begin) / CLOCKS_PER_SEC;
+
+	following = window->view->row == window->view->numRows - window->windowHeight && LogRowShows (window, window->view->row);
+
+	while (WindowsActive (parentWindow))
+	{
+		Update (parentWindow, &objects, NULL);
+	}
+	// Esc closes the viewer
+
+	begin = clock ();
+
+	CloseLogView (window);
+
+	closeTime = (double) (clock () - begin) / CLOCKS_PER_SEC;
+
+	DeleteParentWindow (parentWindow);
+	FREE(parentWindow);
+	FREE(back);
+	DeinitializeObjects (&objects);
+
+	remove ("LogTest.log");
+
+	printf ("Wrote %ld lines in %.3f s; indexed in %.3f s\n", numLines, writeTime, indexTime);
+
+	for (j = 0; j < 3; j++)
+	{
+		printf ("Jump to %s (line %ld): %.1f us per jump, %s\n", names [j], lines [j], jumpTimes [j] * 1000000.0, shown [j] ? "shown" : "WRONG ROW");
+	}
+
+	printf ("Appended %ld lines: %s after %.3f s\n", numAppended, following ? "following the end" : "NOT FOLLOWING", tailTime);
+	printf ("Indexer stopped in %.3f s\n", closeTime);
+}
+
+static void WriteBlobTestWindow (FILE * fp, int usingADT, int background, int width, int height, int x, int y, int state, int mode)
+{
+	fprintf (fp, "%d\n", usingADT);
+
+	if (usingADT)
+	{
+		fprintf (fp, "%d %d\n", kSingleOwner, kADTList);
+	}
+
+	fprintf (fp, "%d\n%d\n%d %d\n%d %d\n%d %d\n%d %d\n%d\n%d\n", 0, background, 0, 0, width, height, width, height, x, y, state, mode);
+}
+
+static BOOL SameWindow (Window const * a, Window const * b, String * part)
+{
+	MenuItem const * itemA, * itemB;
+	int i, j;
+
+	*part = "window geometry";
+
+	if (a->windowCoord.X != b->windowCoord.X || a->windowCoord.Y != b->windowCoord.Y || a->windowWidth != b->windowWidth || a->windowHeight != b->windowHeight
+		|| a->xOffset != b->xOffset || a->yOffset != b->yOffset || a->width != b->width || a->height != b->height
+		|| a->state != b->state || a->mode != b->mode || a->data != b->data || a->background != b->background || !a->dataADT.data.data != !b->dataADT.data.data)
+	{
+		return FALSE;
+	}
+
+	*part = "cells";
+
+	if (!a->display.buffer || !b->display.buffer || memcmp (a->display.buffer, b->display.buffer, a->width * a->height * sizeof (Cell)))
+	{
+		return FALSE;
+	}
+
+	*part = "text";
+
+	if (!a->IO != !b->IO || (a->IO && (a->IO->text.numChars != b->IO->text.numChars || memcmp (a->IO->text.text, b->IO->text.text, a->IO->text.numChars))))
+	{
+		return FALSE;
+	}
+
+	*part = "menu";
+
+	if (!a->menu != !b->menu)
+	{
+		return FALSE;
+	}
+
+	if (a->menu)
+	{
+		if (a->menu->itemChosen != b->menu->itemChosen || a->menu->numKeys != b->menu->numKeys || a->menu->numItems != b->menu->numItems || !b->menu->table)
+		{
+			return FALSE;
+		}
+
+		for (i = 0; i < a->menu->numKeys; i++)
+		{
+			if (a->menu->keys [i].keycode != b->menu->keys [i].keycode || a->menu->keys [i].function != b->menu->keys [i].function)
+			{
+				return FALSE;
+			}
+		}
+
+		for (i = 0; i < a->menu->numItems; i++)
+		{
+			itemA = a->menu->menu + i;
+			itemB = b->menu->menu + i;
+
+			if (itemA->location.X != itemB->location.X || itemA->location.Y != itemB->location.Y || itemA->width != itemB->width || itemA->height != itemB->height
+				|| itemA->highlight != itemB->highlight || itemA->entry != itemB->entry || itemA->numItems != itemB->numItems)
+			{
+				return FALSE;
+			}
+
+			for (j = 0; j < itemA->numItems; j++)
+			{
+				if (itemA->text [j] != itemB->text [j] || itemA->lParams [j] != itemB->lParams [j])
+				{
+					return FALSE;
+				}
+			}
+			// Pooled labels compare by ID
+		}
+	}
+
+	*part = "receivers";
+
+	if (!a->receivers != !b->receivers || (a->receivers && (a->receivers->numReceivers != b->receivers->numReceivers || memcmp (a->receivers->receivers, b->receivers->receivers, a->receivers->numReceivers * sizeof (ReceiverEntry)))))
+	{
+		return FALSE;
+	}
+
+	*part = "visuals";
+
+	if (!a->visuals != !b->visuals)
+	{
+		return FALSE;
+	}
+
+	if (a->visuals)
+	{
+		if (a->visuals->numImages != b->visuals->numImages || a->visuals->numPatterns != b->visuals->numPatterns || a->visuals->numAnimations != b->visuals->numAnimations)
+		{
+			return FALSE;
+		}
+
+		for (i = 0; i < a->visuals->numImages; i++)
+		{
+			if (a->visuals->images [i].width != b->visuals->images [i].width || a->visuals->images [i].height != b->visuals->images [i].height
+				|| memcmp (a->visuals->images [i].image.buffer, b->visuals->images [i].image.buffer, a->visuals->images [i].width * a->visuals->images [i].height * sizeof (Cell)))
+			{
+				return FALSE;
+			}
+		}
+	}
+
+	return TRUE;
+}
+
+static BOOL SameParentWindow (ParentWindow const * a, ParentWindow const * b, String * part)
+{
+	int i, dimensions = a->width * a->height;
+
+	*part = "geometry";
+
+	if (a->width != b->width || a->height != b->height || a->delay != b->delay || a->background != b->background || a->border != b->border || a->bufferSharing != b->bufferSharing
+		|| a->focusKey != b->focusKey || a->closeKey != b->closeKey || a->confirmKey != b->confirmKey || a->numWindows != b->numWindows || a->state != b->state)
+	{
+		return FALSE;
+	}
+
+	*part = "separators";
+
+	if (!a->separators || !b->separators || a->separators->numHorzSeparators != b->separators->numHorzSeparators || a->separators->numVertSeparators != b->separators->numVertSeparators
+		|| memcmp (a->separators->horzSeparators, b->separators->horzSeparators, a->separators->numHorzSeparators * sizeof (SeparatorEntry))
+		|| memcmp (a->separators->vertSeparators, b->separators->vertSeparators, a->separators->numVertSeparators * sizeof (SeparatorEntry)))
+	{
+		return FALSE;
+	}
+
+	*part = "edges";
+
+	if (memcmp (a->backData, b->backData, dimensions) || !a->chrome || !b->chrome || memcmp (a->chrome, b->chrome, dimensions * sizeof (CHAR_INFO)))
+	{
+		return FALSE;
+	}
+
+	for (i = 0; i < a->numWindows; i++)
+	{
+		if (!SameWindow (a->windows + i, b->windows + i, part))
+		{
+			return FALSE;
+		}
+	}
+
+	return TRUE;
+}
+
+void BlobLoadTest ()
+{
+	int numLoads = 2000;
+	double textTime, blobTime;
+	ParentWindow fromText, fromBlob;
+	BOOL compiled, loaded, same;
+	String part = "nothing";
+	File fileObj;
+	Image image;
+	FILE * fp;
+	clock_t begin;
+	int i;
+
+	if (!InitializeFileObject (&fileObj))
+	{
+		NORET_MESSAGE("BlobLoadTest failed","1");
+	}
+
+	ZeroMemory (&image, sizeof (Image));
+
+	image.width = 6;
+	image.height = 3;
+
+	if (!AllocateBuffer (&image.image, image.width * image.height))
+	{
+		DeinitializeFileObject (&fileObj);
+
+		NORET_MESSAGE("BlobLoadTest failed","2");
+	}
+
+	for (i = 0; i < image.width * image.height; i++)
+	{
+		image.image.buffer [i].graph.Char.AsciiChar = (char) ('a' + i);
+		image.image.buffer [i].graph.Attributes = (WORD) (i & 0xF);
+	}
+
+	ReopenFile (&fileObj, "BlobTest.img", kWrite, kBinary);
+
+	if (fileObj.fp)
+	{
+		WriteImage (&fileObj, &image);
+	}
+
+	DeleteImage (&image);
+
+	fp = fopen ("BlobTest.mnu", "w");
+
+	if (!fp)
+	{
+		DeinitializeFileObject (&fileObj);
+
+		NORET_MESSAGE("BlobLoadTest failed","3");
+	}
+
+	fprintf (fp, "0\n4\n%d 0\n%d 1\n%d 2\n%d 3\n2\n", VK_UP, VK_DOWN, VK_LEFT, VK_RIGHT);
+	fprintf (fp, "1 1 9 1 %d 2\n0 Sound on\n1 Sound off\n", BACKGROUND_GREEN | FOREGROUND_RED | FOREGROUND_INTENSITY);
+	fprintf (fp, "1 3 9 1 %d 1\n7 Quit\n", BACKGROUND_GREEN | FOREGROUND_RED | FOREGROUND_INTENSITY);
+
+	fclose (fp);
+
+	fp = fopen ("BlobTest.pw", "w");
+
+	if (!fp)
+	{
+		DeinitializeFileObject (&fileObj);
+
+		NORET_MESSAGE("BlobLoadTest failed","4");
+	}
+
+	fprintf (fp, "%d\n20\n40 16\n%c %c\n", kSingleOwner, BACKGROUND_BLUE, '#');
+	fprintf (fp, "1\n1 1\n0 7\n38\n19 0\n6\n");
+	fprintf (fp, "%d\n%d\n%d\n4\n", VK_TAB, VK_ESCAPE, VK_RETURN);
+
+	WriteBlobTestWindow (fp, 0, BACKGROUND_RED, 18, 6, 1, 1, ACTIVEWITHOUTFOCUS, kBasic);
+	fprintf (fp, "1\n0\n1\nBlobTest.img\n0\n0\n");
+
+	WriteBlobTestWindow (fp, 1, BACKGROUND_GREEN, 18, 6, 21, 1, CANRECEIVEFOCUS, kMenu);
+	fprintf (fp, "BlobTest.mnu\n1\n1\n0 %d\n", kIndexFrame);
+
+	WriteBlobTestWindow (fp, 0, BACKGROUND_BLUE | BACKGROUND_GREEN, 38, 3, 1, 9, ACTIVEWITHOUTFOCUS, kMessageBox);
+	fprintf (fp, "0\n64 64\n0\n");
+
+	WriteBlobTestWindow (fp, 0, 0, 38, 2, 1, 13, CANRECEIVEFOCUS, kEditBox);
+	fprintf (fp, "0\n32 32\n0\n");
+
+	fprintf (fp, "0\n");
+
+	fclose (fp);
+
+	compiled = CompileParentWindow (&fileObj, "BlobTest.pw", "BlobTest.blob");
+
+	begin = clock ();
+
+	for (i = 0; i < numLoads; i++)
+	{
+		ZeroMemory (&fromText, sizeof (ParentWindow));
+
+		ReloadParentWindow (&fileObj, &fromText, "BlobTest.pw");
+		DeleteParentWindow (&fromText);
+	}
+
+	textTime = (double) (clock () - begin) / CLOCKS_PER_SEC / numLoads;
+
+	begin = clock ();
+
+	for (i = 0; compiled && i < numLoads; i++)
+	{
+		ZeroMemory (&fromBlob, sizeof (ParentWindow));
+
+		ReloadParentWindowBlob (&fileObj, &fromBlob, "BlobTest.blob");
+		DeleteParentWindow (&fromBlob);
+	}
+
+	blobTime = (double) (clock () - begin) / CLOCKS_PER_SEC / numLoads;
+
+	ZeroMemory (&fromText, sizeof (ParentWindow));
+	ZeroMemory (&fromBlob, sizeof (ParentWindow));
+
+	loaded = ReloadParentWindow (&fileObj, &fromText, "BlobTest.pw") && compiled && ReloadParentWindowBlob (&fileObj, &fromBlob, "BlobTest.blob");
+
+	if (loaded)
+	{
+		MakeParentWindow (&fromText, 0, 0, 1);
+		MakeParentWindow (&fromBlob, 0, 0, 1);
+		// Compose the chrome and write the menu labels into both
+	}
+
+	same = loaded && SameParentWindow (&fromText, &fromBlob, &part);
+
+	printf ("Compiled %s: %s, %lu bytes\n", "BlobTest.pw", compiled ? "yes" : "FAILED", fromBlob.blobSize);
+	printf ("Text load: %.1f us; blob load: %.1f us\n", textTime * 1000000.0, blobTime * 1000000.0);
+	printf (same ? "Blob load matches the text load\n" : "Blob load DIFFERS from the text load in its %s\n", part);
+
+	DeleteParentWindow (&fromText);
+	DeleteParentWindow (&fromBlob);
+	DeinitializeFileObject (&fileObj);
+
+	remove ("BlobTest.img");
+	remove ("BlobTest.mnu");
+	remove ("BlobTest.pw");
+	remove ("BlobTest.blob");
+}